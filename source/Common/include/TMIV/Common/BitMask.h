@@ -0,0 +1,114 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_COMMON_BIT_MASK_H
+#define TMIV_COMMON_BIT_MASK_H
+
+#include "Frame.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace TMIV::Common {
+// A binary mask with one bit per sample
+//
+// Each row starts at a 64-bit word boundary and the padding bits at the end of a row are always
+// zero, such that whole-mask operations can work on words instead of samples.
+class BitMask {
+public:
+  using Word = uint64_t;
+  static constexpr auto wordBits = 64;
+
+  BitMask() = default;
+  BitMask(int32_t width, int32_t height);
+
+  // Samples are set when they are non-zero
+  explicit BitMask(const Frame<uint8_t> &frame);
+
+  // Set samples have the specified value, the other samples are zero
+  [[nodiscard]] auto toFrame(uint8_t value = 255) const -> Frame<uint8_t>;
+
+  [[nodiscard]] auto width() const noexcept { return m_width; }
+  [[nodiscard]] auto height() const noexcept { return m_height; }
+  [[nodiscard]] auto empty() const noexcept { return m_words.empty(); }
+  [[nodiscard]] auto wordsPerRow() const noexcept { return m_wordsPerRow; }
+
+  [[nodiscard]] auto test(int32_t i, int32_t j) const noexcept {
+    return ((row(i)[j / wordBits] >> (j % wordBits)) & 1U) != 0;
+  }
+
+  void set(int32_t i, int32_t j, bool value = true) noexcept {
+    auto &word = row(i)[j / wordBits];
+    const auto bit = Word{1} << (j % wordBits);
+    word = value ? word | bit : word & ~bit;
+  }
+
+  [[nodiscard]] auto row(int32_t i) noexcept -> Word * { return &m_words[rowOffset(i)]; }
+  [[nodiscard]] auto row(int32_t i) const noexcept -> const Word * {
+    return &m_words[rowOffset(i)];
+  }
+
+  void fill(bool value);
+
+  // Number of set samples
+  [[nodiscard]] auto count() const noexcept -> size_t;
+  [[nodiscard]] auto any() const noexcept -> bool;
+
+  // Is any sample set within rows [i1, i2) and columns [j1, j2)?
+  [[nodiscard]] auto any(int32_t i1, int32_t j1, int32_t i2, int32_t j2) const noexcept -> bool;
+
+  auto operator|=(const BitMask &other) noexcept -> BitMask &;
+  auto operator&=(const BitMask &other) noexcept -> BitMask &;
+
+  // Set each sample that has a set sample within its 3x3 neighbourhood
+  [[nodiscard]] auto dilate() const -> BitMask;
+
+  [[nodiscard]] auto operator==(const BitMask &other) const noexcept -> bool;
+  [[nodiscard]] auto operator!=(const BitMask &other) const noexcept -> bool {
+    return !operator==(other);
+  }
+
+private:
+  [[nodiscard]] auto rowOffset(int32_t i) const noexcept -> size_t {
+    return static_cast<size_t>(i) * static_cast<size_t>(m_wordsPerRow);
+  }
+  [[nodiscard]] auto lastWordMask() const noexcept -> Word;
+
+  int32_t m_width{};
+  int32_t m_height{};
+  int32_t m_wordsPerRow{};
+  std::vector<Word> m_words;
+};
+} // namespace TMIV::Common
+
+#endif
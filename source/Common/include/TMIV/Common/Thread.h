@@ -34,6 +34,7 @@
 #ifndef TMIV_COMMON_THREAD_H
 #define TMIV_COMMON_THREAD_H
 
+#include <exception>
 #include <functional>
 #include <future>
 #include <vector>
@@ -45,6 +46,24 @@ inline auto threadCount() -> auto & {
   return singletonValue;
 }
 
+// Wait for all tasks, such that no task outlives the loop, and then rethrow the first failure
+inline void getAll(std::vector<std::future<void>> &threadList) {
+  auto error = std::exception_ptr{};
+
+  for (auto &thread : threadList) {
+    try {
+      thread.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 inline void parallel_for(size_t nbIter, std::function<void(size_t)> fun) {
   auto segment_execute = [&](size_t first, size_t last) {
     for (auto id = first; id < last; id++) {
@@ -59,9 +78,7 @@ inline void parallel_for(size_t nbIter, std::function<void(size_t)> fun) {
     threadList.push_back(std::async(segment_execute, id, std::min(id + chunkSize, nbIter)));
   }
 
-  for (auto &thread : threadList) {
-    thread.wait();
-  }
+  getAll(threadList);
 }
 
 inline void parallel_for(size_t w, size_t h, std::function<void(size_t, size_t)> fun) {
@@ -95,9 +112,7 @@ inline void parallel_for(size_t w, size_t h, std::function<void(size_t, size_t)>
     threadList.push_back(std::async(segment_execute, id, std::min(id + chunkSize, nbIter)));
   }
 
-  for (auto &thread : threadList) {
-    thread.wait();
-  }
+  getAll(threadList);
 }
 } // namespace TMIV::Common
 
@@ -0,0 +1,205 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TMIV/Common/BitMask.h>
+
+#include <algorithm>
+#include <bitset>
+
+namespace TMIV::Common {
+BitMask::BitMask(int32_t width, int32_t height)
+    : m_width{width}
+    , m_height{height}
+    , m_wordsPerRow{(width + wordBits - 1) / wordBits}
+    , m_words(static_cast<size_t>(m_wordsPerRow) * static_cast<size_t>(std::max(0, height))) {
+  PRECONDITION(0 <= width && 0 <= height);
+}
+
+BitMask::BitMask(const Frame<uint8_t> &frame) : BitMask{frame.getWidth(), frame.getHeight()} {
+  const auto &plane = frame.getPlane(0);
+
+  for (int32_t i = 0; i < m_height; ++i) {
+    const auto *in = &plane(i, 0);
+    auto *out = row(i);
+
+    for (int32_t j0 = 0; j0 < m_width; j0 += wordBits) {
+      const auto n = std::min(wordBits, m_width - j0);
+      auto word = Word{};
+
+      for (int32_t k = 0; k < n; ++k) {
+        word |= static_cast<Word>(in[j0 + k] != 0) << k;
+      }
+      out[j0 / wordBits] = word;
+    }
+  }
+}
+
+auto BitMask::toFrame(uint8_t value) const -> Frame<uint8_t> {
+  auto frame = Frame<uint8_t>::lumaOnly({m_width, m_height});
+  auto &plane = frame.getPlane(0);
+
+  for (int32_t i = 0; i < m_height; ++i) {
+    const auto *in = row(i);
+    auto *out = &plane(i, 0);
+
+    for (int32_t j = 0; j < m_width; ++j) {
+      out[j] = ((in[j / wordBits] >> (j % wordBits)) & 1U) != 0 ? value : uint8_t{};
+    }
+  }
+  return frame;
+}
+
+void BitMask::fill(bool value) {
+  if (!value) {
+    std::fill(m_words.begin(), m_words.end(), Word{});
+    return;
+  }
+  for (int32_t i = 0; 0 < m_wordsPerRow && i < m_height; ++i) {
+    auto *words = row(i);
+    std::fill(words, words + m_wordsPerRow, ~Word{});
+    words[m_wordsPerRow - 1] &= lastWordMask();
+  }
+}
+
+auto BitMask::count() const noexcept -> size_t {
+  auto sum = size_t{};
+
+  for (const auto word : m_words) {
+    sum += std::bitset<wordBits>{word}.count();
+  }
+  return sum;
+}
+
+auto BitMask::any() const noexcept -> bool {
+  return std::any_of(m_words.cbegin(), m_words.cend(), [](Word word) { return word != 0; });
+}
+
+auto BitMask::any(int32_t i1, int32_t j1, int32_t i2, int32_t j2) const noexcept -> bool {
+  i1 = std::max(0, i1);
+  j1 = std::max(0, j1);
+  i2 = std::min(m_height, i2);
+  j2 = std::min(m_width, j2);
+
+  if (i2 <= i1 || j2 <= j1) {
+    return false;
+  }
+
+  const auto w1 = j1 / wordBits;
+  const auto w2 = (j2 - 1) / wordBits;
+  const auto firstMask = ~Word{} << (j1 % wordBits);
+  const auto lastMask = ~Word{} >> (wordBits - 1 - (j2 - 1) % wordBits);
+
+  for (int32_t i = i1; i < i2; ++i) {
+    const auto *words = row(i);
+
+    for (auto w = w1; w <= w2; ++w) {
+      auto word = words[w];
+
+      if (w == w1) {
+        word &= firstMask;
+      }
+      if (w == w2) {
+        word &= lastMask;
+      }
+      if (word != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+auto BitMask::operator|=(const BitMask &other) noexcept -> BitMask & {
+  PRECONDITION(m_width == other.m_width && m_height == other.m_height);
+
+  std::transform(m_words.cbegin(), m_words.cend(), other.m_words.cbegin(), m_words.begin(),
+                 [](Word a, Word b) { return a | b; });
+  return *this;
+}
+
+auto BitMask::operator&=(const BitMask &other) noexcept -> BitMask & {
+  PRECONDITION(m_width == other.m_width && m_height == other.m_height);
+
+  std::transform(m_words.cbegin(), m_words.cend(), other.m_words.cbegin(), m_words.begin(),
+                 [](Word a, Word b) { return a & b; });
+  return *this;
+}
+
+auto BitMask::dilate() const -> BitMask {
+  if (m_width == 0 || m_height == 0) {
+    return *this;
+  }
+
+  // Horizontal pass: OR each word with its left and right shifted neighbours
+  auto horizontal = BitMask{m_width, m_height};
+  const auto last = lastWordMask();
+
+  for (int32_t i = 0; i < m_height; ++i) {
+    const auto *in = row(i);
+    auto *out = horizontal.row(i);
+
+    for (int32_t w = 0; w < m_wordsPerRow; ++w) {
+      const auto prev = 0 < w ? in[w - 1] : Word{};
+      const auto next = w + 1 < m_wordsPerRow ? in[w + 1] : Word{};
+
+      out[w] = in[w] | (in[w] << 1U) | (prev >> (wordBits - 1)) | (in[w] >> 1U) |
+               (next << (wordBits - 1));
+    }
+    out[m_wordsPerRow - 1] &= last;
+  }
+
+  // Vertical pass: OR each row with the rows above and below
+  auto result = BitMask{m_width, m_height};
+
+  for (int32_t i = 0; i < m_height; ++i) {
+    const auto *above = horizontal.row(std::max(0, i - 1));
+    const auto *center = horizontal.row(i);
+    const auto *below = horizontal.row(std::min(m_height - 1, i + 1));
+    auto *out = result.row(i);
+
+    for (int32_t w = 0; w < m_wordsPerRow; ++w) {
+      out[w] = above[w] | center[w] | below[w];
+    }
+  }
+  return result;
+}
+
+auto BitMask::operator==(const BitMask &other) const noexcept -> bool {
+  return m_width == other.m_width && m_height == other.m_height && m_words == other.m_words;
+}
+
+auto BitMask::lastWordMask() const noexcept -> Word {
+  const auto tail = m_width % wordBits;
+  return tail == 0 ? ~Word{} : (Word{1} << tail) - 1;
+}
+} // namespace TMIV::Common
@@ -0,0 +1,150 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Common/BitMask.h>
+
+namespace TMIV::Common {
+namespace {
+// Reference implementation of a 3x3 dilation on a byte mask
+auto referenceDilate(const Frame<uint8_t> &mask) {
+  auto result = Frame<uint8_t>::lumaOnly(mask.getSize());
+  const auto w = mask.getWidth();
+  const auto h = mask.getHeight();
+
+  for (int32_t i = 0; i < h; ++i) {
+    for (int32_t j = 0; j < w; ++j) {
+      for (int32_t di = -1; di <= 1; ++di) {
+        for (int32_t dj = -1; dj <= 1; ++dj) {
+          const auto ii = i + di;
+          const auto jj = j + dj;
+
+          if (0 <= ii && ii < h && 0 <= jj && jj < w && mask.getPlane(0)(ii, jj) != 0) {
+            result.getPlane(0)(i, j) = 255;
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+auto pseudoRandomMask(Vec2i size, uint32_t seed) {
+  auto mask = Frame<uint8_t>::lumaOnly(size);
+
+  for (auto &x : mask.getPlane(0)) {
+    seed = seed * 1103515245U + 12345U;
+    x = (seed >> 16U) % 7 == 0 ? 255 : 0;
+  }
+  return mask;
+}
+} // namespace
+
+SCENARIO("Bit-packed masks", "[BitMask]") {
+  GIVEN("A mask that is not a multiple of the word size wide") {
+    const auto frame = pseudoRandomMask({131, 17}, 7);
+    const auto mask = BitMask{frame};
+
+    THEN("The mask has the same size and requires three words per row") {
+      CHECK(mask.width() == 131);
+      CHECK(mask.height() == 17);
+      CHECK(mask.wordsPerRow() == 3);
+    }
+
+    THEN("Converting back to a frame is lossless") {
+      CHECK(mask.toFrame().getPlane(0) == frame.getPlane(0));
+    }
+
+    THEN("The number of set samples is the number of non-zero samples") {
+      const auto &plane = frame.getPlane(0);
+      CHECK(mask.count() ==
+            static_cast<size_t>(std::count_if(plane.begin(), plane.end(),
+                                              [](uint8_t x) { return x != 0; })));
+    }
+
+    THEN("Dilation matches the byte-wise reference, also across word boundaries") {
+      CHECK(mask.dilate() == BitMask{referenceDilate(frame)});
+    }
+
+    THEN("Dilation does not set padding bits") {
+      auto full = BitMask{131, 17};
+      full.fill(true);
+      CHECK(full.dilate() == full);
+      CHECK(full.count() == 131 * 17);
+    }
+
+    WHEN("Combining with another mask") {
+      const auto otherFrame = pseudoRandomMask({131, 17}, 11);
+      const auto other = BitMask{otherFrame};
+
+      auto unionMask = mask;
+      unionMask |= other;
+      auto intersectionMask = mask;
+      intersectionMask &= other;
+
+      THEN("The operations are sample-wise OR and AND") {
+        for (int32_t i = 0; i < 17; ++i) {
+          for (int32_t j = 0; j < 131; ++j) {
+            const auto a = frame.getPlane(0)(i, j) != 0;
+            const auto b = otherFrame.getPlane(0)(i, j) != 0;
+            REQUIRE(unionMask.test(i, j) == (a || b));
+            REQUIRE(intersectionMask.test(i, j) == (a && b));
+          }
+        }
+      }
+    }
+  }
+
+  GIVEN("An empty mask with a single set sample") {
+    auto mask = BitMask{200, 10};
+    CHECK(!mask.any());
+    mask.set(4, 130);
+
+    THEN("Only blocks that contain the sample have any set samples") {
+      CHECK(mask.any());
+      CHECK(mask.any(0, 0, 10, 200));
+      CHECK(mask.any(4, 130, 5, 131));
+      CHECK(mask.any(0, 128, 8, 136));
+      CHECK(!mask.any(0, 0, 4, 200));
+      CHECK(!mask.any(0, 131, 10, 200));
+      CHECK(!mask.any(0, 0, 10, 130));
+    }
+
+    THEN("Clearing the sample results in an empty mask") {
+      mask.set(4, 130, false);
+      CHECK(mask.count() == 0);
+    }
+  }
+}
+} // namespace TMIV::Common
@@ -38,6 +38,7 @@
 
 #include <TMIV/Common/Json.h>
 #include <TMIV/MivBitstream/AccessUnit.h>
+#include <TMIV/MivBitstream/PatchRenderTable.h>
 
 namespace TMIV::Decoder {
 // The pre-renderer implements part of:
@@ -80,11 +81,20 @@ private:
                                             MivBitstream::AtlasAccessUnit &atlas,
                                             const Common::FrameList<> &inFrame);
 
-  // ISO/IEC 23090-12 Annex B.3.2
-  [[nodiscard]] static auto convertBitDepth(Common::Frame<> frame, uint32_t nominalBitDepth,
-                                            bool alignmentFlag, uint8_t dimensions)
+  // ISO/IEC 23090-12 Annex B.3.2 bit depth conversion, the alternative for Annex B.3.7 chroma
+  // up-sampling and Annex B.3.3 resolution conversion of the first planes of a decoded frame,
+  // fused into a single pass that writes the nominal format frame directly
+  [[nodiscard]] static auto convertFrame(const Common::Frame<> &inFrame, uint32_t nominalBitDepth,
+                                         bool alignmentFlag, uint8_t dimensions,
+                                         int32_t videoWidthNF, int32_t videoHeightNF)
       -> Common::Frame<>;
 
+  // As convertFrame for the occupancy frame, fused with the Annex B.3.9 thresholding
+  [[nodiscard]] static auto convertOccupancyFrame(const Common::Frame<> &inFrame,
+                                                  uint32_t nominalBitDepth, bool alignmentFlag,
+                                                  uint8_t threshold, int32_t videoWidthNF,
+                                                  int32_t videoHeightNF) -> Common::Frame<bool>;
+
   // ISO/IEC 23090-12 Annex B.3.3
   [[nodiscard]] static auto convertResolution(Common::Frame<> inFrame, int32_t videoWidthNF,
                                               int32_t videoHeightNF) -> Common::Frame<>;
@@ -95,10 +105,6 @@ private:
   // * bring all channels to the same resolution as the first one
   [[nodiscard]] static auto upsampleChroma(Common::Frame<> inFrame) -> Common::Frame<>;
 
-  // ISO/IEC 23090-12 Annex B.3.9
-  [[nodiscard]] static auto thresholdOccupancy(const Common::Frame<> &inFrame, uint8_t threshold)
-      -> Common::Frame<bool>;
-
   // ISO/IEC 23090-12 Annex B.4.1
   static void unpackDecodedPackedVideo(const MivBitstream::V3cParameterSet &vps,
                                        MivBitstream::AtlasId atlasId,
@@ -134,9 +140,11 @@ private:
 
   // ISO/IEC 23090-12 Annex H.2.2
   static void reconstructOccupancy(const MivBitstream::ViewParamsList &vpl,
+                                   const MivBitstream::PatchRenderTable &patches,
                                    MivBitstream::AtlasAccessUnit &atlas);
   // ISO/IEC 23090-12 Annex H.3
-  void filterEntities(MivBitstream::AtlasAccessUnit &atlas) const;
+  void filterEntities(const MivBitstream::PatchRenderTable &patches,
+                      MivBitstream::AtlasAccessUnit &atlas) const;
 
   // ISO/IEC 23090-12 Annex H.4
   static void offsetTexture(const MivBitstream::V3cParameterSet &vps, MivBitstream::AtlasId atlasId,
@@ -147,7 +155,8 @@ private:
                           MivBitstream::AtlasAccessUnit &atlas) const;
 
   // Not specified
-  void constructPixelToPatchMap(MivBitstream::AtlasAccessUnit &atlas) const;
+  void constructPixelToPatchMap(const MivBitstream::PatchRenderTable &patches,
+                                MivBitstream::AtlasAccessUnit &atlas) const;
 
   GeometryScaler m_geometryScaler;
   std::optional<Common::Vec2u> m_entityDecodeRange;
@@ -37,7 +37,9 @@
 #include <TMIV/Common/Source.h>
 #include <TMIV/MivBitstream/V3cUnit.h>
 
-#include <list>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
 
 namespace TMIV::Decoder {
 class V3cUnitBuffer {
@@ -46,14 +48,37 @@ public:
   // The VPS at the start of the bitstream needs to be read explicitly
   using OnVps = std::function<void(MivBitstream::V3cUnit)>;
 
-  V3cUnitBuffer(Common::Source<MivBitstream::V3cUnit> source, OnVps onVps);
+  // Upper bound on the payload bytes that are held back for other V3C unit headers
+  static constexpr auto defaultMaxBufferedBytes = size_t{4} << 30U;
 
+  V3cUnitBuffer(Common::Source<MivBitstream::V3cUnit> source, OnVps onVps,
+                size_t maxBufferedBytes = defaultMaxBufferedBytes);
+
+  // Units are demultiplexed into one FIFO per V3C unit header. Throws V3cUnitBufferError when a
+  // VPS is requested but another unit comes first, or when the buffer would exceed its bound.
   auto operator()(MivBitstream::V3cUnitHeader vuh) -> std::optional<MivBitstream::V3cUnit>;
 
+  [[nodiscard]] auto bufferedBytes() const noexcept { return m_bufferedBytes; }
+
 private:
+  struct Entry {
+    uint64_t position{};
+    size_t bytes{};
+    MivBitstream::V3cUnit unit;
+  };
+  using Queue = std::deque<Entry>;
+
+  auto pull() -> bool;
+  auto pop(Queue &queue) -> Entry;
+  auto pullVps() -> std::optional<MivBitstream::V3cUnit>;
+  void deliverVpsBefore(uint64_t position);
+
   Common::Source<MivBitstream::V3cUnit> m_source;
-  std::list<MivBitstream::V3cUnit> m_buffer;
   OnVps m_onVps;
+  size_t m_maxBufferedBytes;
+  size_t m_bufferedBytes{};
+  uint64_t m_nextPosition{};
+  std::unordered_map<uint64_t, Queue> m_queues;
 };
 
 auto videoSubBitstreamSource(std::shared_ptr<V3cUnitBuffer> buffer, MivBitstream::V3cUnitHeader vuh)
@@ -43,6 +43,7 @@
 #include <TMIV/IO/IO.h>
 #include <TMIV/MivBitstream/SequenceConfig.h>
 #include <TMIV/PtlChecker/PtlChecker.h>
+#include <TMIV/PtlChecker/SampledChecker.h>
 #include <TMIV/Renderer/Front/MultipleFrameRenderer.h>
 #include <TMIV/Renderer/Front/mapInputToOutputFrames.h>
 #include <TMIV/Renderer/RecoverPrunedViews.h>
@@ -91,7 +92,7 @@ public:
             m_placeholders.numberOfInputFrames, m_placeholders.numberOfOutputFrames)}
       , m_inputBitstreamPath{IO::inputBitstreamPath(json(), m_placeholders)}
       , m_inputBitstream{m_inputBitstreamPath, std::ios::binary}
-      , m_checker{std::make_shared<PtlChecker::PtlChecker>()}
+      , m_checker{createChecker(json())}
       , m_mivDecoder{decodeMiv()} {
     tryOpenOutputLog();
   }
@@ -125,6 +126,21 @@ public:
   }
 
 private:
+  static auto createChecker(const Common::Json &config) -> PtlChecker::SharedChecker {
+    auto checker = std::make_shared<PtlChecker::PtlChecker>();
+
+    if (const auto &node = config.optional("ptlCheckFramePeriod")) {
+      const auto framePeriod = node.as<int32_t>();
+
+      if (framePeriod <= 0) {
+        throw std::runtime_error(fmt::format(
+            "The configured ptlCheckFramePeriod {} is not a positive integer", framePeriod));
+      }
+      return std::make_shared<PtlChecker::SampledChecker>(std::move(checker), framePeriod);
+    }
+    return checker;
+  }
+
   auto decodeMiv() -> Common::Source<MivBitstream::AccessUnit> {
     if (!m_inputBitstream.good()) {
       throw std::runtime_error(fmt::format("Failed to open {} for reading", m_inputBitstreamPath));
@@ -33,33 +33,124 @@
 
 #include <TMIV/Decoder/OutputLog.h>
 
+#include <TMIV/Common/Thread.h>
 #include <TMIV/Common/verify.h>
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace TMIV::Decoder {
 namespace {
 // https://en.wikipedia.org/wiki/Cyclic_redundancy_check
 namespace crc32 {
-constexpr auto table = []() {
-  auto result = std::array<uint32_t, 0x100>();
+constexpr auto polynomial = uint32_t{0xEDB88320};
+
+// Slicing-by-8 tables: tables[0] is the byte-at-a-time table and tables[k] advances an entry of
+// tables[0] through k more zero bytes
+constexpr auto tables = []() {
+  auto result = std::array<std::array<uint32_t, 0x100>, 8>();
 
   for (uint32_t i = 0; i < 0x100; ++i) {
     auto entry = i;
 
     for (int32_t j = 0; j < 8; ++j) {
-      entry = (entry & 1) == 0 ? entry >> 1 : (entry >> 1) ^ 0xEDB88320;
+      entry = (entry & 1) == 0 ? entry >> 1 : (entry >> 1) ^ polynomial;
+    }
+    Common::at(result[0], i) = entry;
+  }
+  for (size_t k = 1; k < result.size(); ++k) {
+    for (size_t i = 0; i < 0x100; ++i) {
+      const auto entry = Common::at(result[k - 1], i);
+      Common::at(result[k], i) = (entry >> 8) ^ Common::at(result[0], entry & 0xFF);
     }
-    Common::at(result, i) = entry;
   }
   return result;
 }();
 
+constexpr const auto &table = tables[0];
+
 // Source of truth: https://wiki.osdev.org/CRC32
 static_assert(table[0x00] == 0x00000000);
 static_assert(table[0x03] == 0x990951BA);
 static_assert(table[0x20] == 0x3B6E20C8);
 static_assert(table[0xFF] == 0x2D02EF8D);
+
+// The four bytes of a value in network order (big endian), loaded as a little-endian word
+constexpr auto networkOrderWord(uint32_t value) noexcept {
+  return ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value >> 8) & 0xFF00) |
+         (value >> 24);
+}
+
+constexpr auto updateWord(uint32_t crc, uint32_t word) noexcept {
+  const auto x = crc ^ word;
+  return tables[3][x & 0xFF] ^ tables[2][(x >> 8) & 0xFF] ^ tables[1][(x >> 16) & 0xFF] ^
+         tables[0][x >> 24];
+}
+
+constexpr auto updateTwoWords(uint32_t crc, uint32_t word1, uint32_t word2) noexcept {
+  const auto x = crc ^ word1;
+  return tables[7][x & 0xFF] ^ tables[6][(x >> 8) & 0xFF] ^ tables[5][(x >> 16) & 0xFF] ^
+         tables[4][x >> 24] ^ tables[3][word2 & 0xFF] ^ tables[2][(word2 >> 8) & 0xFF] ^
+         tables[1][(word2 >> 16) & 0xFF] ^ tables[0][word2 >> 24];
+}
+
+// Equivalent to consuming each sample as a 32-bit value, eight bytes at a time
+template <typename Sample>
+auto updateSamples(uint32_t crc, const Sample *first, const Sample *last) noexcept {
+  static_assert(std::numeric_limits<Sample>::digits <= 32);
+
+  for (; 2 <= last - first; first += 2) {
+    crc = updateTwoWords(crc, networkOrderWord(first[0]), networkOrderWord(first[1]));
+  }
+  if (first != last) {
+    crc = updateWord(crc, networkOrderWord(*first));
+  }
+  return crc;
+}
+
+// Multiply two polynomials modulo the CRC polynomial (bit-reflected, x^0 is the MSB)
+constexpr auto multModP(uint32_t a, uint32_t b) noexcept {
+  auto m = uint32_t{1} << 31;
+  auto p = uint32_t{};
+
+  for (;;) {
+    if ((a & m) != 0) {
+      p ^= b;
+      if ((a & (m - 1)) == 0) {
+        break;
+      }
+    }
+    m >>= 1;
+    b = (b & 1) == 0 ? b >> 1 : (b >> 1) ^ polynomial;
+  }
+  return p;
+}
+
+// x^(2^k) modulo the CRC polynomial
+constexpr auto x2nTable = []() {
+  auto result = std::array<uint32_t, 32>();
+  auto p = uint32_t{1} << 30; // x^1
+
+  for (auto &entry : result) {
+    entry = p;
+    p = multModP(p, p);
+  }
+  return result;
+}();
+
+// Advance a CRC register through the specified number of zero bytes
+constexpr auto shift(uint32_t crc, uint64_t byteCount) noexcept {
+  auto p = uint32_t{1} << 31; // x^0
+
+  for (size_t k = 3; byteCount != 0; byteCount >>= 1, ++k) {
+    if ((byteCount & 1) != 0) {
+      p = multModP(x2nTable[k % x2nTable.size()], p);
+    }
+  }
+  return multModP(p, crc);
+}
 } // namespace crc32
 } // namespace
 
@@ -69,9 +160,7 @@ constexpr auto HashFunction::consume(ConvertibleToUint32 value) noexcept -> Hash
   const auto value_ = static_cast<uint32_t>(value);
 
   // Hash bytes in network order (big endian)
-  for (int32_t i = 24; 0 <= i; i -= 8) {
-    m_hash = (m_hash >> 8) ^ Common::at(crc32::table, (m_hash ^ (value_ >> i)) & 0xFF);
-  }
+  m_hash = crc32::updateWord(m_hash, crc32::networkOrderWord(value_));
   return *this;
 }
 
@@ -90,15 +179,44 @@ constexpr auto HashFunction::result() const noexcept { return ~m_hash; }
 auto HashFunction::toString(uint32_t value) -> std::string { return fmt::format("{:08x}", value); }
 
 auto videoDataHash(const Common::Frame<> &frame) noexcept -> HashFunction::Result {
-  auto hash = HashFunction{};
+  // The samples of all planes are hashed in chunks that are combined afterwards. Because a CRC is
+  // linear, the register after chunks A and B is that of A advanced through the length of B, XOR
+  // the register of B on its own.
+  static constexpr auto samplesPerChunk = size_t{1} << 18U;
+
+  struct Chunk {
+    const Common::DefaultElement *first{};
+    const Common::DefaultElement *last{};
+    uint32_t crc{};
+  };
+  auto chunks = std::vector<Chunk>{};
 
   for (const auto &plane : frame.getPlanes()) {
-    for (auto sample : plane) {
-      hash.consume(sample);
+    for (auto *first = plane.data(); first != plane.data() + plane.size();) {
+      const auto count =
+          std::min(samplesPerChunk, static_cast<size_t>(plane.data() + plane.size() - first));
+      chunks.push_back({first, first + count});
+      first += count;
     }
   }
 
-  return hash.result();
+  const auto hashChunk = [&chunks](size_t i) {
+    chunks[i].crc = crc32::updateSamples(uint32_t{}, chunks[i].first, chunks[i].last);
+  };
+
+  if (chunks.size() == 1) {
+    hashChunk(0);
+  } else if (1 < chunks.size()) {
+    Common::parallel_for(chunks.size(), hashChunk);
+  }
+
+  auto crc = uint32_t{0xFFFFFFFF};
+
+  for (const auto &chunk : chunks) {
+    crc = crc32::shift(crc, uint64_t{4} * static_cast<uint64_t>(chunk.last - chunk.first)) ^
+          chunk.crc;
+  }
+  return ~crc;
 }
 
 auto blockToPatchMapHash(const MivBitstream::AtlasAccessUnit &frame) noexcept
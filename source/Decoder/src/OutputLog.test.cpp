@@ -340,3 +340,44 @@ TEST_CASE("Decoder::writeFrameToOutputLog") {
     CHECK(stream.str() == reference);
   }
 }
+
+namespace test {
+namespace {
+// Bit-at-a-time CRC-32 of the samples in network order, as a reference for the sliced version
+auto bitwiseVideoDataHash(const TMIV::Common::Frame<> &frame) {
+  auto crc = uint32_t{0xFFFFFFFF};
+
+  for (const auto &plane : frame.getPlanes()) {
+    for (uint32_t sample : plane) {
+      for (int32_t i = 24; 0 <= i; i -= 8) {
+        crc ^= (sample >> i) & 0xFF;
+
+        for (int32_t j = 0; j < 8; ++j) {
+          crc = (crc & 1) == 0 ? crc >> 1 : (crc >> 1) ^ 0xEDB88320;
+        }
+      }
+    }
+  }
+  return ~crc;
+}
+} // namespace
+} // namespace test
+
+TEST_CASE("Decoder::videoDataHash matches a bit-at-a-time CRC-32") {
+  // Odd sizes to have partial chunks and an odd number of samples per plane
+  const auto size = GENERATE(TMIV::Common::Vec2i{1, 1}, TMIV::Common::Vec2i{7, 3},
+                             TMIV::Common::Vec2i{1023, 769});
+  CAPTURE(size);
+
+  auto frame = TMIV::Common::Frame<>::yuv444(size, 10);
+  auto state = uint32_t{12345};
+
+  for (auto &plane : frame.getPlanes()) {
+    for (auto &sample : plane) {
+      state = state * 1103515245U + 12345U;
+      sample = static_cast<uint16_t>(state >> 22U);
+    }
+  }
+
+  CHECK(TMIV::Decoder::videoDataHash(frame) == test::bitwiseVideoDataHash(frame));
+}
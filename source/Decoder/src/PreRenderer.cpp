@@ -36,7 +36,49 @@
 #include <TMIV/Common/LoggingStrategyFmt.h>
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
 
+#include <exception>
+#include <functional>
+#include <future>
+#include <utility>
+
 namespace TMIV::Decoder {
+namespace {
+// Run the tasks concurrently, the first one on the calling thread. After all tasks have completed,
+// the exception of the first failed task (in task order) is rethrown.
+void runConcurrently(const std::vector<std::function<void()>> &tasks) {
+  auto futures = std::vector<std::future<void>>{};
+  futures.reserve(tasks.size());
+
+  for (size_t i = 1; i < tasks.size(); ++i) {
+    futures.push_back(std::async(std::launch::async, tasks[i]));
+  }
+
+  auto error = std::exception_ptr{};
+
+  try {
+    if (!tasks.empty()) {
+      tasks.front()();
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  for (auto &future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+} // namespace
+
 PreRenderer::PreRenderer(const Common::Json &componentNode)
     : m_geometryScaler{componentNode.optional("GeometryScaler")} {
   if (const auto &node = componentNode.optional("entityDecodeRange")) {
@@ -53,23 +95,33 @@ void PreRenderer::preRenderFrame(MivBitstream::AccessUnit &frame) const {
   // ISO/IEC 23090-12 Annex A: profiles, tiers and levels
   checkRestrictions(frame);
 
-  for (uint8_t atlasIdx = 0; atlasIdx <= frame.vps.vps_atlas_count_minus1(); ++atlasIdx) {
-    const auto atlasId = frame.vps.vps_atlas_id(atlasIdx);
-    auto &atlas = frame.atlas[atlasIdx];
-
-    // ISO/IEC 23090-12 Annex B: post decoding
-    unpackDecodedPackedVideo(frame.vps, atlasId, atlas);
-    convertNominalFormat(frame.vps, atlasId, atlas);
-
-    // ISO/IEC 23090-12 Annex H: rendering processes
-    offsetTexture(frame.vps, atlasId, atlas);
-    scaleGeometryVideo(frame.gup, atlas);
-    reconstructOccupancy(frame.viewParamsList, atlas);
-    filterEntities(atlas);
-
-    // Not specified
-    constructPixelToPatchMap(atlas);
+  // The atlases are pre-rendered concurrently. Each task only writes to its own atlas access unit,
+  // thus the output does not depend on the scheduling.
+  const auto &vps = frame.vps;
+  const auto &gup = frame.gup;
+  const auto &vpl = frame.viewParamsList;
+  auto tasks = std::vector<std::function<void()>>{};
+
+  for (uint8_t atlasIdx = 0; atlasIdx <= vps.vps_atlas_count_minus1(); ++atlasIdx) {
+    tasks.emplace_back([this, &vps, &gup, &vpl, atlasId = vps.vps_atlas_id(atlasIdx),
+                        &atlas = frame.atlas[atlasIdx]]() {
+      // ISO/IEC 23090-12 Annex B: post decoding
+      unpackDecodedPackedVideo(vps, atlasId, atlas);
+      convertNominalFormat(vps, atlasId, atlas);
+
+      // ISO/IEC 23090-12 Annex H: rendering processes
+      const auto patches = MivBitstream::PatchRenderTable{atlas.patchParamsList, vpl};
+      offsetTexture(vps, atlasId, atlas);
+      scaleGeometryVideo(gup, atlas);
+      reconstructOccupancy(vpl, patches, atlas);
+      filterEntities(patches, atlas);
+
+      // Not specified
+      constructPixelToPatchMap(patches, atlas);
+    });
   }
+
+  runConcurrently(tasks);
 }
 
 void PreRenderer::checkRestrictions(const MivBitstream::AccessUnit &frame) {
@@ -89,23 +141,30 @@ void PreRenderer::checkRestrictions(const MivBitstream::AccessUnit &frame) {
 void PreRenderer::convertNominalFormat(const MivBitstream::V3cParameterSet &vps,
                                        MivBitstream::AtlasId atlasId,
                                        MivBitstream::AtlasAccessUnit &atlas) {
-  if (!atlas.decOccFrame.empty()) {
-    convertOccupancyNominalFormat(vps, atlasId, atlas, atlas.decOccFrame);
-  } else if (!atlas.unpckOccFrame.empty()) {
-    convertOccupancyNominalFormat(vps, atlasId, atlas, atlas.unpckOccFrame);
-  }
-
-  if (!atlas.decGeoFrame.empty()) {
-    convertGeometryNominalFormat(vps, atlasId, atlas, atlas.decGeoFrame);
-  } else if (!atlas.unpckGeoFrame.empty()) {
-    convertGeometryNominalFormat(vps, atlasId, atlas, atlas.unpckGeoFrame);
-  }
-
-  if (!atlas.decAttrFrame.empty()) {
-    convertAttributeNominalFormat(vps, atlasId, atlas, atlas.decAttrFrame);
-  } else if (!atlas.unpckAttrFrame.empty()) {
-    convertAttributeNominalFormat(vps, atlasId, atlas, atlas.unpckAttrFrame);
-  }
+  // The components are converted concurrently. Each task only writes to its own *NF frame.
+  runConcurrently({
+      [&]() {
+        if (!atlas.decOccFrame.empty()) {
+          convertOccupancyNominalFormat(vps, atlasId, atlas, atlas.decOccFrame);
+        } else if (!atlas.unpckOccFrame.empty()) {
+          convertOccupancyNominalFormat(vps, atlasId, atlas, atlas.unpckOccFrame);
+        }
+      },
+      [&]() {
+        if (!atlas.decGeoFrame.empty()) {
+          convertGeometryNominalFormat(vps, atlasId, atlas, atlas.decGeoFrame);
+        } else if (!atlas.unpckGeoFrame.empty()) {
+          convertGeometryNominalFormat(vps, atlasId, atlas, atlas.unpckGeoFrame);
+        }
+      },
+      [&]() {
+        if (!atlas.decAttrFrame.empty()) {
+          convertAttributeNominalFormat(vps, atlasId, atlas, atlas.decAttrFrame);
+        } else if (!atlas.unpckAttrFrame.empty()) {
+          convertAttributeNominalFormat(vps, atlasId, atlas, atlas.unpckAttrFrame);
+        }
+      },
+  });
 }
 
 void PreRenderer::convertOccupancyNominalFormat(const MivBitstream::V3cParameterSet &vps,
@@ -130,10 +189,8 @@ void PreRenderer::convertOccupancyNominalFormat(const MivBitstream::V3cParameter
     occThreshold = pin.pin_lossy_occupancy_compression_threshold();
   }
 
-  auto decOccFrameNBD = convertBitDepth(inFrame, occBitDepthNF, occMSBAlignFlag, 1);
-  const auto decOccFrameNR =
-      convertResolution(std::move(decOccFrameNBD), videoWidthNF, videoHeightNF);
-  atlas.occFrameNF = thresholdOccupancy(decOccFrameNR, occThreshold);
+  atlas.occFrameNF = convertOccupancyFrame(inFrame, occBitDepthNF, occMSBAlignFlag, occThreshold,
+                                           videoWidthNF, videoHeightNF);
 }
 
 void PreRenderer::convertGeometryNominalFormat(const MivBitstream::V3cParameterSet &vps,
@@ -169,8 +226,8 @@ void PreRenderer::convertGeometryNominalFormat(const MivBitstream::V3cParameterS
     geoMSBAlignFlag = pin.pin_geometry_MSB_align_flag();
   }
 
-  auto decGeoFrameNBD = convertBitDepth(inFrame, geoBitDepthNF, geoMSBAlignFlag, 1);
-  atlas.geoFrameNF = convertResolution(std::move(decGeoFrameNBD), videoWidthNF, videoHeightNF);
+  atlas.geoFrameNF =
+      convertFrame(inFrame, geoBitDepthNF, geoMSBAlignFlag, 1, videoWidthNF, videoHeightNF);
 }
 
 void PreRenderer::convertAttributeNominalFormat(const MivBitstream::V3cParameterSet &vps,
@@ -201,48 +258,98 @@ void PreRenderer::convertAttributeNominalFormat(const MivBitstream::V3cParameter
       attrDim = pin.pin_attribute_dimension_minus1(attrIdx) + 1U;
     }
 
-    auto decAttrFrameNBD =
-        convertBitDepth(inFrame[attrIdx], attrBitDepthNF, attrMSBAlignFlag, attrDim);
-    auto decAttrFrameNCF = upsampleChroma(std::move(decAttrFrameNBD));
-    atlas.attrFrameNF[attrIdx] =
-        convertResolution(std::move(decAttrFrameNCF), videoWidthNF, videoHeightNF);
+    atlas.attrFrameNF[attrIdx] = convertFrame(inFrame[attrIdx], attrBitDepthNF, attrMSBAlignFlag,
+                                              attrDim, videoWidthNF, videoHeightNF);
   }
 }
 
-auto PreRenderer::convertBitDepth(Common::Frame<> frame, uint32_t nominalBitDepth,
-                                  bool alignmentFlag, uint8_t dimensions) -> Common::Frame<> {
-  PRECONDITION(dimensions <= frame.getNumberOfPlanes());
-  frame.getPlanes().erase(frame.getPlanes().begin() + dimensions, frame.getPlanes().end());
-
+namespace {
+// ISO/IEC 23090-12 Annex B.3.2 for a single sample
+auto bitDepthConversion(uint32_t bitDepth, uint32_t nominalBitDepth, bool alignmentFlag) {
   const auto bitDepthDifference =
-      static_cast<int32_t>(frame.getBitDepth()) - static_cast<int32_t>(nominalBitDepth);
-
-  if (alignmentFlag) {
-    for (auto &plane : frame.getPlanes()) {
-      for (auto &sample : plane) {
-        sample >>= bitDepthDifference;
-      }
+      static_cast<int32_t>(bitDepth) - static_cast<int32_t>(nominalBitDepth);
+  const auto maxValue = Common::maxLevel<Common::DefaultElement>(nominalBitDepth);
+
+  return [=](Common::DefaultElement sample) {
+    if (alignmentFlag) {
+      return static_cast<Common::DefaultElement>(0 <= bitDepthDifference
+                                                     ? sample >> bitDepthDifference
+                                                     : sample << -bitDepthDifference);
     }
-  } else if (bitDepthDifference > 0) {
-    const auto maxValue = Common::maxLevel<uint16_t>(nominalBitDepth);
-
-    for (auto &plane : frame.getPlanes()) {
-      for (auto &sample : plane) {
-        sample = std::min(sample, maxValue);
-      }
+    if (0 < bitDepthDifference) {
+      return std::min(sample, maxValue);
     }
-  } else if (bitDepthDifference < 0 && alignmentFlag) {
-    for (auto &plane : frame.getPlanes()) {
-      for (auto &sample : plane) {
-        sample <<= (-bitDepthDifference);
+    return sample; // pass-through
+  };
+}
+
+// Map each output row or column to an input row or column of a plane by composing the
+// nearest-neighbour chroma up-sampling (plane size to luma size) with the nearest-neighbour
+// resolution conversion (luma size to nominal size)
+auto nearestNeighbourMap(size_t outSize, size_t lumaSize, size_t planeSize) {
+  auto result = std::vector<size_t>(outSize);
+
+  for (size_t i = 0; i < outSize; ++i) {
+    result[i] = (i * lumaSize / outSize) * planeSize / lumaSize;
+  }
+  return result;
+}
+
+// Convert the first planes of a decoded frame to the nominal resolution in a single pass, writing
+// transform(sample) directly into the output planes
+template <typename Element, typename Transform>
+void convertPlanes(const Common::Frame<> &inFrame, uint8_t dimensions, Common::Frame<Element> &out,
+                   Transform transform) {
+  PRECONDITION(dimensions <= inFrame.getNumberOfPlanes());
+
+  const auto &luma = inFrame.getPlane(0);
+
+  for (uint8_t c = 0; c < dimensions; ++c) {
+    const auto &inPlane = inFrame.getPlane(c);
+    auto &outPlane = out.getPlane(c);
+
+    PRECONDITION(inPlane.width() != 0 && inPlane.height() != 0);
+
+    const auto rows = nearestNeighbourMap(outPlane.height(), luma.height(), inPlane.height());
+    const auto columns = nearestNeighbourMap(outPlane.width(), luma.width(), inPlane.width());
+
+    for (size_t i = 0; i < outPlane.height(); ++i) {
+      for (size_t j = 0; j < outPlane.width(); ++j) {
+        outPlane(i, j) = transform(inPlane(rows[i], columns[j]));
       }
     }
-  } else {
-    // pass-through
   }
+}
+} // namespace
+
+auto PreRenderer::convertFrame(const Common::Frame<> &inFrame, uint32_t nominalBitDepth,
+                               bool alignmentFlag, uint8_t dimensions, int32_t videoWidthNF,
+                               int32_t videoHeightNF) -> Common::Frame<> {
+  auto outFrame = Common::Frame<>{};
+  outFrame.getPlanes().assign(
+      dimensions,
+      Common::Mat<>{{static_cast<size_t>(videoHeightNF), static_cast<size_t>(videoWidthNF)}});
+  outFrame.setBitDepth(nominalBitDepth);
 
-  frame.setBitDepth(nominalBitDepth);
-  return frame;
+  convertPlanes(inFrame, dimensions, outFrame,
+                bitDepthConversion(inFrame.getBitDepth(), nominalBitDepth, alignmentFlag));
+  return outFrame;
+}
+
+auto PreRenderer::convertOccupancyFrame(const Common::Frame<> &inFrame, uint32_t nominalBitDepth,
+                                        bool alignmentFlag, uint8_t threshold,
+                                        int32_t videoWidthNF, int32_t videoHeightNF)
+    -> Common::Frame<bool> {
+  auto outFrame =
+      Common::Frame<bool>{{videoWidthNF, videoHeightNF}, 1, Common::ColorFormat::YUV400};
+  const auto lossyThreshold =
+      Common::shift(threshold, Common::assertDownCast<int32_t>(nominalBitDepth) - 8);
+
+  convertPlanes(inFrame, 1, outFrame,
+                [lossyThreshold, convert = bitDepthConversion(inFrame.getBitDepth(),
+                                                              nominalBitDepth, alignmentFlag)](
+                    Common::DefaultElement sample) { return lossyThreshold < convert(sample); });
+  return outFrame;
 }
 
 namespace {
@@ -292,19 +399,6 @@ auto PreRenderer::upsampleChroma(Common::Frame<> inFrame) -> Common::Frame<> {
   return convertResolution(std::move(inFrame), size.x(), size.y());
 }
 
-auto PreRenderer::thresholdOccupancy(const Common::Frame<> &inFrame, uint8_t threshold)
-    -> Common::Frame<bool> {
-  auto outFrame = Common::Frame<bool>{inFrame.getSize(), 1, Common::ColorFormat::YUV400};
-  const auto inputBitDepth = Common::assertDownCast<int32_t>(inFrame.getBitDepth());
-  const auto lossyThreshold = Common::shift(threshold, inputBitDepth - 8);
-
-  PRECONDITION(!inFrame.empty());
-  std::transform(inFrame.getPlane(0).cbegin(), inFrame.getPlane(0).cend(),
-                 outFrame.getPlane(0).begin(),
-                 [lossyThreshold](uint16_t sample) { return lossyThreshold < sample; });
-
-  return outFrame;
-}
 void PreRenderer::unpackDecodedPackedVideo(const MivBitstream::V3cParameterSet &vps,
                                            MivBitstream::AtlasId atlasId,
                                            MivBitstream::AtlasAccessUnit &atlas) {
@@ -482,6 +576,7 @@ void PreRenderer::copyDataFromPackedRegionsToUnpackedVideoComponentFrames(
 }
 
 void PreRenderer::reconstructOccupancy(const MivBitstream::ViewParamsList &vpl,
+                                       const MivBitstream::PatchRenderTable &patches,
                                        MivBitstream::AtlasAccessUnit &atlas) {
   atlas.occFrame.createY({atlas.asps.asps_frame_width(), atlas.asps.asps_frame_height()});
   auto &occPlane = atlas.occFrame.getPlane(0);
@@ -490,6 +585,16 @@ void PreRenderer::reconstructOccupancy(const MivBitstream::ViewParamsList &vpl,
       atlas.asps.asps_miv_extension_present_flag() &&
       atlas.asps.asps_miv_extension().asme_embedded_occupancy_enabled_flag();
 
+  auto occupancyTransforms = std::vector<MivBitstream::OccupancyTransform>{};
+
+  if (asme_embedded_occupancy_enabled_flag) {
+    occupancyTransforms.reserve(patches.size());
+
+    for (size_t k = 0; k < patches.size(); ++k) {
+      occupancyTransforms.emplace_back(vpl[patches.viewIdx[k]], atlas.patchParamsList[k]);
+    }
+  }
+
   for (int32_t i = 0; i < atlas.occFrame.getHeight(); ++i) {
     for (int32_t j = 0; j < atlas.occFrame.getWidth(); ++j) {
       const auto patchIdx = atlas.patchIdx(i, j);
@@ -500,11 +605,7 @@ void PreRenderer::reconstructOccupancy(const MivBitstream::ViewParamsList &vpl,
       } else if (!atlas.occFrameNF.empty()) {
         sampleOccFlag = atlas.occFrameNF.getPlane(0)(i, j);
       } else if (asme_embedded_occupancy_enabled_flag) {
-        const auto &pp = atlas.patchParamsList[patchIdx];
-
-        const auto occupancyTransform =
-            MivBitstream::OccupancyTransform{vpl[pp.atlasPatchProjectionId()], pp};
-        sampleOccFlag = occupancyTransform.occupant(atlas.geoFrame.getPlane(0)(i, j));
+        sampleOccFlag = occupancyTransforms[patchIdx].occupant(atlas.geoFrame.getPlane(0)(i, j));
       } else {
         sampleOccFlag = true;
       }
@@ -514,7 +615,8 @@ void PreRenderer::reconstructOccupancy(const MivBitstream::ViewParamsList &vpl,
   }
 }
 
-void PreRenderer::filterEntities(MivBitstream::AtlasAccessUnit &atlas) const {
+void PreRenderer::filterEntities(const MivBitstream::PatchRenderTable &patches,
+                                 MivBitstream::AtlasAccessUnit &atlas) const {
   if (!atlas.asps.asps_miv_extension_present_flag() ||
       0 == atlas.asps.asps_miv_extension().asme_max_entity_id() || !m_entityDecodeRange) {
     return;
@@ -524,7 +626,7 @@ void PreRenderer::filterEntities(MivBitstream::AtlasAccessUnit &atlas) const {
 
   for (auto &patchIdx : atlas.blockToPatchMap.getPlane(0)) {
     if (patchIdx != Common::unusedPatchIdx) {
-      const auto entityId = atlas.patchParamsList[patchIdx].atlasPatchEntityId();
+      const auto entityId = patches.entityId[patchIdx];
 
       if (entityId < entityDecodeRange[0] || entityDecodeRange[1] <= entityId) {
         patchIdx = Common::unusedPatchIdx;
@@ -589,16 +691,17 @@ void PreRenderer::scaleGeometryVideo(
   }
 }
 
-void PreRenderer::constructPixelToPatchMap(MivBitstream::AtlasAccessUnit &atlas) const {
+void PreRenderer::constructPixelToPatchMap(const MivBitstream::PatchRenderTable &patches,
+                                           MivBitstream::AtlasAccessUnit &atlas) const {
   atlas.pixelToPatchMap.createY(
       Common::Vec2i{atlas.asps.asps_frame_width(), atlas.asps.asps_frame_height()});
   atlas.pixelToPatchMap.fillValue(Common::unusedPatchIdx);
 
-  for (const auto &pp : atlas.patchParamsList) {
-    const auto x1 = pp.atlasPatch2dPosX() + m_patchMargin;
-    const auto y1 = pp.atlasPatch2dPosY() + m_patchMargin;
-    const auto x2 = pp.atlasPatch2dPosX() + pp.atlasPatch2dSizeX() - m_patchMargin;
-    const auto y2 = pp.atlasPatch2dPosY() + pp.atlasPatch2dSizeY() - m_patchMargin;
+  for (size_t k = 0; k < patches.size(); ++k) {
+    const auto x1 = patches.pos2dX[k] + m_patchMargin;
+    const auto y1 = patches.pos2dY[k] + m_patchMargin;
+    const auto x2 = patches.pos2dX[k] + patches.size2dX[k] - m_patchMargin;
+    const auto y2 = patches.pos2dY[k] + patches.size2dY[k] - m_patchMargin;
 
     for (int32_t y = y1; y < y2; ++y) {
       for (int32_t x = x1; x < x2; ++x) {
@@ -35,6 +35,8 @@
 
 #include <TMIV/Decoder/PreRenderer.h>
 
+#include <random>
+
 using namespace std::string_view_literals;
 
 namespace test {
@@ -49,6 +51,99 @@ auto createUnit() {
 
   return TMIV::Decoder::PreRenderer{componentNode};
 }
+
+// The conversion to nominal format in separate passes, as in ISO/IEC 23090-12 Annex B: bit depth
+// conversion (B.3.2), nearest-neighbour chroma up-sampling (alternative for B.3.7) and resolution
+// conversion (B.3.3)
+auto unfusedConvertFrame(TMIV::Common::Frame<> frame, uint32_t nominalBitDepth, bool alignmentFlag,
+                         uint8_t dimensions, int32_t videoWidthNF, int32_t videoHeightNF) {
+  frame.getPlanes().resize(dimensions);
+
+  const auto bitDepthDifference =
+      static_cast<int32_t>(frame.getBitDepth()) - static_cast<int32_t>(nominalBitDepth);
+  const auto maxValue = TMIV::Common::maxLevel<uint16_t>(nominalBitDepth);
+
+  for (auto &plane : frame.getPlanes()) {
+    for (auto &sample : plane) {
+      if (alignmentFlag && 0 <= bitDepthDifference) {
+        sample = static_cast<uint16_t>(sample >> bitDepthDifference);
+      } else if (alignmentFlag) {
+        sample = static_cast<uint16_t>(sample << -bitDepthDifference);
+      } else if (0 < bitDepthDifference) {
+        sample = std::min(sample, maxValue);
+      }
+    }
+  }
+
+  const auto resample = [](const TMIV::Common::Mat<> &inPlane, size_t height, size_t width) {
+    auto outPlane = TMIV::Common::Mat<>{{height, width}};
+
+    for (size_t i = 0; i < height; ++i) {
+      for (size_t j = 0; j < width; ++j) {
+        outPlane(i, j) = inPlane(i * inPlane.height() / height, j * inPlane.width() / width);
+      }
+    }
+    return outPlane;
+  };
+
+  const auto lumaHeight = frame.getPlane(0).height();
+  const auto lumaWidth = frame.getPlane(0).width();
+  auto result = TMIV::Common::Frame<>{};
+
+  for (const auto &plane : frame.getPlanes()) {
+    result.getPlanes().push_back(resample(resample(plane, lumaHeight, lumaWidth),
+                                          static_cast<size_t>(videoHeightNF),
+                                          static_cast<size_t>(videoWidthNF)));
+  }
+  result.setBitDepth(nominalBitDepth);
+  return result;
+}
+
+// ISO/IEC 23090-12 Annex B.3.9 applied to the output of unfusedConvertFrame
+auto unfusedThresholdOccupancy(const TMIV::Common::Frame<> &frame, uint8_t threshold) {
+  const auto lossyThreshold =
+      TMIV::Common::shift(threshold, static_cast<int32_t>(frame.getBitDepth()) - 8);
+  auto result = TMIV::Common::Mat<bool>{frame.getPlane(0).sizes()};
+
+  std::transform(frame.getPlane(0).cbegin(), frame.getPlane(0).cend(), result.begin(),
+                 [lossyThreshold](uint16_t sample) { return lossyThreshold < sample; });
+  return result;
+}
+
+template <typename Element>
+auto samePlane(const TMIV::Common::Mat<Element> &a, const TMIV::Common::Mat<Element> &b) {
+  return a.sizes() == b.sizes() && std::equal(a.cbegin(), a.cend(), b.cbegin());
+}
+
+template <typename Element>
+auto sameFrame(const TMIV::Common::Frame<Element> &a, const TMIV::Common::Frame<Element> &b) {
+  return a.getBitDepth() == b.getBitDepth() &&
+         std::equal(a.getPlanes().cbegin(), a.getPlanes().cend(), b.getPlanes().cbegin(),
+                    b.getPlanes().cend(), samePlane<Element>);
+}
+
+template <typename Random> auto randomFrame(Random &random, bool yuv420) {
+  const auto size = [&random]() {
+    return 2 * std::uniform_int_distribution<int32_t>{1, 12}(random);
+  };
+  const auto bitDepth = std::uniform_int_distribution<uint32_t>{1, 16}(random);
+
+  auto frame = TMIV::Common::Frame<>{};
+
+  if (yuv420) {
+    frame.createYuv420({size(), size()}, bitDepth);
+  } else {
+    frame.createY({size(), size()}, bitDepth);
+  }
+
+  auto sample = std::uniform_int_distribution<uint32_t>{0, frame.maxValue()};
+
+  for (auto &plane : frame.getPlanes()) {
+    std::generate(plane.begin(), plane.end(),
+                  [&]() { return static_cast<uint16_t>(sample(random)); });
+  }
+  return frame;
+}
 } // namespace test
 
 TEST_CASE("Decoder::PreRenderer") {
@@ -456,4 +551,132 @@ TEST_CASE("Decoder::PreRenderer") {
     CHECK(std::accumulate(atlas.texFrame.getPlane(2).cbegin(), atlas.texFrame.getPlane(2).cend(),
                           uint32_t{}) == 7280);
   }
+
+  SECTION("Multiple atlases") {
+    const auto unit = test::createUnit();
+
+    frame.vps.vps_atlas_count_minus1(1).vps_atlas_id(1, TMIV::MivBitstream::AtlasId{1});
+    frame.atlas.emplace_back();
+
+    for (uint8_t k = 0; k < 2; ++k) {
+      const auto atlasId = TMIV::MivBitstream::AtlasId{k};
+
+      frame.vps.vps_frame_width(atlasId, 20)
+          .vps_frame_height(atlasId, 10)
+          .vps_geometry_video_present_flag(atlasId, true)
+          .geometry_information(atlasId)
+          .gi_geometry_2d_bit_depth_minus1(6);
+
+      auto &atlas = frame.atlas[k];
+
+      atlas.asps.asps_frame_width(20).asps_frame_height(10).asps_log2_patch_packing_block_size(1);
+      atlas.blockToPatchMap.createY({10, 5});
+      atlas.decGeoFrame.createY({20, 10}, 7);
+
+      for (int32_t i = 0; i < 10; ++i) {
+        for (int32_t j = 0; j < 20; ++j) {
+          atlas.decGeoFrame.getPlane(0)(i, j) = static_cast<uint8_t>(i + 4 * j + k);
+        }
+      }
+    }
+
+    SECTION("The atlases are pre-rendered independently") {
+      unit.preRenderFrame(frame);
+
+      for (uint8_t k = 0; k < 2; ++k) {
+        const auto &atlas = frame.atlas[k];
+
+        REQUIRE(atlas.geoFrame.getWidth() == 20);
+        REQUIRE(atlas.geoFrame.getHeight() == 10);
+        CHECK(std::accumulate(atlas.geoFrame.getPlane(0).cbegin(),
+                              atlas.geoFrame.getPlane(0).cend(), uint32_t{}) == 8500U + 200U * k);
+      }
+    }
+
+    SECTION("An error in any of the atlases is reported") {
+      frame.vps.vps_miv_extension().vme_geometry_scale_enabled_flag(true);
+      frame.atlas[0].asps.asps_miv_extension().asme_geometry_scale_enabled_flag(true);
+      frame.atlas[1]
+          .asps.asps_miv_extension()
+          .asme_geometry_scale_enabled_flag(true)
+          .asme_geometry_scale_factor_x_minus1(2);
+
+      REQUIRE_THROWS(unit.preRenderFrame(frame));
+    }
+  }
+}
+
+TEST_CASE("Decoder::PreRenderer fused and unfused conversion to nominal format are identical") {
+  const auto unit = test::createUnit();
+  auto random = std::mt19937{5};
+
+  const auto randomBitDepth = [&random]() {
+    return std::uniform_int_distribution<uint32_t>{1, 16}(random);
+  };
+  const auto randomFlag = [&random]() { return std::bernoulli_distribution{}(random); };
+
+  for (int32_t trial = 0; trial < 50; ++trial) {
+    CAPTURE(trial);
+
+    const auto videoWidthNF = 2 * std::uniform_int_distribution<int32_t>{1, 12}(random);
+    const auto videoHeightNF = 2 * std::uniform_int_distribution<int32_t>{1, 12}(random);
+    const auto occBitDepthNF = randomBitDepth();
+    const auto occMSBAlignFlag = randomFlag();
+    const auto occThreshold = static_cast<uint8_t>(std::uniform_int_distribution{0, 255}(random));
+    const auto geoBitDepthNF = randomBitDepth();
+    const auto geoMSBAlignFlag = randomFlag();
+    const auto attrBitDepthNF = randomBitDepth();
+    const auto attrMSBAlignFlag = randomFlag();
+
+    auto frame = TMIV::MivBitstream::AccessUnit{};
+
+    frame.vps.vps_frame_width({}, videoWidthNF)
+        .vps_frame_height({}, videoHeightNF)
+        .vps_occupancy_video_present_flag({}, true)
+        .occupancy_information({})
+        .oi_occupancy_2d_bit_depth_minus1(static_cast<uint8_t>(occBitDepthNF - 1))
+        .oi_occupancy_MSB_align_flag(occMSBAlignFlag)
+        .oi_lossy_occupancy_compression_threshold(occThreshold);
+    frame.vps.vps_geometry_video_present_flag({}, true)
+        .geometry_information({})
+        .gi_geometry_2d_bit_depth_minus1(static_cast<uint8_t>(geoBitDepthNF - 1))
+        .gi_geometry_MSB_align_flag(geoMSBAlignFlag);
+    frame.vps.vps_attribute_video_present_flag({}, true)
+        .attribute_information({})
+        .ai_attribute_count(1)
+        .ai_attribute_2d_bit_depth_minus1(0, static_cast<uint8_t>(attrBitDepthNF - 1))
+        .ai_attribute_MSB_align_flag(0, attrMSBAlignFlag)
+        .ai_attribute_dimension_minus1(0, 2)
+        .ai_attribute_type_id(0, TMIV::MivBitstream::AiAttributeTypeId::ATTR_TEXTURE);
+
+    auto &atlas = frame.atlas.emplace_back();
+
+    atlas.asps.asps_frame_width(videoWidthNF)
+        .asps_frame_height(videoHeightNF)
+        .asps_log2_patch_packing_block_size(1);
+    atlas.blockToPatchMap.createY({videoWidthNF / 2, videoHeightNF / 2});
+    atlas.decOccFrame = test::randomFrame(random, false);
+    atlas.decGeoFrame = test::randomFrame(random, false);
+    atlas.decAttrFrame.push_back(test::randomFrame(random, true));
+
+    const auto occFrameNF =
+        test::unfusedThresholdOccupancy(test::unfusedConvertFrame(atlas.decOccFrame, occBitDepthNF,
+                                                                  occMSBAlignFlag, 1, videoWidthNF,
+                                                                  videoHeightNF),
+                                        occThreshold);
+    const auto geoFrameNF = test::unfusedConvertFrame(atlas.decGeoFrame, geoBitDepthNF,
+                                                      geoMSBAlignFlag, 1, videoWidthNF,
+                                                      videoHeightNF);
+    const auto attrFrameNF = test::unfusedConvertFrame(atlas.decAttrFrame.front(), attrBitDepthNF,
+                                                       attrMSBAlignFlag, 3, videoWidthNF,
+                                                       videoHeightNF);
+
+    unit.preRenderFrame(frame);
+
+    REQUIRE(atlas.occFrameNF.getNumberOfPlanes() == 1);
+    REQUIRE(test::samePlane(atlas.occFrameNF.getPlane(0), occFrameNF));
+    REQUIRE(test::sameFrame(atlas.geoFrameNF, geoFrameNF));
+    REQUIRE(atlas.attrFrameNF.size() == 1);
+    REQUIRE(test::sameFrame(atlas.attrFrameNF.front(), attrFrameNF));
+  }
 }
@@ -33,53 +33,164 @@
 
 #include <TMIV/Decoder/V3cUnitBuffer.h>
 
+#include <TMIV/Common/verify.h>
+
 #include <fmt/format.h>
 
+#include <numeric>
 #include <utility>
 
 namespace TMIV::Decoder {
-V3cUnitBuffer::V3cUnitBuffer(Common::Source<MivBitstream::V3cUnit> source, OnVps onVps)
-    : m_source{std::move(source)}, m_onVps{std::move(onVps)} {}
+namespace {
+using MivBitstream::V3cUnitHeader;
+using MivBitstream::VuhUnitType;
+
+// Pack the header fields that take part in V3cUnitHeader::operator== into a single key
+auto queueKey(const V3cUnitHeader &vuh) -> uint64_t {
+  const auto type = vuh.vuh_unit_type();
+  auto key = uint64_t{static_cast<uint8_t>(type)} << 48U;
+
+  if (type == VuhUnitType::V3C_VPS) {
+    return key;
+  }
+  key |= uint64_t{vuh.vuh_v3c_parameter_set_id()} << 40U;
+
+  if (type == VuhUnitType::V3C_CAD) {
+    return key;
+  }
+  key |= static_cast<uint64_t>(vuh.vuh_atlas_id().asInt()) << 32U;
+
+  if (type == VuhUnitType::V3C_OVD || type == VuhUnitType::V3C_AD ||
+      type == VuhUnitType::V3C_PVD) {
+    return key;
+  }
+  key |= uint64_t{vuh.vuh_map_index()} << 24U;
+  key |= uint64_t{vuh.vuh_auxiliary_video_flag()} << 16U;
+
+  if (type == VuhUnitType::V3C_GVD) {
+    return key;
+  }
+  key |= uint64_t{vuh.vuh_attribute_index()} << 8U;
+  key |= uint64_t{vuh.vuh_attribute_partition_index()};
+  return key;
+}
+
+const auto vpsKey = queueKey(V3cUnitHeader::vps());
+
+auto payloadBytes(const MivBitstream::V3cUnit &vu) -> size_t {
+  const auto &payload = vu.v3c_unit_payload().payload();
+
+  if (const auto *vsb = std::get_if<MivBitstream::VideoSubBitstream>(&payload)) {
+    return vsb->data().size();
+  }
+  if (const auto *asb = std::get_if<MivBitstream::AtlasSubBitstream>(&payload)) {
+    return std::accumulate(asb->nal_units().cbegin(), asb->nal_units().cend(), size_t{},
+                           [](size_t sum, const auto &nu) { return sum + nu.size(); });
+  }
+  return 0;
+}
+} // namespace
+
+V3cUnitBuffer::V3cUnitBuffer(Common::Source<MivBitstream::V3cUnit> source, OnVps onVps,
+                             size_t maxBufferedBytes)
+    : m_source{std::move(source)}, m_onVps{std::move(onVps)}, m_maxBufferedBytes{maxBufferedBytes} {
+}
 
 auto V3cUnitBuffer::operator()(MivBitstream::V3cUnitHeader vuh)
     -> std::optional<MivBitstream::V3cUnit> {
-  auto i = m_buffer.begin();
+  if (vuh == V3cUnitHeader::vps()) {
+    return pullVps();
+  }
+
+  // The reference stays valid when other queues are added
+  auto &queue = m_queues[queueKey(vuh)];
+
+  while (queue.empty()) {
+    if (!pull()) {
+      deliverVpsBefore(m_nextPosition);
+      return std::nullopt;
+    }
+  }
 
+  auto entry = pop(queue);
+  deliverVpsBefore(entry.position);
+  return std::move(entry.unit);
+}
+
+auto V3cUnitBuffer::pull() -> bool {
+  if (m_source == nullptr) {
+    return false;
+  }
+
+  auto vu = m_source();
+
+  if (!vu) {
+    m_source = nullptr;
+    return false;
+  }
+
+  const auto bytes = payloadBytes(*vu);
+
+  if (m_maxBufferedBytes < m_bufferedBytes + bytes) {
+    throw V3cUnitBufferError(
+        fmt::format("Buffering the following V3C unit would exceed the limit of {} bytes (with {} "
+                    "bytes already buffered): {}",
+                    m_maxBufferedBytes, m_bufferedBytes, vu->v3c_unit_header().summary()));
+  }
+
+  m_bufferedBytes += bytes;
+  m_queues[queueKey(vu->v3c_unit_header())].push_back(
+      Entry{m_nextPosition++, bytes, std::move(*vu)});
+  return true;
+}
+
+auto V3cUnitBuffer::pop(Queue &queue) -> Entry {
+  PRECONDITION(!queue.empty());
+
+  auto entry = std::move(queue.front());
+  queue.pop_front();
+  m_bufferedBytes -= entry.bytes;
+  return entry;
+}
+
+auto V3cUnitBuffer::pullVps() -> std::optional<MivBitstream::V3cUnit> {
   for (;;) {
-    if (i == m_buffer.end()) {
-      if (m_source == nullptr) {
-        return {};
-      }
-      if (auto vu = m_source()) {
-        i = m_buffer.insert(i, std::move(*vu));
-      } else {
-        m_source = nullptr;
-        return {};
+    // The VPS has to be the first of the buffered units in bitstream order
+    const Entry *first = nullptr;
+
+    for (const auto &[key, queue] : m_queues) {
+      if (!queue.empty() && (first == nullptr || queue.front().position < first->position)) {
+        first = &queue.front();
       }
     }
-    if (i->v3c_unit_header() == vuh) {
-      auto vu = std::move(*i);
-      m_buffer.erase(i);
-      return vu;
+
+    if (first != nullptr) {
+      if (first->unit.v3c_unit_header() != V3cUnitHeader::vps()) {
+        throw V3cUnitBufferError(fmt::format("Expected a VPS but found the following V3C unit: {}",
+                                             first->unit.v3c_unit_header().summary()));
+      }
+      return pop(m_queues[vpsKey]).unit;
     }
-    if (i->v3c_unit_header() == MivBitstream::V3cUnitHeader::vps()) {
-      auto vu = std::move(*i);
-      i = m_buffer.erase(i);
-      m_onVps(vu);
-    } else if (vuh == MivBitstream::V3cUnitHeader::vps()) {
-      throw V3cUnitBufferError(fmt::format("Expected a VPS but found the following V3C unit: {}",
-                                           i->v3c_unit_header().summary()));
-    } else {
-      ++i;
+    if (!pull()) {
+      return std::nullopt;
     }
   }
 }
 
+// Pass on the VPS units that were read past in search of another unit, in bitstream order
+void V3cUnitBuffer::deliverVpsBefore(uint64_t position) {
+  auto &queue = m_queues[vpsKey];
+
+  while (!queue.empty() && queue.front().position < position) {
+    m_onVps(pop(queue).unit);
+  }
+}
+
 auto videoSubBitstreamSource(std::shared_ptr<V3cUnitBuffer> buffer, MivBitstream::V3cUnitHeader vuh)
     -> Common::Source<MivBitstream::VideoSubBitstream> {
   return [buffer = std::move(buffer), vuh]() -> std::optional<MivBitstream::VideoSubBitstream> {
     if (auto v3cUnit = (*buffer)(vuh)) {
-      return v3cUnit->v3c_unit_payload().video_sub_bitstream();
+      return std::move(*v3cUnit).v3c_unit_payload().video_sub_bitstream();
     }
     return std::nullopt;
   };
@@ -89,7 +200,7 @@ auto atlasSubBitstreamSource(std::shared_ptr<V3cUnitBuffer> buffer, MivBitstream
     -> Common::Source<MivBitstream::AtlasSubBitstream> {
   return [buffer = std::move(buffer), vuh]() -> std::optional<MivBitstream::AtlasSubBitstream> {
     if (auto v3cUnit = (*buffer)(vuh)) {
-      return v3cUnit->v3c_unit_payload().atlas_sub_bitstream();
+      return std::move(*v3cUnit).v3c_unit_payload().atlas_sub_bitstream();
     }
     return std::nullopt;
   };
@@ -141,6 +141,35 @@ TEST_CASE("TMIV::Decoder::V3cUnitBuffer") {
 
     REQUIRE_THROWS_WITH(unit(vps), Contains("Expected a VPS but found the following V3C unit"));
   }
+
+  SECTION("The number of buffered payload bytes is bounded") {
+    using Catch::Contains;
+    using TMIV::Common::sourceFromIteratorPair;
+
+    static constexpr auto vps = V3cUnitHeader::vps();
+    static constexpr auto ovd = V3cUnitHeader::ovd(0, {});
+    static constexpr auto gvd = V3cUnitHeader::gvd(0, {});
+
+    const auto data = std::array{V3cUnit{vps, V3cParameterSet{}},
+                                 V3cUnit{ovd, VideoSubBitstream{"12345"s}},
+                                 V3cUnit{ovd, VideoSubBitstream{"67890"s}},
+                                 V3cUnit{gvd, VideoSubBitstream{"abcde"s}}};
+    auto unit = V3cUnitBuffer{sourceFromIteratorPair(data.cbegin(), data.cend()), onVps, 8};
+
+    REQUIRE(unit(vps));
+
+    SECTION("Reading in bitstream order stays within the bound") {
+      REQUIRE(unit(ovd));
+      CHECK(unit.bufferedBytes() == 0);
+      REQUIRE(unit(ovd));
+      REQUIRE(unit(gvd));
+      CHECK(unit.bufferedBytes() == 0);
+    }
+
+    SECTION("Reading past too many units fails") {
+      REQUIRE_THROWS_WITH(unit(gvd), Contains("would exceed the limit of 8 bytes"));
+    }
+  }
 }
 
 TEST_CASE("TMIV::Decoder::videoSubBitstreamSource") {
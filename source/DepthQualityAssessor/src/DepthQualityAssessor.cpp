@@ -77,24 +77,28 @@ auto isLowQuality(float blendingFactor, float maxOutlierRatio,
   const auto &secondUnprojection = sourceUnprojectionList[secondId];
   std::atomic<size_t> outliers = 0U;
 
-  Common::parallel_for(
-      secondUnprojection.width(), secondUnprojection.height(), [&](size_t y, size_t x) {
-        const auto &P = secondUnprojection(y, x);
-
-        if (!std::isnan(P.x())) {
-          auto p = firstHelper.doProjection(P);
-
-          if (firstHelper.isValidDepth(p.second) && firstHelper.isStrictlyInsideViewport(p.first)) {
-            auto zOnFirst = textureNeighbourhood(firstDepth, p.first);
-
-            if (std::all_of(zOnFirst.begin(), zOnFirst.end(), [&](float z) {
-                  return (!std::isnan(z) && (p.second < z * (1.F - blendingFactor)));
-                })) {
-              outliers++;
-            }
+  Common::parallel_for(secondUnprojection.height(), [&](size_t y) {
+    const auto row = Renderer::PointCloud(secondUnprojection.row_begin(y),
+                                          secondUnprojection.row_end(y));
+    auto p = Renderer::ImagePointBatch{};
+    firstHelper.doProjection(row, p);
+
+    for (size_t x = 0; x < row.size(); ++x) {
+      if (!std::isnan(row[x].x())) {
+        const auto uv = Common::Vec2f{p.u[x], p.v[x]};
+
+        if (firstHelper.isValidDepth(p.depth[x]) && firstHelper.isStrictlyInsideViewport(uv)) {
+          auto zOnFirst = textureNeighbourhood(firstDepth, uv);
+
+          if (std::all_of(zOnFirst.begin(), zOnFirst.end(), [&](float z) {
+                return (!std::isnan(z) && (p.depth[x] < z * (1.F - blendingFactor)));
+              })) {
+            outliers++;
           }
         }
-      });
+      }
+    }
+  });
 
   float outlierRatio = static_cast<float>(outliers) /
                        static_cast<float>(secondUnprojection.width() * secondUnprojection.height());
@@ -136,16 +140,25 @@ auto isLowDepthQuality(const MivBitstream::ViewParamsList &vpl,
     Common::Mat<Common::Vec3f> sourceUnprojection(
         {sourceDepthExpanded.height(), sourceDepthExpanded.width()});
 
-    Common::parallel_for(
-        sourceUnprojection.width(), sourceUnprojection.height(), [&](size_t y, size_t x) {
-          float z = sourceDepthExpanded(y, x);
-          if (sourceHelper.isValidDepth(z)) {
-            sourceUnprojection(y, x) = sourceHelper.doUnprojection(
-                Common::Vec2f({static_cast<float>(x) + 0.5F, static_cast<float>(y) + 0.5F}), z);
-          } else {
-            sourceUnprojection(y, x) = Common::Vec3f{NAN, NAN, NAN};
-          }
-        });
+    Common::parallel_for(sourceUnprojection.height(), [&](size_t y) {
+      auto imagePoints = Renderer::ImagePointBatch{};
+      imagePoints.resize(sourceUnprojection.width());
+
+      for (size_t x = 0; x < sourceUnprojection.width(); ++x) {
+        imagePoints.u[x] = static_cast<float>(x) + 0.5F;
+        imagePoints.v[x] = static_cast<float>(y) + 0.5F;
+        imagePoints.depth[x] = sourceDepthExpanded(y, x);
+      }
+
+      auto row = Renderer::PointCloud{};
+      sourceHelper.doUnprojection(imagePoints, row);
+
+      for (size_t x = 0; x < sourceUnprojection.width(); ++x) {
+        sourceUnprojection(y, x) = sourceHelper.isValidDepth(imagePoints.depth[x])
+                                       ? row[x]
+                                       : Common::Vec3f{NAN, NAN, NAN};
+      }
+    });
 
     sourceDepthExpandedList.emplace_back(std::move(sourceDepthExpanded));
     sourceUnprojectionList.emplace_back(std::move(sourceUnprojection));
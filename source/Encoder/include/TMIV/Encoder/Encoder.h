@@ -53,12 +53,19 @@ public:
 
   void prepareSequence(const MivBitstream::SequenceConfig &sequenceConfig,
                        const Common::DeepFrameList &firstFrame);
+  // The next access unit may be prepared and its frames pushed on one thread, while the previous
+  // access unit is completed and its atlases are popped on another thread. At most two access
+  // units can be in flight: all atlases of an access unit have to be popped before the access unit
+  // after the next one is prepared.
   void prepareAccessUnit();
   void pushFrame(Common::DeepFrameList sourceViews);
   auto completeAccessUnit() -> const EncoderParams &;
   auto popAtlas() -> Common::V3cFrameList;
   [[nodiscard]] auto maxLumaSamplesPerFrame() const -> size_t;
 
+  // Peak memory of the buffered transport views of an intra period
+  [[nodiscard]] auto peakFrameBufferBytes() const -> size_t;
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -54,7 +54,7 @@ public:
   auto popAtlas() -> Common::V3cFrameList;
   [[nodiscard]] auto maxLumaSamplesPerFrame() const -> size_t { return m_maxLumaSamplesPerFrame; }
 
-  using MpiPcsFrameReader = std::function<MpiPcs::Frame(int32_t)>;
+  using MpiPcsFrameReader = std::function<MpiPcs::CompactFrame(int32_t)>;
 
   void setMpiPcsFrameReader(const MpiPcsFrameReader &mpiPcsFrameReader) {
     m_mpiPcsFrameReader = mpiPcsFrameReader;
@@ -66,7 +66,9 @@ private:
   void prepareIvau();
   [[nodiscard]] auto log2FocLsbMinus4() const -> uint8_t;
 
-  auto readFrame(int32_t frameIdx) -> MpiPcs::Frame { return m_mpiPcsFrameReader(frameIdx); }
+  auto readFrame(int32_t frameIdx) -> MpiPcs::CompactFrame {
+    return m_mpiPcsFrameReader(frameIdx);
+  }
 
   Common::Json m_rootNode;
   MpiPcsFrameReader m_mpiPcsFrameReader;
@@ -82,7 +84,7 @@ private:
   uint32_t m_transparencyDynamic{};
 
   // Attributes
-  std::deque<MpiPcs::Frame> m_mpiFrameBuffer;
+  std::deque<MpiPcs::CompactFrame> m_mpiFrameBuffer;
   Common::FrameList<Common::PatchIdx> m_blockToPatchMapPerAtlas;
   std::unique_ptr<Packer::IPacker> m_packer;
   int32_t m_blockSize{};
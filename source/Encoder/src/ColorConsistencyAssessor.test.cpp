@@ -34,9 +34,12 @@
 #include "EncoderImpl.h"
 
 #include <TMIV/Common/Frame.h>
+#include <TMIV/Common/Thread.h>
 #include <TMIV/Renderer/Rasterizer.h>
 #include <catch2/catch.hpp>
 
+#include <utility>
+
 namespace TMIV::Encoder {
 auto calculateAvgColorDifference(Common::Mat<Common::Vec3i> colorCorrectionMap) -> Common::Vec3i {
   Common::Vec3i avg({0, 0, 0});
@@ -123,4 +126,110 @@ SCENARIO("Color consistency assessment") {
     }
   }
 }
+
+TEST_CASE("Color consistency assessment of a mixed perspective and equirectangular rig") {
+  const int32_t W = 32;
+  const int32_t H = 16;
+
+  const auto makeView = [](MivBitstream::CiCamType camType, bool isBasicView, float focal) {
+    auto vp = MivBitstream::ViewParams{};
+    vp.pose.orientation = Common::neutralOrientationF;
+    vp.isBasicView = isBasicView;
+    vp.ci.ci_cam_type(camType);
+    vp.ci.ci_projection_plane_height_minus1(H - 1);
+    vp.ci.ci_projection_plane_width_minus1(W - 1);
+
+    if (camType == MivBitstream::CiCamType::perspective) {
+      vp.ci.ci_perspective_center_hor(static_cast<float>(W) / 2.0F);
+      vp.ci.ci_perspective_center_ver(static_cast<float>(H) / 2.0F);
+      vp.ci.ci_perspective_focal_hor(focal);
+      vp.ci.ci_perspective_focal_ver(focal);
+    } else {
+      vp.ci.ci_erp_phi_min(-180.F);
+      vp.ci.ci_erp_phi_max(180.F);
+      vp.ci.ci_erp_theta_min(-90.F);
+      vp.ci.ci_erp_theta_max(90.F);
+    }
+    vp.dq.dq_norm_disp_high(100.0F);
+    vp.dq.dq_norm_disp_low(1.0F);
+    return vp;
+  };
+
+  const auto makeFrame = [](int32_t lumaGradient) {
+    auto view = Common::DeepFrame{};
+    view.texture.createYuv420({W, H}, 10);
+    view.geometry.createY({W, H}, 16);
+    view.texture.fillNeutral();
+    view.geometry.fillOne();
+
+    for (int32_t h = 0; h < H; h++) {
+      for (int32_t w = 0; w < W; w++) {
+        view.texture.getPlane(0)(h, w) += static_cast<uint16_t>(w * lumaGradient);
+      }
+    }
+    return view;
+  };
+
+  const auto makeList = [](const std::vector<MivBitstream::ViewParams> &list) {
+    auto result = MivBitstream::ViewParamsList{};
+    result.assign(list.cbegin(), list.cend());
+
+    for (size_t i = 0; i < result.size(); ++i) {
+      result[i].viewId = MivBitstream::ViewId{static_cast<uint16_t>(i)};
+    }
+    result.constructViewIdIndex();
+    return result;
+  };
+
+  // View 1 is the reference view. The zoomed-in target view stretches the triangles such that
+  // they are only just discarded. The equirectangular target view precedes it in the first order
+  // and follows it in the second order.
+  const auto perspective = makeView(MivBitstream::CiCamType::perspective, false, 8.F);
+  const auto reference = makeView(MivBitstream::CiCamType::perspective, true, 8.F);
+  const auto equirectangular = makeView(MivBitstream::CiCamType::equirectangular, false, 0.F);
+  const auto zoomed = makeView(MivBitstream::CiCamType::perspective, false, 2.3F * 8.F);
+
+  const auto params = makeList({perspective, reference, equirectangular, zoomed});
+  const auto views = Common::DeepFrameList{makeFrame(0), makeFrame(1), makeFrame(0), makeFrame(0)};
+
+  const auto swappedParams = makeList({perspective, reference, zoomed, equirectangular});
+  const auto swappedViews = Common::DeepFrameList{views[0], views[1], views[3], views[2]};
+
+  const auto assessWithThreadCount = [](unsigned count, const Common::DeepFrameList &views_,
+                                        const MivBitstream::ViewParamsList &params_) {
+    const auto defaultCount = std::exchange(Common::threadCount(), count);
+    auto result = assessColorConsistency(views_, params_);
+    Common::threadCount() = defaultCount;
+    return result;
+  };
+
+  const auto same = [](const Common::Mat<Common::Vec3i> &a, const Common::Mat<Common::Vec3i> &b) {
+    return a.sizes() == b.sizes() && std::equal(a.cbegin(), a.cend(), b.cbegin());
+  };
+
+  const auto serial = assessWithThreadCount(1, views, params);
+  REQUIRE(serial.size() == 4);
+
+  SECTION("Some colors of the perspective target view are corrected") {
+    REQUIRE(std::any_of(serial[0].cbegin(), serial[0].cend(),
+                        [](const Common::Vec3i &x) { return x.x() != 0; }));
+  }
+
+  SECTION("Concurrent assessment gives the same result as serial assessment") {
+    const auto concurrent = assessWithThreadCount(4, views, params);
+    REQUIRE(concurrent.size() == 4);
+
+    for (size_t i = 0; i < 4; ++i) {
+      REQUIRE(same(concurrent[i], serial[i]));
+    }
+  }
+
+  SECTION("The triangle weights of a target view do not carry over to the next target view") {
+    const auto swapped = assessWithThreadCount(1, swappedViews, swappedParams);
+    REQUIRE(swapped.size() == 4);
+    REQUIRE(same(swapped[0], serial[0]));
+    REQUIRE(same(swapped[2], serial[3]));
+    REQUIRE(same(swapped[3], serial[2]));
+  }
+}
 } // namespace TMIV::Encoder
@@ -136,6 +136,10 @@ void Configuration::queryMainParameters(const Common::Json &componentNode) {
     entityEncRange = componentNode.require("entityEncodeRange").asVec<Common::SampleValue, 2>();
   }
 
+  if (const auto &node = componentNode.optional("frameBufferMemoryLimit")) {
+    frameBufferMemoryLimit = node.as<size_t>() << 20;
+  }
+
   if (const auto &node = componentNode.optional("depthLowQualityFlag")) {
     depthLowQualityFlag = node.as<bool>();
   }
@@ -79,6 +79,7 @@ struct Configuration {
   uint8_t numGroups;
   uint16_t maxEntityId;
   bool halveDepthRange;
+  std::optional<size_t> frameBufferMemoryLimit; // streaming mode [bytes]
 
   // SEI-related parameters
   bool viewportCameraParametersSei;
@@ -54,4 +54,6 @@ auto Encoder::completeAccessUnit() -> const EncoderParams & { return m_impl->com
 auto Encoder::popAtlas() -> Common::V3cFrameList { return m_impl->popAtlas(); }
 
 auto Encoder::maxLumaSamplesPerFrame() const -> size_t { return m_impl->maxLumaSamplesPerFrame(); }
+
+auto Encoder::peakFrameBufferBytes() const -> size_t { return m_impl->peakFrameBufferBytes(); }
 } // namespace TMIV::Encoder
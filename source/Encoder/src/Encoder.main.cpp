@@ -40,7 +40,9 @@
 #include <TMIV/Encoder/V3cSampleSink.h>
 #include <TMIV/IO/IO.h>
 
+#include <chrono>
 #include <fstream>
+#include <future>
 
 using namespace std::string_view_literals;
 
@@ -62,6 +64,42 @@ private:
   std::ofstream m_outputBitstream;
   Common::Sink<EncoderParams> m_sink;
 
+  // The next input frame is loaded while the current frame is encoded. The frames of an inter
+  // period are pushed while the previous inter period is completed and its atlas frames are
+  // popped in the background. Atlas frames are written while the next ones are constructed.
+  // Access units, the bitstream and writes are all in frame order.
+  std::future<Common::DeepFrameList> m_nextFrame;
+  std::future<void> m_pendingCompletion;
+  std::future<void> m_pendingWrite;
+
+  // Accumulated wall-clock time per stage in seconds
+  struct StageTimes {
+    double load{};
+    double loadWait{};
+    double push{};
+    double complete{};
+    double completeWait{};
+    double sink{};
+    double pop{};
+    double save{};
+    double saveWait{};
+  } m_stageTimes;
+
+  template <typename F> static auto timed(double &total, F &&f) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto stop = [&total, start]() {
+      total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    if constexpr (std::is_void_v<decltype(f())>) {
+      f();
+      stop();
+    } else {
+      auto result = f();
+      stop();
+      return result;
+    }
+  }
+
   [[nodiscard]] auto placeholders() const {
     auto x = IO::Placeholders{};
     x.contentId = m_contentId;
@@ -121,8 +159,11 @@ public:
       encodeInterPeriod(i, lastFrame);
     }
 
+    timed(m_stageTimes.completeWait, [this]() { waitForPendingCompletion(); });
+    timed(m_stageTimes.saveWait, [this]() { waitForPendingWrite(); });
     m_sink(std::nullopt);
     reportSummary(m_outputBitstream.tellp());
+    reportStageTimes();
   }
 
 private:
@@ -130,29 +171,84 @@ private:
     Common::logInfo("Inter period: [{}, {})", firstFrame, lastFrame);
     m_encoder.prepareAccessUnit();
     pushFrames(firstFrame, lastFrame);
-    m_sink(m_encoder.completeAccessUnit());
+
+    // The encoder accepts at most two access units in flight
+    timed(m_stageTimes.completeWait, [this]() { waitForPendingCompletion(); });
+    m_pendingCompletion = std::async(std::launch::async, [this, firstFrame, lastFrame]() {
+      completeInterPeriod(firstFrame, lastFrame);
+    });
+  }
+
+  void completeInterPeriod(int32_t firstFrame, int32_t lastFrame) {
+    auto params = timed(m_stageTimes.complete, [this]() { return m_encoder.completeAccessUnit(); });
+    timed(m_stageTimes.sink, [this, &params]() { m_sink(std::move(params)); });
     popAtlases(firstFrame, lastFrame);
   }
 
+  // Rethrows any exception of the completion
+  void waitForPendingCompletion() {
+    if (m_pendingCompletion.valid()) {
+      m_pendingCompletion.get();
+    }
+  }
+
   void pushFrames(int32_t firstFrame, int32_t lastFrame) {
     for (int32_t i = firstFrame; i < lastFrame; ++i) {
-      m_encoder.pushFrame(IO::loadMultiviewFrame(json(), placeholders(), m_inputSequenceConfig, i));
+      auto frame = timed(m_stageTimes.loadWait, [this, i]() { return takeFrame(i); });
+
+      // Also crosses inter period boundaries, such that the first frame of the next period is
+      // loaded while the last frame of this period is pushed
+      if (i + 1 < m_numberOfInputFrames) {
+        m_nextFrame = std::async(std::launch::async, [this, i]() {
+          auto load = 0.;
+          auto result = timed(load, [this, i]() {
+            return IO::loadMultiviewFrame(json(), placeholders(), m_inputSequenceConfig, i + 1);
+          });
+          m_stageTimes.load += load;
+          return result;
+        });
+      }
+
+      timed(m_stageTimes.push, [this, &frame]() { m_encoder.pushFrame(std::move(frame)); });
     }
   }
 
+  auto takeFrame(int32_t frameIdx) -> Common::DeepFrameList {
+    if (m_nextFrame.valid()) {
+      return m_nextFrame.get();
+    }
+    return timed(m_stageTimes.load, [this, frameIdx]() {
+      return IO::loadMultiviewFrame(json(), placeholders(), m_inputSequenceConfig, frameIdx);
+    });
+  }
+
   void popAtlases(int32_t firstFrame, int32_t lastFrame) {
     for (int32_t frameIdx = firstFrame; frameIdx < lastFrame; ++frameIdx) {
-      const auto frame = m_encoder.popAtlas();
+      auto frame = timed(m_stageTimes.pop, [this]() { return m_encoder.popAtlas(); });
 
-      auto metadata = Common::Json::Array{};
+      timed(m_stageTimes.saveWait, [this]() { waitForPendingWrite(); });
+      m_pendingWrite = std::async(std::launch::async, [this, frameIdx, frame = std::move(frame)]() {
+        timed(m_stageTimes.save, [this, frameIdx, &frame]() { saveAtlasFrames(frameIdx, frame); });
+      });
+    }
+  }
 
-      for (size_t atlasIdx = 0; atlasIdx < frame.size(); ++atlasIdx) {
-        const auto sub = saveAtlasFrame(MivBitstream::AtlasId{atlasIdx}, frameIdx, frame[atlasIdx]);
-        metadata.insert(metadata.end(), sub.cbegin(), sub.cend());
-      }
-      if (frameIdx == 0) {
-        IO::saveOutOfBandMetadata(json(), placeholders(), metadata);
-      }
+  // Rethrows any exception of the write
+  void waitForPendingWrite() {
+    if (m_pendingWrite.valid()) {
+      m_pendingWrite.get();
+    }
+  }
+
+  void saveAtlasFrames(int32_t frameIdx, const Common::V3cFrameList &frame) {
+    auto metadata = Common::Json::Array{};
+
+    for (size_t atlasIdx = 0; atlasIdx < frame.size(); ++atlasIdx) {
+      const auto sub = saveAtlasFrame(MivBitstream::AtlasId{atlasIdx}, frameIdx, frame[atlasIdx]);
+      metadata.insert(metadata.end(), sub.cbegin(), sub.cend());
+    }
+    if (frameIdx == 0) {
+      IO::saveOutOfBandMetadata(json(), placeholders(), metadata);
     }
   }
 
@@ -187,6 +283,7 @@ private:
 
   void reportSummary(std::streampos bytesWritten) const {
     Common::logInfo("Maximum luma samples per frame is {}", m_encoder.maxLumaSamplesPerFrame());
+    Common::logInfo("Peak frame buffer memory is {} MiB", m_encoder.peakFrameBufferBytes() >> 20);
     Common::logInfo("Total size is {} B ({} kb)", bytesWritten,
                     8e-3 * static_cast<double>(bytesWritten));
     Common::logInfo("Frame count is {}", m_numberOfInputFrames);
@@ -195,6 +292,20 @@ private:
                                                     m_inputSequenceConfig.frameRate /
                                                     m_numberOfInputFrames);
   }
+
+  // Background stages (load, complete and save) overlap with the other stages. The wait times are
+  // how long the thread that depends on them was blocked.
+  void reportStageTimes() const {
+    Common::logInfo("Stage time: load frames {:.3f} s (waited {:.3f} s)", m_stageTimes.load,
+                    m_stageTimes.loadWait);
+    Common::logInfo("Stage time: push frames {:.3f} s", m_stageTimes.push);
+    Common::logInfo("Stage time: complete access units {:.3f} s (waited {:.3f} s)",
+                    m_stageTimes.complete, m_stageTimes.completeWait);
+    Common::logInfo("Stage time: write bitstream {:.3f} s", m_stageTimes.sink);
+    Common::logInfo("Stage time: pop atlases {:.3f} s", m_stageTimes.pop);
+    Common::logInfo("Stage time: save atlases {:.3f} s (waited {:.3f} s)", m_stageTimes.save,
+                    m_stageTimes.saveWait);
+  }
 };
 } // namespace TMIV::Encoder
 
@@ -0,0 +1,271 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Encoder/Encoder.h>
+
+#include <TMIV/Aggregator/Aggregator.h>
+#include <TMIV/Common/Factory.h>
+#include <TMIV/DepthQualityAssessor/DepthQualityAssessor.h>
+#include <TMIV/Packer/Packer.h>
+#include <TMIV/Pruner/NoPruner.h>
+#include <TMIV/ViewOptimizer/NoViewOptimizer.h>
+
+#include <future>
+
+using namespace std::string_view_literals;
+
+namespace test {
+using TMIV::Common::Json;
+
+void registerComponents() {
+  using TMIV::Common::Factory;
+
+  Factory<TMIV::Aggregator::IAggregator>::getInstance().registerAs<TMIV::Aggregator::Aggregator>(
+      "Aggregator");
+  Factory<TMIV::DepthQualityAssessor::IDepthQualityAssessor>::getInstance()
+      .registerAs<TMIV::DepthQualityAssessor::DepthQualityAssessor>("DepthQualityAssessor");
+  Factory<TMIV::Packer::IPacker>::getInstance().registerAs<TMIV::Packer::Packer>("Packer");
+  Factory<TMIV::Pruner::IPruner>::getInstance().registerAs<TMIV::Pruner::NoPruner>("NoPruner");
+  Factory<TMIV::ViewOptimizer::IViewOptimizer>::getInstance()
+      .registerAs<TMIV::ViewOptimizer::NoViewOptimizer>("NoViewOptimizer");
+}
+
+auto componentNode(bool memoryLimit) {
+  auto node = Json::parse(R"({
+    "Aggregator": {},
+    "AggregatorMethod": "Aggregator",
+    "DepthQualityAssessor": {
+        "blendingFactor": 0.03,
+        "maxOutlierRatio": 0.001
+    },
+    "DepthQualityAssessorMethod": "DepthQualityAssessor",
+    "NoPruner": {},
+    "NoViewOptimizer": {},
+    "Packer": {
+        "enableMerging": true,
+        "enablePatchInPatch": true,
+        "enableRecursiveSplit": true,
+        "minPatchSize": 16,
+        "overlap": 1,
+        "sortingMethod": 0
+    },
+    "PackerMethod": "Packer",
+    "PrunerMethod": "NoPruner",
+    "ViewOptimizerMethod": "NoViewOptimizer",
+    "bitDepthGeometryVideo": 10,
+    "bitDepthTextureVideo": 10,
+    "blockSizeDepthQualityDependent": [16, 32],
+    "codecGroupIdc": "HEVC Main10",
+    "colorCorrectionEnabledFlag": true,
+    "depthLowQualityFlag": true,
+    "depthOccThresholdIfSet": 0.0625,
+    "dynamicDepthRange": true,
+    "embeddedOccupancy": true,
+    "framePacking": false,
+    "geometryScaleEnabledFlag": true,
+    "halveDepthRange": true,
+    "haveGeometryVideo": true,
+    "haveOccupancyVideo": false,
+    "haveTextureVideo": true,
+    "intraPeriod": 4,
+    "levelIdc": "2.5",
+    "m57419_edgeThreshold": 40,
+    "m57419_intervalNumber": 16,
+    "m57419_piecewiseDepthLinearScaling": false,
+    "maxEntityId": 0,
+    "nonAggregatedMaskDilationIter": 2,
+    "numGroups": 1,
+    "oneV3cFrameOnly": false,
+    "oneViewPerAtlasFlag": true,
+    "patchRedundancyRemoval": true,
+    "reconstructionIdc": "Rec Unconstrained",
+    "rewriteParameterSets": false,
+    "textureOffsetEnabledFlag": false,
+    "toolsetIdc": "MIV Main",
+    "viewportCameraParametersSei": false,
+    "viewportPositionSei": false
+})"sv);
+
+  if (memoryLimit) {
+    node.update(Json::parse(R"({ "frameBufferMemoryLimit": 1 })"sv));
+  }
+  return node;
+}
+
+const auto sequenceConfig = TMIV::MivBitstream::SequenceConfig{Json::parse(R"({
+    "Version": "4.0",
+    "BoundingBox_center": [0, 0, 0],
+    "Content_name": "Test",
+    "Fps": 30,
+    "Frames_number": 6,
+    "lengthsInMeters": true,
+    "cameras": [ {
+        "BitDepthColor": 10,
+        "BitDepthDepth": 16,
+        "ColorSpace": "YUV420",
+        "DepthColorSpace": "YUV420",
+        "Depth_range": [1, 10],
+        "Focal": [32, 32],
+        "HasInvalidDepth": false,
+        "Name": "v0",
+        "Position": [0, -0.05, 0],
+        "Principle_point": [32, 16],
+        "Projection": "Perspective",
+        "Resolution": [64, 32],
+        "Rotation": [0, 0, 0]
+    }, {
+        "BitDepthColor": 10,
+        "BitDepthDepth": 16,
+        "ColorSpace": "YUV420",
+        "DepthColorSpace": "YUV420",
+        "Depth_range": [1, 10],
+        "Focal": [32, 32],
+        "HasInvalidDepth": false,
+        "Name": "v1",
+        "Position": [0, 0.05, 0],
+        "Principle_point": [32, 16],
+        "Projection": "Perspective",
+        "Resolution": [64, 32],
+        "Rotation": [0, 0, 0]
+    } ]
+})"sv)};
+
+// Source views with content that differs between views and frames
+auto sourceFrame(int32_t frameIdx) {
+  auto frame = TMIV::Common::DeepFrameList(2);
+
+  for (int32_t v = 0; v < 2; ++v) {
+    auto &view = frame[v];
+    view.texture = TMIV::Common::Frame<>::yuv420({64, 32}, 10);
+    view.geometry = TMIV::Common::Frame<>::lumaOnly({64, 32}, 16);
+
+    for (int32_t d = 0; d < 3; ++d) {
+      auto &plane = view.texture.getPlane(d);
+
+      for (size_t i = 0; i < plane.height(); ++i) {
+        for (size_t j = 0; j < plane.width(); ++j) {
+          plane(i, j) = static_cast<uint16_t>((7 * i + 3 * j + 11 * frameIdx + 5 * v + d) % 1024);
+        }
+      }
+    }
+
+    auto &plane = view.geometry.getPlane(0);
+
+    for (size_t i = 0; i < plane.height(); ++i) {
+      for (size_t j = 0; j < plane.width(); ++j) {
+        plane(i, j) = static_cast<uint16_t>(30000 + 100 * ((i + j + frameIdx) % 16));
+      }
+    }
+  }
+  return frame;
+}
+
+struct InterPeriod {
+  TMIV::Encoder::EncoderParams params;
+  std::vector<TMIV::Common::V3cFrameList> atlases;
+};
+
+// Encode inter periods of two frames, optionally completing each inter period while the frames of
+// the next one are pushed, like the encoder application does
+auto encode(const Json &componentNode, bool overlap) {
+  auto encoder = TMIV::Encoder::Encoder{componentNode};
+  encoder.prepareSequence(sequenceConfig, sourceFrame(0));
+
+  auto result = std::vector<InterPeriod>(3);
+  auto pendingCompletion = std::future<void>{};
+
+  for (size_t k = 0; k < result.size(); ++k) {
+    encoder.prepareAccessUnit();
+
+    for (int32_t i = 0; i < 2; ++i) {
+      encoder.pushFrame(sourceFrame(static_cast<int32_t>(2 * k) + i));
+    }
+
+    auto complete = [&encoder, &interPeriod = result[k]]() {
+      interPeriod.params = encoder.completeAccessUnit();
+
+      for (int32_t i = 0; i < 2; ++i) {
+        interPeriod.atlases.push_back(encoder.popAtlas());
+      }
+    };
+
+    if (pendingCompletion.valid()) {
+      pendingCompletion.get();
+    }
+    if (overlap) {
+      pendingCompletion = std::async(std::launch::async, complete);
+    } else {
+      complete();
+    }
+  }
+  if (pendingCompletion.valid()) {
+    pendingCompletion.get();
+  }
+  return result;
+}
+
+auto sameAtlases(const TMIV::Common::V3cFrameList &a, const TMIV::Common::V3cFrameList &b) {
+  return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), [](const auto &x, const auto &y) {
+    return x.texture.getPlanes() == y.texture.getPlanes() &&
+           x.geometry.getPlanes() == y.geometry.getPlanes() &&
+           x.occupancy.getPlanes() == y.occupancy.getPlanes();
+  });
+}
+} // namespace test
+
+TEST_CASE("Overlapped encoding of inter periods gives the same output as serial encoding") {
+  test::registerComponents();
+
+  const auto memoryLimit = GENERATE(false, true);
+  const auto componentNode = test::componentNode(memoryLimit);
+
+  const auto serial = test::encode(componentNode, false);
+  const auto overlapped = test::encode(componentNode, true);
+
+  REQUIRE(serial.size() == overlapped.size());
+
+  for (size_t k = 0; k < serial.size(); ++k) {
+    CAPTURE(memoryLimit, k);
+    REQUIRE(serial[k].params.foc == overlapped[k].params.foc);
+    REQUIRE(serial[k].params.patchParamsList == overlapped[k].params.patchParamsList);
+    REQUIRE(serial[k].params.atlas.size() == overlapped[k].params.atlas.size());
+    REQUIRE(serial[k].atlases.size() == 2);
+    REQUIRE(overlapped[k].atlases.size() == 2);
+
+    for (size_t i = 0; i < 2; ++i) {
+      REQUIRE(test::sameAtlases(serial[k].atlases[i], overlapped[k].atlases[i]));
+    }
+  }
+}
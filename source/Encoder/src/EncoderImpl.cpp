@@ -41,14 +41,37 @@ using TMIV::Pruner::IPruner;
 using TMIV::ViewOptimizer::IViewOptimizer;
 
 namespace TMIV::Encoder {
+namespace {
+// The memory limit is shared by the access unit that is pushed and the one that is completed
+auto accessUnitMemoryLimit(const Configuration &config) -> std::optional<size_t> {
+  if (config.frameBufferMemoryLimit) {
+    return *config.frameBufferMemoryLimit / 2;
+  }
+  return std::nullopt;
+}
+} // namespace
+
 Encoder::Impl::Impl(const Common::Json &componentNode)
     : m_depthQualityAssessor{Common::create<DepthQualityAssessor::IDepthQualityAssessor>(
           "DepthQualityAssessor", componentNode, componentNode)}
     , m_viewOptimizer{Common::create<IViewOptimizer>("ViewOptimizer", componentNode, componentNode)}
     , m_pruner{Common::create<Pruner::IPruner>("Pruner", componentNode, componentNode)}
-    , m_aggregator{Common::create<IAggregator>("Aggregator", componentNode, componentNode)}
     , m_packer{Common::create<IPacker>("Packer", componentNode, componentNode)}
-    , m_config(componentNode) {}
+    , m_config(componentNode)
+    , m_frameBufferBytes{std::make_shared<ResidentBytes>()}
+    , m_accessUnits{{{Common::create<IAggregator>("Aggregator", componentNode, componentNode),
+                      accessUnitMemoryLimit(m_config), m_frameBufferBytes},
+                     {Common::create<IAggregator>("Aggregator", componentNode, componentNode),
+                      accessUnitMemoryLimit(m_config), m_frameBufferBytes}}} {}
+
+Encoder::Impl::AccessUnit::AccessUnit(std::unique_ptr<Aggregator::IAggregator> aggregator_,
+                                      std::optional<size_t> memoryLimit,
+                                      std::shared_ptr<ResidentBytes> frameBufferBytes)
+    : aggregator{std::move(aggregator_)}
+    , transportViews{memoryLimit, std::move(frameBufferBytes)} {}
 
 auto Encoder::Impl::maxLumaSamplesPerFrame() const -> size_t { return m_maxLumaSamplesPerFrame; }
+
+// The maximum number of bytes that were resident at the same time in both access units
+auto Encoder::Impl::peakFrameBufferBytes() const -> size_t { return m_frameBufferBytes->peak(); }
 } // namespace TMIV::Encoder
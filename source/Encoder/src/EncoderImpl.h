@@ -37,8 +37,10 @@
 #include "Configuration.h"
 #include "FramePacker.h"
 #include "SampleStats.h"
+#include "TransportViewBuffer.h"
 
 #include <TMIV/Aggregator/IAggregator.h>
+#include <TMIV/Common/BitMask.h>
 #include <TMIV/DepthQualityAssessor/IDepthQualityAssessor.h>
 #include <TMIV/Encoder/Encoder.h>
 #include <TMIV/Packer/IPacker.h>
@@ -46,9 +48,11 @@
 #include <TMIV/ViewOptimizer/IViewOptimizer.h>
 
 #include <algorithm>
-#include <bitset>
+#include <array>
 #include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
 
 namespace TMIV::Encoder {
 auto assessColorConsistency(Common::DeepFrameList views, MivBitstream::ViewParamsList params)
@@ -68,17 +72,23 @@ public:
   auto completeAccessUnit() -> const EncoderParams &;
   auto popAtlas() -> Common::V3cFrameList;
   [[nodiscard]] auto maxLumaSamplesPerFrame() const -> size_t;
+  [[nodiscard]] auto peakFrameBufferBytes() const -> size_t;
 
 private:
   [[nodiscard]] auto config() const noexcept -> const Configuration & { return m_config; }
 
+  // In streaming mode atlas frames are constructed when they are popped, unless the patch texture
+  // offsets require all frames of the intra period
+  [[nodiscard]] auto deferVideoFrames() const noexcept {
+    return m_config.frameBufferMemoryLimit.has_value() && !m_config.textureOffsetFlag;
+  }
+
   // Encoder_prepareAccessUnit.cpp
   void resetNonAggregatedMask();
 
   // Encoder_pushFrame.cpp
   void pushSingleEntityFrame(Common::DeepFrameList sourceViews);
-  void updateNonAggregatedMask(const Common::DeepFrameList &transportViews,
-                               const Common::FrameList<uint8_t> &masks);
+  void updateNonAggregatedMask(const Common::FrameList<uint8_t> &masks);
   void pushMultiEntityFrame(Common::DeepFrameList sourceViews);
   static auto entitySeparator(const Common::DeepFrameList &transportViews,
                               Common::SampleValue entityId) -> Common::DeepFrameList;
@@ -91,6 +101,11 @@ private:
   void scaleGeometryDynamicRange();
   void updateAggregationStatistics(const Common::FrameList<uint8_t> &aggregatedMask);
   void constructVideoFrames();
+  void constructNextVideoFrame();
+  [[nodiscard]] auto createAtlasFrames(const Common::DeepFrameList &views) const
+      -> Common::DeepFrameList;
+  void constructVideoFrame(const Common::DeepFrameList &views, Common::DeepFrameList &atlasList,
+                           int32_t frameIdx, PatchTextureStats &patchTextureStats);
   void correctColors();
   void encodePatchTextureOffset(const PatchTextureStats &stats);
   void applyPatchTextureOffset();
@@ -122,35 +137,69 @@ private:
                                                        bool lowDepthQuality) -> std::vector<double>;
 #endif
 
-  // Encoder sub-components
+  // Encoder sub-components. After prepareSequence(), the view optimizer and the pruner are only
+  // used by pushFrame(), and the packer only by completeAccessUnit().
   std::unique_ptr<DepthQualityAssessor::IDepthQualityAssessor> m_depthQualityAssessor;
   std::unique_ptr<ViewOptimizer::IViewOptimizer> m_viewOptimizer;
   std::unique_ptr<Pruner::IPruner> m_pruner;
-  std::unique_ptr<Aggregator::IAggregator> m_aggregator;
   std::unique_ptr<Packer::IPacker> m_packer;
   FramePacker m_framePacker;
 
   Configuration m_config;
 
   // View-optimized encoder input
+  //
+  // The members that are set by prepareSequence() and only read afterwards (m_config,
+  // m_transportParams, m_depthLowQualityFlag and m_blockSize) may be used by both threads. The
+  // push path does not use m_params, which is written by completeAccessUnit().
   ViewOptimizer::ViewOptimizerParams m_transportParams;
-  std::vector<Common::DeepFrameList> m_transportViews;
+  bool m_depthLowQualityFlag{};
+
+  // Mask aggregation state: the non-aggregated mask is indexed by view and then by frame
+  using NonAggregatedMask = std::vector<Common::BitMask>;
+
+  // The state of an access unit from prepareAccessUnit() until its last atlas has been popped
+  struct AccessUnit {
+    AccessUnit(std::unique_ptr<Aggregator::IAggregator> aggregator_,
+               std::optional<size_t> memoryLimit,
+               std::shared_ptr<ResidentBytes> frameBufferBytes);
+
+    std::unique_ptr<Aggregator::IAggregator> aggregator;
+    TransportViewBuffer transportViews;
+    std::vector<NonAggregatedMask> nonAggregatedMask;
+    std::vector<Common::FrameList<uint8_t>> aggregatedEntityMask;
+  };
+
+  // The frames of an access unit may be pushed while the previous access unit is completed and
+  // popped. The pushing and completing access units alternate between the two slots. Only
+  // prepareAccessUnit() and pushFrame() use m_pushing, and only completeAccessUnit() and
+  // popAtlas() use m_completing. There is no lock: the call order that is described in Encoder.h
+  // ensures that a slot is not prepared again while its access unit is still being completed. The
+  // transport view buffers of both slots report their resident bytes to m_frameBufferBytes.
+  std::shared_ptr<ResidentBytes> m_frameBufferBytes;
+  std::array<AccessUnit, 2> m_accessUnits;
+  AccessUnit *m_pushing{};
+  AccessUnit *m_completing{};
+  size_t m_preparedCount{};
+  size_t m_completedCount{};
 
   int32_t m_blockSize{};
+
+  // Only used by completeAccessUnit() and popAtlas() after prepareSequence()
   EncoderParams m_params;          // Encoder output prior to geometry quantization and scaling
   EncoderParams m_paramsQuantized; // Encoder output prior to geometry scaling
   std::deque<Common::DeepFrameList> m_videoFrameBuffer;
+  size_t m_constructedFrameCount{};
 
   // Mark read-only access to encoder params to make mutable access more visible
   [[nodiscard]] auto params() const noexcept -> const EncoderParams & { return m_params; }
 
-  // Mask aggregation state
-  using NonAggregatedMask = Common::Mat<std::bitset<maxIntraPeriod>>;
-  std::vector<NonAggregatedMask> m_nonAggregatedMask;
-  std::vector<Common::FrameList<uint8_t>> m_aggregatedEntityMask;
   size_t m_maxLumaSamplesPerFrame{};
 
-  std::vector<std::vector<Common::Mat<Common::Vec3i>>> m_colorCorrectionMaps;
+  // Color correction maps are appended by pushFrame() while completeAccessUnit() may read them.
+  // References to the elements of a deque remain valid when elements are appended.
+  std::deque<std::vector<Common::Mat<Common::Vec3i>>> m_colorCorrectionMaps;
+  mutable std::mutex m_colorCorrectionMutex;
   std::vector<Common::Vec3i> m_patchColorCorrectionOffset;
 };
 } // namespace TMIV::Encoder
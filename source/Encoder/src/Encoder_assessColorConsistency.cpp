@@ -33,12 +33,15 @@
 
 #include "../src/IncrementalSynthesizer.h"
 #include "../src/PrunedMesh.h"
+#include <TMIV/Common/LoggingStrategyFmt.h>
 #include <TMIV/Common/Thread.h>
 #include <TMIV/Encoder/Encoder.h>
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
 #include <TMIV/Renderer/Rasterizer.h>
 #include <TMIV/Renderer/reprojectPoints.h>
 
+#include <chrono>
+
 namespace TMIV::Encoder {
 auto findCentralBasicView(MivBitstream::ViewParamsList paramsList) -> size_t {
   PRECONDITION(!paramsList.empty());
@@ -85,26 +88,13 @@ auto findCentralBasicView(MivBitstream::ViewParamsList paramsList) -> size_t {
 
 auto assessColorConsistency(Common::DeepFrameList views, MivBitstream::ViewParamsList params)
     -> std::vector<Common::Mat<Common::Vec3i>> {
-  std::vector<Common::Mat<Common::Vec3i>> colorCorrectionMaps1Frame;
+  const auto startTime = std::chrono::steady_clock::now();
 
   float m_maxDepthError = 0.1F;
   float m_maxLumaError = 0.04F;
   const Renderer::AccumulatingPixel<Common::Vec3f> tmpConfig{10.0, -100.0, 3.0, 5.0};
   const auto refViewIdx = findCentralBasicView(params);
 
-  std::vector<std::unique_ptr<TMIV::Pruner::IncrementalSynthesizer>> synthesizers;
-  synthesizers.clear();
-
-  for (size_t i = 0; i < params.size(); ++i) {
-    const auto geoBitDepth = views[i].geometry.getBitDepth();
-    const auto depthTransform = MivBitstream::DepthTransform{params[i].dq, geoBitDepth};
-
-    synthesizers.emplace_back(std::make_unique<TMIV::Pruner::IncrementalSynthesizer>(
-        tmpConfig, params[i].ci.projectionPlaneSize(), i,
-        depthTransform.expandDepth(views[i].geometry), expandLuma(views[i].texture),
-        expandTexture(yuv444(views[i].texture))));
-  }
-
   Common::FrameList<uint8_t> masks;
   masks.clear();
   masks.reserve(views.size());
@@ -125,65 +115,84 @@ auto assessColorConsistency(Common::DeepFrameList views, MivBitstream::ViewParam
                    return mask;
                  });
 
-  auto refView = views[refViewIdx];
+  const auto &refView = views[refViewIdx];
 
-  auto [ivertices, triangles, attributes] =
+  const auto [ivertices, triangles, attributes] =
       Pruner::unprojectPrunedView(refView, params[refViewIdx], masks[refViewIdx].getPlane(0));
 
   int32_t W = refView.texture.getWidth();
   int32_t H = refView.texture.getHeight();
   const auto maxValueF = static_cast<float>(refView.texture.maxValue());
 
-  for (auto &s : synthesizers) {
-    Common::Mat<Common::Vec3i> currentCCMap;
+  // The target views are processed concurrently. Each task creates its own synthesizer, such that
+  // the memory use is bounded by the number of concurrent tasks instead of by the number of views.
+  std::vector<Common::Mat<Common::Vec3i>> colorCorrectionMaps1Frame(params.size());
+
+  Common::parallel_for(params.size(), [&, &ivertices = ivertices, &triangles = triangles,
+                                       &attributes = attributes](size_t i) {
+    auto &currentCCMap = colorCorrectionMaps1Frame[i];
     currentCCMap.resize(H, W);
 
-    if (s->index != refViewIdx) {
-      auto overtices = Pruner::project(ivertices, params[refViewIdx], params[s->index]);
-      Pruner::weightedSphere(params[s->index].ci, overtices, triangles);
-      s->rasterizer.submit(overtices, attributes, triangles);
-      s->rasterizer.run();
-
-      auto j = std::begin(s->reference);
-      auto jY = std::begin(s->referenceY);
-      auto jYUV = std::begin(s->referenceYUV);
-
-      int32_t pp = 0;
-
-      s->rasterizer.visit([&](const Renderer::PixelValue<Common::Vec3f> &x) {
-        if (x.normDisp > 0) {
-          const auto depthError = x.depth() / *j - 1.F;
-          const auto lumaError = std::get<0>(x.attributes()).x() - *(jY);
-
-          const auto h = pp / W;
-          const auto w = pp % W;
-
-          if (h >= H) {
-            return false;
-          }
-
-          if (fabs(depthError) < m_maxDepthError && fabs(lumaError) < m_maxLumaError) {
-            currentCCMap(h, w).x() = static_cast<int32_t>(lumaError * maxValueF);
-            auto chromaError = std::get<0>(x.attributes()).y() - jYUV->y();
-            currentCCMap(h, w).y() = static_cast<int32_t>(chromaError * maxValueF);
-            chromaError = std::get<0>(x.attributes()).z() - jYUV->z();
-            currentCCMap(h, w).z() = static_cast<int32_t>(chromaError * maxValueF);
-          } else {
-            currentCCMap(h, w) = {};
-          }
+    if (i == refViewIdx) {
+      return;
+    }
+
+    const auto geoBitDepth = views[i].geometry.getBitDepth();
+    const auto depthTransform = MivBitstream::DepthTransform{params[i].dq, geoBitDepth};
+
+    const auto s = std::make_unique<TMIV::Pruner::IncrementalSynthesizer>(
+        tmpConfig, params[i].ci.projectionPlaneSize(), i,
+        depthTransform.expandDepth(views[i].geometry), expandLuma(views[i].texture),
+        expandTexture(yuv444(views[i].texture)));
+
+    auto overtices = Pruner::project(ivertices, params[refViewIdx], params[s->index]);
+    auto targetTriangles = triangles; // the triangle weights depend on the target view
+    Pruner::weightedSphere(params[s->index].ci, overtices, targetTriangles);
+    s->rasterizer.submit(overtices, attributes, targetTriangles);
+    s->rasterizer.run();
+
+    auto j = std::begin(s->reference);
+    auto jY = std::begin(s->referenceY);
+    auto jYUV = std::begin(s->referenceYUV);
+
+    int32_t pp = 0;
+
+    s->rasterizer.visit([&](const Renderer::PixelValue<Common::Vec3f> &x) {
+      if (x.normDisp > 0) {
+        const auto depthError = x.depth() / *j - 1.F;
+        const auto lumaError = std::get<0>(x.attributes()).x() - *(jY);
+
+        const auto h = pp / W;
+        const auto w = pp % W;
+
+        if (h >= H) {
+          return false;
         }
 
-        ++j;
-        ++jY;
-        ++jYUV;
-        ++pp;
+        if (fabs(depthError) < m_maxDepthError && fabs(lumaError) < m_maxLumaError) {
+          currentCCMap(h, w).x() = static_cast<int32_t>(lumaError * maxValueF);
+          auto chromaError = std::get<0>(x.attributes()).y() - jYUV->y();
+          currentCCMap(h, w).y() = static_cast<int32_t>(chromaError * maxValueF);
+          chromaError = std::get<0>(x.attributes()).z() - jYUV->z();
+          currentCCMap(h, w).z() = static_cast<int32_t>(chromaError * maxValueF);
+        } else {
+          currentCCMap(h, w) = {};
+        }
+      }
 
-        return true;
-      });
-    }
+      ++j;
+      ++jY;
+      ++jYUV;
+      ++pp;
+
+      return true;
+    });
+  });
+
+  Common::logVerbose(
+      "assessColorConsistency: {} target views in {:.3f} s", params.size() - 1,
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
 
-    colorCorrectionMaps1Frame.push_back(std::move(currentCCMap));
-  }
   return colorCorrectionMaps1Frame;
 }
 } // namespace TMIV::Encoder
@@ -37,71 +37,92 @@
 #include "PiecewiseLinearDepthScaling.h"
 
 #include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/Thread.h>
 
 namespace TMIV::Encoder {
 void Encoder::Impl::scaleGeometryDynamicRange() {
   PRECONDITION(m_config.dynamicDepthRange);
   const auto lowDepthQuality = params().casps.casps_miv_extension().casme_depth_low_quality_flag();
-  const auto numOfFrames = m_transportViews.size();
-  const auto numOfViews = m_transportViews[0].size();
-
-  LIMITATION(std::all_of(m_transportViews.cbegin(), m_transportViews.cend(), [](const auto &frame) {
-    return std::all_of(frame.cbegin(), frame.cend(), [](const auto &view) {
-      return view.geometry.getBitDepth() == Common::sampleBitDepth;
-    });
-  }));
+  auto &transportViews = m_completing->transportViews;
+  const auto numOfFrames = transportViews.size();
+  const auto numOfViews = transportViews.load(0)->size();
 
   static constexpr int32_t maxValue = Common::maxLevel(Common::sampleBitDepth);
   static constexpr auto maxValD = static_cast<double>(maxValue);
 
-  for (size_t v = 0; v < numOfViews; v++) {
-    int32_t minDepthMapValWithinGOP = maxValue;
-    int32_t maxDepthMapValWithinGOP = 0;
+  // Visit each frame once, such that spilled frames are read only once per pass
+  auto minDepthMapValWithinGOP = std::vector<int32_t>(numOfViews, maxValue);
+  auto maxDepthMapValWithinGOP = std::vector<int32_t>(numOfViews, 0);
 
-    for (size_t f = 0; f < numOfFrames; f++) {
-      for (const auto geometry : m_transportViews[f][v].geometry.getPlane(0)) {
-        if (geometry < minDepthMapValWithinGOP) {
-          minDepthMapValWithinGOP = geometry;
+  for (size_t f = 0; f < numOfFrames; f++) {
+    const auto frame = transportViews.load(f);
+
+    LIMITATION(std::all_of(frame->cbegin(), frame->cend(), [](const auto &view) {
+      return view.geometry.getBitDepth() == Common::sampleBitDepth;
+    }));
+
+    for (size_t v = 0; v < numOfViews; v++) {
+      for (const auto geometry : (*frame)[v].geometry.getPlane(0)) {
+        if (geometry < minDepthMapValWithinGOP[v]) {
+          minDepthMapValWithinGOP[v] = geometry;
         }
-        if (geometry > maxDepthMapValWithinGOP) {
-          maxDepthMapValWithinGOP = geometry;
+        if (geometry > maxDepthMapValWithinGOP[v]) {
+          maxDepthMapValWithinGOP[v] = geometry;
         }
       }
     }
+  }
 
-    if (maxDepthMapValWithinGOP == minDepthMapValWithinGOP) {
-      continue;
+#if ENABLE_M57419
+  auto mapped_pivot = std::vector<std::vector<double>>(numOfViews);
+
+  if (m_config.m57419_piecewiseDepthLinearScaling) {
+    for (size_t v = 0; v < numOfViews; v++) {
+      if (maxDepthMapValWithinGOP[v] != minDepthMapValWithinGOP[v]) {
+        mapped_pivot[v] = m57419_piecewiseLinearScaleGeometryDynamicRange(
+            numOfFrames, v, minDepthMapValWithinGOP[v], maxDepthMapValWithinGOP[v],
+            lowDepthQuality);
+      }
     }
+  } else {
+#endif
+    for (size_t f = 0; f < numOfFrames; f++) {
+      const auto frame = transportViews.modify(f);
 
-#if ENABLE_M57419
-    std::vector<double> mapped_pivot;
+      for (size_t v = 0; v < numOfViews; v++) {
+        const auto minDepth = static_cast<double>(minDepthMapValWithinGOP[v]);
+        const auto maxDepth = static_cast<double>(maxDepthMapValWithinGOP[v]);
 
-    if (m_config.m57419_piecewiseDepthLinearScaling) {
-      mapped_pivot = m57419_piecewiseLinearScaleGeometryDynamicRange(
-          numOfFrames, v, minDepthMapValWithinGOP, maxDepthMapValWithinGOP, lowDepthQuality);
-    } else {
-#endif
-      for (size_t f = 0; f < numOfFrames; f++) {
-        for (auto &geometry : m_transportViews[f][v].geometry.getPlane(0)) {
+        if (maxDepth == minDepth) {
+          continue;
+        }
+        for (auto &geometry : (*frame)[v].geometry.getPlane(0)) {
           geometry = static_cast<Common::DefaultElement>(
-              (static_cast<double>(geometry) - minDepthMapValWithinGOP) /
-              (static_cast<double>(maxDepthMapValWithinGOP) - minDepthMapValWithinGOP) * maxValD);
+              (static_cast<double>(geometry) - minDepth) / (maxDepth - minDepth) * maxValD);
           if (lowDepthQuality) {
             geometry /= 2;
           }
         }
       }
-#if ENABLE_M57419
     }
+#if ENABLE_M57419
+  }
 #endif
 
+  for (size_t v = 0; v < numOfViews; v++) {
+    if (maxDepthMapValWithinGOP[v] == minDepthMapValWithinGOP[v]) {
+      continue;
+    }
+
     const double normDispHighOrig = m_transportParams.viewParamsList[v].dq.dq_norm_disp_high();
     const double normDispLowOrig = m_transportParams.viewParamsList[v].dq.dq_norm_disp_low();
 
     double normDispHigh =
-        maxDepthMapValWithinGOP / maxValD * (normDispHighOrig - normDispLowOrig) + normDispLowOrig;
+        maxDepthMapValWithinGOP[v] / maxValD * (normDispHighOrig - normDispLowOrig) +
+        normDispLowOrig;
     const double normDispLow =
-        minDepthMapValWithinGOP / maxValD * (normDispHighOrig - normDispLowOrig) + normDispLowOrig;
+        minDepthMapValWithinGOP[v] / maxValD * (normDispHighOrig - normDispLowOrig) +
+        normDispLowOrig;
 
     if (lowDepthQuality && config().halveDepthRange) {
       normDispHigh = 2 * normDispHigh - normDispLow;
@@ -119,7 +140,7 @@ void Encoder::Impl::scaleGeometryDynamicRange() {
 
       for (int32_t i = 0; i < piece_num + 1; i++) {
         double normDispMap =
-            mapped_pivot[i] / maxValD * (normDispHighOrig - normDispLowOrig) + normDispLowOrig;
+            mapped_pivot[v][i] / maxValD * (normDispHighOrig - normDispLowOrig) + normDispLowOrig;
         m_params.viewParamsList[v].dq.dq_pivot_norm_disp(i, static_cast<float>(normDispMap));
       }
     }
@@ -128,26 +149,39 @@ void Encoder::Impl::scaleGeometryDynamicRange() {
 }
 
 void Encoder::Impl::correctColors() {
-  for (const auto &patch : params().patchParamsList) {
-    int32_t sumErrY = 0;
-    int32_t sumErrU = 0;
-    int32_t sumErrV = 0;
-
-    int32_t cnt = 0;
-
-    Common::Vec3i ccOffset;
-
-    const auto w = patch.atlasPatch3dSizeU();
-    const auto h = patch.atlasPatch3dSizeV();
-    const auto xM = patch.atlasPatch3dOffsetU();
-    const auto yM = patch.atlasPatch3dOffsetV();
-
-    const auto viewIdx = params().viewParamsList.indexOf(patch.atlasPatchProjectionId());
+  const auto &patchParamsList = params().patchParamsList;
+
+  struct Sums {
+    int32_t errY{};
+    int32_t errU{};
+    int32_t errV{};
+    int32_t cnt{};
+  };
+  auto sums = std::vector<Sums>(patchParamsList.size());
+
+  // Visit each frame once, such that spilled frames are read only once
+  const auto &transportViews = m_completing->transportViews;
+  const auto &nonAggregatedMask = m_completing->nonAggregatedMask;
+
+  for (size_t frame = 0; frame < transportViews.size(); frame++) {
+    const auto views = transportViews.load(frame);
+    const auto &colorCorrectionMaps = [this, frame]() -> const auto & {
+      const auto lock = std::lock_guard{m_colorCorrectionMutex};
+      return m_colorCorrectionMaps[frame];
+    }();
+
+    for (size_t p = 0; p < patchParamsList.size(); ++p) {
+      const auto &patch = patchParamsList[p];
+      const auto w = patch.atlasPatch3dSizeU();
+      const auto h = patch.atlasPatch3dSizeV();
+      const auto xM = patch.atlasPatch3dOffsetU();
+      const auto yM = patch.atlasPatch3dOffsetV();
 
-    for (size_t frame = 0; frame < m_transportViews.size(); frame++) {
-      const auto &view = m_transportViews[frame][viewIdx];
-      const auto &colorCorrectionMap = m_colorCorrectionMaps[frame][viewIdx];
+      const auto viewIdx = params().viewParamsList.indexOf(patch.atlasPatchProjectionId());
+      const auto &view = (*views)[viewIdx];
+      const auto &colorCorrectionMap = colorCorrectionMaps[viewIdx];
       const auto &textureViewMap = view.texture;
+      auto &sum = sums[p];
 
       for (int32_t y = 0; y < h; y++) {
         for (int32_t x = 0; x < w; x++) {
@@ -158,21 +192,25 @@ void Encoder::Impl::correctColors() {
             continue;
           }
 
-          cnt++;
+          sum.cnt++;
 
           if (colorCorrectionMap(pView.y(), pView.x()).x() != 0 &&
-              m_nonAggregatedMask[viewIdx](pView.y(), pView.x())[frame]) {
-            sumErrY += colorCorrectionMap(pView.y(), pView.x()).x();
-            sumErrU += colorCorrectionMap(pView.y(), pView.x()).y();
-            sumErrV += colorCorrectionMap(pView.y(), pView.x()).z();
+              nonAggregatedMask[viewIdx][frame].test(pView.y(), pView.x())) {
+            sum.errY += colorCorrectionMap(pView.y(), pView.x()).x();
+            sum.errU += colorCorrectionMap(pView.y(), pView.x()).y();
+            sum.errV += colorCorrectionMap(pView.y(), pView.x()).z();
           }
         }
       }
     }
+  }
+
+  for (const auto &sum : sums) {
+    Common::Vec3i ccOffset;
 
-    ccOffset.x() = sumErrY / cnt;
-    ccOffset.y() = sumErrU / cnt;
-    ccOffset.z() = sumErrV / cnt;
+    ccOffset.x() = sum.errY / sum.cnt;
+    ccOffset.y() = sum.errU / sum.cnt;
+    ccOffset.z() = sum.errV / sum.cnt;
 
     m_patchColorCorrectionOffset.push_back(ccOffset);
   }
@@ -407,8 +445,9 @@ void Encoder::Impl::setAtlasTileHeaderSnytax(size_t atlasIdx) {
 auto Encoder::Impl::completeAccessUnit() -> const EncoderParams & {
   Common::logVerbose("completeAccessUnit: FOC is {}.", m_params.foc);
 
-  m_aggregator->completeAccessUnit();
-  const auto &aggregatedMask = m_aggregator->getAggregatedMask();
+  m_completing = &m_accessUnits[m_completedCount++ % m_accessUnits.size()];
+  m_completing->aggregator->completeAccessUnit();
+  const auto &aggregatedMask = m_completing->aggregator->getAggregatedMask();
   updateAggregationStatistics(aggregatedMask);
 
   if (m_config.dynamicDepthRange) {
@@ -416,7 +455,7 @@ auto Encoder::Impl::completeAccessUnit() -> const EncoderParams & {
   }
 
   if (0 < m_config.maxEntityId) {
-    m_packer->updateAggregatedEntityMasks(m_aggregatedEntityMask);
+    m_packer->updateAggregatedEntityMasks(m_completing->aggregatedEntityMask);
   }
 
   setTiles();
@@ -460,10 +499,18 @@ auto Encoder::Impl::completeAccessUnit() -> const EncoderParams & {
   m_paramsQuantized = GeometryQuantizer::transformParams(params(), m_config.depthOccThresholdIfSet,
                                                          m_config.geoBitDepth);
 
-  m_params.foc += Common::downCast<int32_t>(m_videoFrameBuffer.size());
+  const auto &transportViews = m_completing->transportViews;
+  m_params.foc += Common::downCast<int32_t>(transportViews.size());
   m_params.foc %= m_config.intraPeriod;
   Common::logInfo("completeAccessUnit: Added {} frames. Updating FOC to {}.",
-                  m_videoFrameBuffer.size(), m_params.foc);
+                  transportViews.size(), m_params.foc);
+
+  if (m_config.frameBufferMemoryLimit) {
+    Common::logInfo("completeAccessUnit: {} of {} frames were spilled to disk. The peak frame "
+                    "buffer memory is {} MiB.",
+                    transportViews.spilledFrameCount(), transportViews.size(),
+                    transportViews.peakResidentBytes() >> 20);
+  }
 
   if (m_config.framePacking) {
     return m_framePacker.setPackingInformation(m_paramsQuantized);
@@ -491,6 +538,13 @@ void Encoder::Impl::applyPatchTextureOffset() {
   const auto bitShift =
       static_cast<int32_t>(inputBitDepth) - static_cast<int32_t>(m_config.texBitDepth);
 
+  auto isBasicView = std::vector<bool>{};
+  isBasicView.reserve(params().patchParamsList.size());
+
+  for (const auto &pp : params().patchParamsList) {
+    isBasicView.push_back(params().viewParamsList[pp.atlasPatchProjectionId()].isBasicView);
+  }
+
   for (auto &videoFrame : m_videoFrameBuffer) {
     for (uint8_t k = 0; k <= params().vps.vps_atlas_count_minus1(); ++k) {
       auto &atlas = videoFrame[k];
@@ -509,10 +563,7 @@ void Encoder::Impl::applyPatchTextureOffset() {
           const auto patchIdx = btpm[k][y / m_blockSize][x / m_blockSize];
 
           if (patchIdx == Common::unusedPatchIdx ||
-              (atlas.geometry.getPlane(0)(y, x) == 0 &&
-               !params()
-                    .viewParamsList[params().patchParamsList[patchIdx].atlasPatchProjectionId()]
-                    .isBasicView)) {
+              (atlas.geometry.getPlane(0)(y, x) == 0 && !isBasicView[patchIdx])) {
             continue;
           }
           if (!atlas.occupancy.getPlane(0)(y / occScaleY, x / occScaleX)) {
@@ -636,76 +687,133 @@ void Encoder::Impl::encodePatchTextureOffset(const PatchTextureStats &stats) {
   }
 }
 
-// NOLINTNEXTLINE(readability-function-cognitive-complexity,readability-function-size)
-void Encoder::Impl::constructVideoFrames() {
-  int32_t frameIdx = 0;
-
+auto Encoder::Impl::createAtlasFrames(const Common::DeepFrameList &views) const
+    -> Common::DeepFrameList {
   const auto &vps = params().vps;
+  Common::DeepFrameList atlasList;
+
+  for (size_t k = 0; k <= vps.vps_atlas_count_minus1(); ++k) {
+    auto &frame = atlasList.emplace_back();
+    const auto j = vps.vps_atlas_id(k);
+    const auto frameWidth = vps.vps_frame_width(j);
+    const auto frameHeight = vps.vps_frame_height(j);
 
-  auto patchTextureStats = PatchTextureStats(params().patchParamsList.size());
+    if (m_config.haveTexture) {
+      const auto texBitDepth = views.front().texture.getBitDepth();
 
-  for (const auto &views : m_transportViews) {
-    Common::DeepFrameList atlasList;
+      LIMITATION(std::all_of(views.cbegin(), views.cend(),
+                             [texBitDepth](const Common::DeepFrame &frame) {
+                               return frame.texture.getBitDepth() == texBitDepth;
+                             }));
 
-    for (size_t k = 0; k <= vps.vps_atlas_count_minus1(); ++k) {
-      auto &frame = atlasList.emplace_back();
-      const auto j = vps.vps_atlas_id(k);
-      const auto frameWidth = vps.vps_frame_width(j);
-      const auto frameHeight = vps.vps_frame_height(j);
+      frame.texture.createYuv420({frameWidth, frameHeight}, texBitDepth);
+      frame.texture.fillNeutral();
+    }
 
-      if (m_config.haveTexture) {
-        const auto texBitDepth = views.front().texture.getBitDepth();
+    if (m_config.haveGeometry) {
+      frame.geometry.createY({frameWidth, frameHeight});
+      frame.geometry.fillZero();
+    }
 
-        LIMITATION(std::all_of(views.cbegin(), views.cend(),
-                               [texBitDepth](const Common::DeepFrame &frame) {
-                                 return frame.texture.getBitDepth() == texBitDepth;
-                               }));
+    if (vps.vps_occupancy_video_present_flag(j)) {
+      int32_t occFrameWidth = frameWidth;
+      int32_t occFrameHeight = frameHeight;
 
-        frame.texture.createYuv420({frameWidth, frameHeight}, texBitDepth);
-        frame.texture.fillNeutral();
-      }
+      const auto &asme = params().atlas[k].asps.asps_miv_extension();
 
-      if (m_config.haveGeometry) {
-        frame.geometry.createY({frameWidth, frameHeight});
-        frame.geometry.fillZero();
+      if (!asme.asme_embedded_occupancy_enabled_flag() &&
+          asme.asme_occupancy_scale_enabled_flag()) {
+        occFrameWidth /= asme.asme_occupancy_scale_factor_x_minus1() + 1;
+        occFrameHeight /= asme.asme_occupancy_scale_factor_y_minus1() + 1;
       }
+      frame.occupancy.createY({occFrameWidth, occFrameHeight});
+    } else {
+      frame.occupancy.createY({frameWidth, frameHeight});
+    }
+
+    frame.occupancy.fillZero();
+  }
+  return atlasList;
+}
 
-      if (vps.vps_occupancy_video_present_flag(j)) {
-        int32_t occFrameWidth = frameWidth;
-        int32_t occFrameHeight = frameHeight;
+void Encoder::Impl::constructVideoFrame(const Common::DeepFrameList &views,
+                                        Common::DeepFrameList &atlasList, int32_t frameIdx,
+                                        PatchTextureStats &patchTextureStats) {
+  const auto &patchParamsList = params().patchParamsList;
 
-        const auto &asme = params().atlas[k].asps.asps_miv_extension();
+  // Separate each (view, entity) combination that is referenced by a patch only once
+  std::map<std::pair<size_t, Common::SampleValue>, Common::DeepFrame> entityViews;
 
-        if (!asme.asme_embedded_occupancy_enabled_flag() &&
-            asme.asme_occupancy_scale_enabled_flag()) {
-          occFrameWidth /= asme.asme_occupancy_scale_factor_x_minus1() + 1;
-          occFrameHeight /= asme.asme_occupancy_scale_factor_y_minus1() + 1;
-        }
-        frame.occupancy.createY({occFrameWidth, occFrameHeight});
-      } else {
-        frame.occupancy.createY({frameWidth, frameHeight});
-      }
+  for (const auto &patch : patchParamsList) {
+    const auto k = params().vps.indexOf(patch.atlasId());
+
+    if (0 < params().atlas[k].asps.asps_miv_extension().asme_max_entity_id()) {
+      const auto viewIdx = params().viewParamsList.indexOf(patch.atlasPatchProjectionId());
+      const auto key = std::pair{viewIdx, patch.atlasPatchEntityId()};
 
-      frame.occupancy.fillZero();
+      if (entityViews.find(key) == entityViews.end()) {
+        auto entityView = entitySeparator({views[viewIdx]}, patch.atlasPatchEntityId());
+        entityViews.emplace(key, std::move(entityView.front()));
+      }
     }
+  }
 
-    for (size_t p = 0; p < params().patchParamsList.size(); p++) {
-      const auto &patch = params().patchParamsList[p];
-      const auto viewIdx = params().viewParamsList.indexOf(patch.atlasPatchProjectionId());
-      const auto &view = views[viewIdx];
-      const auto k = params().vps.indexOf(patch.atlasId());
-
-      if (0 < params().atlas[k].asps.asps_miv_extension().asme_max_entity_id()) {
-        Common::DeepFrameList tempViews;
-        tempViews.push_back(view);
-        const auto &entityViews = entitySeparator(tempViews, patch.atlasPatchEntityId());
-        patchTextureStats[p] += writePatchInAtlas(patch, entityViews[0], atlasList, frameIdx, p);
-      } else {
+  // Atlases are written concurrently. Within an atlas, patches are written in order because
+  // patch-in-patch placement relies on later patches overwriting earlier ones.
+  Common::parallel_for(atlasList.size(), [&](size_t k) {
+    const auto atlasId = params().vps.vps_atlas_id(k);
+    const auto multiEntity = 0 < params().atlas[k].asps.asps_miv_extension().asme_max_entity_id();
+
+    for (size_t p = 0; p < patchParamsList.size(); ++p) {
+      const auto &patch = patchParamsList[p];
+
+      if (patch.atlasId() == atlasId) {
+        const auto viewIdx = params().viewParamsList.indexOf(patch.atlasPatchProjectionId());
+        const auto &view = multiEntity
+                               ? entityViews.at(std::pair{viewIdx, patch.atlasPatchEntityId()})
+                               : views[viewIdx];
         patchTextureStats[p] += writePatchInAtlas(patch, view, atlasList, frameIdx, p);
       }
     }
-    m_videoFrameBuffer.push_back(std::move(atlasList));
-    ++frameIdx;
+  });
+}
+
+void Encoder::Impl::constructVideoFrames() {
+  if (deferVideoFrames()) {
+    m_constructedFrameCount = 0;
+    return; // see popAtlas()
+  }
+
+  auto &transportViews = m_completing->transportViews;
+  const auto frameCount = transportViews.size();
+  const auto patchCount = params().patchParamsList.size();
+
+  // Construct the frames of the intra period concurrently with frame-local texture statistics.
+  // With a memory limit, the number of frames that are loaded at the same time is capped.
+  auto videoFrames = std::vector<Common::DeepFrameList>(frameCount);
+  auto framePatchTextureStats = std::vector<PatchTextureStats>(frameCount);
+  const auto batchSize = transportViews.frameCapacity();
+
+  for (size_t firstIdx = 0; firstIdx < frameCount; firstIdx += batchSize) {
+    Common::parallel_for(std::min(batchSize, frameCount - firstIdx), [&](size_t i) {
+      const auto frameIdx = firstIdx + i;
+      const auto views = transportViews.load(frameIdx);
+
+      videoFrames[frameIdx] = createAtlasFrames(*views);
+      framePatchTextureStats[frameIdx].resize(patchCount);
+      constructVideoFrame(*views, videoFrames[frameIdx], static_cast<int32_t>(frameIdx),
+                          framePatchTextureStats[frameIdx]);
+      transportViews.release(frameIdx);
+    });
+  }
+
+  auto patchTextureStats = PatchTextureStats(patchCount);
+
+  for (size_t frameIdx = 0; frameIdx < frameCount; ++frameIdx) {
+    for (size_t p = 0; p < patchCount; ++p) {
+      patchTextureStats[p] += framePatchTextureStats[frameIdx][p];
+    }
+    m_videoFrameBuffer.push_back(std::move(videoFrames[frameIdx]));
   }
 
   if (m_config.textureOffsetFlag) {
@@ -714,6 +822,22 @@ void Encoder::Impl::constructVideoFrames() {
   }
 }
 
+void Encoder::Impl::constructNextVideoFrame() {
+  const auto frameIdx = m_constructedFrameCount++;
+  auto atlasList = Common::DeepFrameList{};
+
+  {
+    const auto views = m_completing->transportViews.load(frameIdx);
+    auto patchTextureStats = PatchTextureStats(params().patchParamsList.size());
+
+    atlasList = createAtlasFrames(*views);
+    constructVideoFrame(*views, atlasList, static_cast<int32_t>(frameIdx), patchTextureStats);
+  }
+
+  m_completing->transportViews.release(frameIdx);
+  m_videoFrameBuffer.push_back(std::move(atlasList));
+}
+
 auto Encoder::Impl::isRedundantBlock(Common::Vec2i topLeft, Common::Vec2i bottomRight,
                                      uint16_t viewIdx, int32_t frameIdx) const -> bool {
   if (!m_config.patchRedundancyRemoval) {
@@ -722,14 +846,8 @@ auto Encoder::Impl::isRedundantBlock(Common::Vec2i topLeft, Common::Vec2i bottom
   bottomRight.x() = std::min(topLeft.x() + m_blockSize, bottomRight.x());
   bottomRight.y() = std::min(topLeft.y() + m_blockSize, bottomRight.y());
 
-  for (int32_t y = topLeft.y(); y < bottomRight.y(); ++y) {
-    for (int32_t x = topLeft.x(); x < bottomRight.x(); ++x) {
-      if (m_nonAggregatedMask[viewIdx](y, x)[frameIdx]) {
-        return false;
-      }
-    }
-  }
-  return true;
+  return !m_completing->nonAggregatedMask[viewIdx][frameIdx].any(topLeft.y(), topLeft.x(),
+                                                                 bottomRight.y(), bottomRight.x());
 }
 
 namespace {
@@ -762,8 +880,15 @@ auto Encoder::Impl::writePatchInAtlas(const MivBitstream::PatchParams &patchPara
   const auto posU = patchParams.atlasPatch3dOffsetU();
   const auto posV = patchParams.atlasPatch3dOffsetV();
 
+  const auto viewIdx = params().viewParamsList.indexOf(patchParams.atlasPatchProjectionId());
   const auto &inViewParams = m_transportParams.viewParamsList[patchParams.atlasPatchProjectionId()];
-  const auto &outViewParams = params().viewParamsList[patchParams.atlasPatchProjectionId()];
+  const auto &outViewParams = params().viewParamsList[viewIdx];
+
+  // Hoist per-patch look-ups out of the per-sample loop
+  const auto &asme = params().atlas[k].asps.asps_miv_extension();
+  const auto occupancyVideoPresent =
+      params().vps.vps_occupancy_video_present_flag(patchParams.atlasId());
+  const auto viewToAtlas = patchParams.viewToAtlasTransform();
 
   auto textureStats = TextureStats{};
 
@@ -773,7 +898,6 @@ auto Encoder::Impl::writePatchInAtlas(const MivBitstream::PatchParams &patchPara
 
   for (int32_t vBlock = 0; vBlock < sizeV; vBlock += m_blockSize) {
     for (int32_t uBlock = 0; uBlock < sizeU; uBlock += m_blockSize) {
-      const auto viewIdx = params().viewParamsList.indexOf(patchParams.atlasPatchProjectionId());
       const auto redundant = isRedundantBlock({posU + uBlock, posV + vBlock},
                                               {posU + sizeU, posV + sizeV}, viewIdx, frameIdx);
       int32_t yOcc = 0;
@@ -781,9 +905,7 @@ auto Encoder::Impl::writePatchInAtlas(const MivBitstream::PatchParams &patchPara
       for (int32_t v = vBlock; v < vBlock + m_blockSize && v < sizeV; ++v) {
         for (int32_t u = uBlock; u < uBlock + m_blockSize && u < sizeU; ++u) {
           const auto pView = Common::Vec2i{posU + u, posV + v};
-          const auto pAtlas = patchParams.viewToAtlas(pView);
-
-          const auto &asme = params().atlas[k].asps.asps_miv_extension();
+          const auto pAtlas = MivBitstream::PatchParams::viewToAtlas(pView, viewToAtlas);
 
           if (!asme.asme_embedded_occupancy_enabled_flag() &&
               asme.asme_occupancy_scale_enabled_flag()) {
@@ -820,7 +942,7 @@ auto Encoder::Impl::writePatchInAtlas(const MivBitstream::PatchParams &patchPara
 
             atlas.geometry.getPlane(0)(pAtlas.y(), pAtlas.x()) = depth;
 
-            if (depth > 0 && params().vps.vps_occupancy_video_present_flag(patchParams.atlasId())) {
+            if (depth > 0 && occupancyVideoPresent) {
               atlas.occupancy.getPlane(0)(yOcc, xOcc) = true;
             }
           }
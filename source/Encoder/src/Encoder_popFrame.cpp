@@ -37,6 +37,10 @@
 
 namespace TMIV::Encoder {
 auto Encoder::Impl::popAtlas() -> Common::V3cFrameList {
+  if (deferVideoFrames()) {
+    constructNextVideoFrame();
+  }
+
   if (m_config.haveGeometry) {
     auto quantizedFrame = GeometryQuantizer::transformAtlases(params(), m_paramsQuantized,
                                                               m_videoFrameBuffer.front());
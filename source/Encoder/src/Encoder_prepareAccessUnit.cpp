@@ -35,18 +35,15 @@
 
 namespace TMIV::Encoder {
 void Encoder::Impl::prepareAccessUnit() {
+  m_pushing = &m_accessUnits[m_preparedCount++ % m_accessUnits.size()];
+
   resetNonAggregatedMask();
-  m_transportViews.clear();
-  m_aggregatedEntityMask.clear();
-  m_aggregator->prepareAccessUnit();
+  m_pushing->transportViews.clear();
+  m_pushing->aggregatedEntityMask.clear();
+  m_pushing->aggregator->prepareAccessUnit();
 }
 
 void Encoder::Impl::resetNonAggregatedMask() {
-  m_nonAggregatedMask.clear();
-  for (const auto &viewParams : m_transportParams.viewParamsList) {
-    m_nonAggregatedMask.push_back(
-        NonAggregatedMask{{viewParams.ci.ci_projection_plane_height_minus1() + size_t{1},
-                           viewParams.ci.ci_projection_plane_width_minus1() + size_t{1}}});
-  }
+  m_pushing->nonAggregatedMask.assign(m_transportParams.viewParamsList.size(), {});
 }
 } // namespace TMIV::Encoder
@@ -430,6 +430,7 @@ void Encoder::Impl::prepareSequence(const MivBitstream::SequenceConfig &sequence
                                     const Common::DeepFrameList &firstFrame) {
   const auto depthLowQualityFlag =
       assessDepthQuality(m_config, *m_depthQualityAssessor, sequenceConfig, firstFrame);
+  m_depthLowQualityFlag = depthLowQualityFlag;
   m_blockSize = m_config.blockSize(depthLowQualityFlag);
 
   m_transportParams =
@@ -47,81 +47,31 @@ void Encoder::Impl::pushFrame(Common::DeepFrameList sourceViews) {
 void Encoder::Impl::pushSingleEntityFrame(Common::DeepFrameList sourceViews) {
   auto transportViews = m_viewOptimizer->optimizeFrame(std::move(sourceViews));
   if (m_config.colorCorrectionEnabledFlag) {
-    m_colorCorrectionMaps.push_back(
-        assessColorConsistency(transportViews, m_transportParams.viewParamsList));
+    auto colorCorrectionMaps =
+        assessColorConsistency(transportViews, m_transportParams.viewParamsList);
+    const auto lock = std::lock_guard{m_colorCorrectionMutex};
+    m_colorCorrectionMaps.push_back(std::move(colorCorrectionMaps));
   }
   const auto masks = m_pruner->prune(m_transportParams.viewParamsList, transportViews);
-  updateNonAggregatedMask(transportViews, masks);
-  m_transportViews.push_back(std::move(transportViews));
-  m_aggregator->pushMask(masks);
+  updateNonAggregatedMask(masks);
+  m_pushing->transportViews.push_back(std::move(transportViews));
+  m_pushing->aggregator->pushMask(masks);
 }
 
-namespace {
-// Atlas dilation
-// Visit all pixels
-template <typename F> void forPixels(std::array<size_t, 2> sizes, F f) {
-  for (int32_t i = 0; i < static_cast<int32_t>(sizes[0]); ++i) {
-    for (int32_t j = 0; j < static_cast<int32_t>(sizes[1]); ++j) {
-      f(i, j);
-    }
-  }
-}
-
-// Visit all pixel neighbors (in between 3 and 8)
-template <typename F>
-auto forNeighbors(int32_t i, int32_t j, std::array<size_t, 2> sizes, F f) -> bool {
-  const int32_t n1 = std::max(0, i - 1);
-  const int32_t n2 = std::min(static_cast<int32_t>(sizes[0]), i + 2);
-  const int32_t m1 = std::max(0, j - 1);
-  const int32_t m2 = std::min(static_cast<int32_t>(sizes[1]), j + 2);
-
-  for (int32_t n = n1; n < n2; ++n) {
-    for (int32_t m = m1; m < m2; ++m) {
-      if (!f(n, m)) {
-        return false;
-      }
-    }
-  }
-  return true;
-}
-
-auto dilate(const Common::Mat<uint8_t> &mask) -> Common::Mat<uint8_t> {
-  Common::Mat<uint8_t> result{mask.sizes()};
-  forPixels(mask.sizes(), [&](int32_t i, int32_t j) {
-    result(i, j) =
-        forNeighbors(i, j, mask.sizes(), [&mask](int32_t n, int32_t m) { return mask(n, m) == 0; })
-            ? 0
-            : 255;
-  });
-  return result;
-}
-} // namespace
-
-void Encoder::Impl::updateNonAggregatedMask(const Common::DeepFrameList &transportViews,
-                                            const Common::FrameList<uint8_t> &masks) {
-  const auto frameIdx = m_transportViews.size();
-  Common::FrameList<uint8_t> dilatedMasks = masks; // Atlas dilation
-
-  // Atlas dilation
-  if (params().casps.casps_miv_extension().casme_depth_low_quality_flag()) {
-    for (size_t viewIdx = 0; viewIdx < masks.size(); ++viewIdx) {
-      for (int32_t n = 0; n < m_config.dilationIter; ++n) {
-        dilatedMasks[viewIdx].getPlane(0) = dilate(dilatedMasks[viewIdx].getPlane(0));
-      }
-    }
-  }
+void Encoder::Impl::updateNonAggregatedMask(const Common::FrameList<uint8_t> &masks) {
+  const auto frameIdx = m_pushing->transportViews.size();
 
   for (size_t viewIdx = 0; viewIdx < masks.size(); ++viewIdx) {
-    const auto height = transportViews[viewIdx].texture.getHeight();
-    const auto width = transportViews[viewIdx].texture.getWidth();
+    auto mask = Common::BitMask{masks[viewIdx]};
 
-    for (int32_t i = 0; i < height; i++) {
-      for (int32_t j = 0; j < width; j++) {
-        if (dilatedMasks[viewIdx].getPlane(0)(i, j) != 0) {
-          m_nonAggregatedMask[viewIdx](i, j)[frameIdx] = true;
-        }
-      }
+    // Atlas dilation
+    for (int32_t n = 0; m_depthLowQualityFlag && n < m_config.dilationIter; ++n) {
+      mask = mask.dilate();
     }
+
+    auto &frameMasks = m_pushing->nonAggregatedMask[viewIdx];
+    PRECONDITION(frameMasks.size() == frameIdx);
+    frameMasks.push_back(std::move(mask));
   }
 }
 
@@ -144,9 +94,9 @@ void Encoder::Impl::pushMultiEntityFrame(Common::DeepFrameList sourceViews) {
     mergeMasks(mergedMasks, masks);
   }
 
-  updateNonAggregatedMask(transportViews, mergedMasks);
-  m_transportViews.push_back(std::move(transportViews));
-  m_aggregator->pushMask(mergedMasks);
+  updateNonAggregatedMask(mergedMasks);
+  m_pushing->transportViews.push_back(std::move(transportViews));
+  m_pushing->aggregator->pushMask(mergedMasks);
 }
 
 auto Encoder::Impl::yuvSampler(const Common::FrameList<> &in) -> Common::FrameList<> {
@@ -200,12 +150,14 @@ void Encoder::Impl::updateMasks(const Common::DeepFrameList &views,
 
 void Encoder::Impl::aggregateEntityMasks(Common::FrameList<uint8_t> &masks,
                                          Common::SampleValue entityId) {
-  if (m_aggregatedEntityMask.size() < m_config.entityEncRange[1] - m_config.entityEncRange[0]) {
-    m_aggregatedEntityMask.push_back(masks);
+  auto &aggregatedEntityMask = m_pushing->aggregatedEntityMask;
+
+  if (aggregatedEntityMask.size() < m_config.entityEncRange[1] - m_config.entityEncRange[0]) {
+    aggregatedEntityMask.push_back(masks);
   } else {
     for (size_t i = 0; i < masks.size(); i++) {
       auto &entityMaskPlane =
-          m_aggregatedEntityMask[entityId - m_config.entityEncRange[0]][i].getPlane(0);
+          aggregatedEntityMask[entityId - m_config.entityEncRange[0]][i].getPlane(0);
       std::transform(entityMaskPlane.begin(), entityMaskPlane.end(), masks[i].getPlane(0).begin(),
                      entityMaskPlane.begin(), [](auto v1, auto v2) { return std::max(v1, v2); });
     }
@@ -104,7 +104,9 @@ public:
     }
 
     m_encoder.setMpiPcsFrameReader(
-        [&](int32_t frameIdx) -> MpiPcs::Frame { return m_mpiPcsReader.read(frameIdx); });
+        [&](int32_t frameIdx) -> MpiPcs::CompactFrame {
+          return m_mpiPcsReader.readCompact(frameIdx);
+        });
 
     m_encoder.prepareSequence(m_inputSequenceConfig);
 
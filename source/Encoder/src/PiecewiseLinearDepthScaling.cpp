@@ -156,8 +156,10 @@ auto Encoder::Impl::m57419_makeHistogram(int32_t piece_num, size_t numOfFrames,
   histEdge.assign(piece_num, 0);
 
   for (size_t f = 0; f < numOfFrames; f++) {
-    int32_t heightOfView = m_transportViews[f][v].geometry.getHeight();
-    int32_t widthOfView = m_transportViews[f][v].geometry.getWidth();
+    const auto frame = m_completing->transportViews.load(f);
+    const auto &geometryPlane = (*frame)[v].geometry.getPlane(0);
+    int32_t heightOfView = (*frame)[v].geometry.getHeight();
+    int32_t widthOfView = (*frame)[v].geometry.getWidth();
 
     for (int32_t i = 1; i < heightOfView - 1; ++i) {
       for (int32_t j = 1; j < widthOfView - 1; ++j) {
@@ -166,10 +168,11 @@ auto Encoder::Impl::m57419_makeHistogram(int32_t piece_num, size_t numOfFrames,
           for (int32_t kj = 0; kj <= 2; ++kj) {
             int32_t ui = i - 1 + ki;
             int32_t uj = i - 1 + kj;
-            geometryUnit[ki][kj] = m_transportViews[f][v].geometry.getPlane(0)(ui, uj);
+            geometryUnit[ki][kj] = geometryPlane(ui, uj);
           }
         }
-        if (m_nonAggregatedMask[v](i, j)[f] && m57419_edgeDetection(geometryUnit, line_thres)) {
+        if (m_completing->nonAggregatedMask[v][f].test(i, j) &&
+            m57419_edgeDetection(geometryUnit, line_thres)) {
           int32_t interval_idx =
               std::clamp(static_cast<int32_t>(
                              (static_cast<double>(geometryUnit[1][1] - minDepthVal)) / interval),
@@ -197,7 +200,9 @@ auto Encoder::Impl::m57419_piecewiseLinearScaleGeometryDynamicRange(size_t numOf
   mapped_pivot = m57419_normalizeHistogram(histEdge, piece_num, lowDepthQuality,
                                            minDepthMapValWithinGOP, maxDepthMapValWithinGOP);
   for (size_t f = 0; f < numOfFrames; f++) {
-    for (auto &geometry : m_transportViews[f][v].geometry.getPlane(0)) {
+    const auto frame = m_completing->transportViews.modify(f);
+
+    for (auto &geometry : (*frame)[v].geometry.getPlane(0)) {
       uint16_t inGeometry = geometry;
       geometry = m57419_depthMapping(minDepthMapValWithinGOP, maxDepthMapValWithinGOP, piece_num,
                                      inGeometry, mapped_pivot, lowDepthQuality);
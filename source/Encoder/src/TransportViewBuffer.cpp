@@ -0,0 +1,404 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TransportViewBuffer.h"
+
+#include <TMIV/Common/verify.h>
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <numeric>
+
+namespace TMIV::Encoder {
+namespace {
+template <typename T> void putValue(std::ostream &stream, T value) {
+  stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T> auto getValue(std::istream &stream) {
+  auto value = T{};
+  stream.read(reinterpret_cast<char *>(&value), sizeof(T));
+  return value;
+}
+
+template <typename Element>
+void writeFrame(std::ostream &stream, const Common::Frame<Element> &frame) {
+  putValue(stream, static_cast<uint8_t>(frame.empty() ? 0 : 1));
+
+  if (frame.empty()) {
+    return;
+  }
+  putValue(stream, static_cast<int32_t>(frame.getWidth()));
+  putValue(stream, static_cast<int32_t>(frame.getHeight()));
+  putValue(stream, static_cast<uint32_t>(frame.getBitDepth()));
+  putValue(stream, static_cast<uint8_t>(frame.getColorFormat()));
+
+  if constexpr (std::is_same_v<Element, bool>) {
+    for (const auto &plane : frame.getPlanes()) {
+      const auto buffer = std::vector<char>(plane.begin(), plane.end());
+      stream.write(buffer.data(), Common::assertDownCast<std::streamsize>(buffer.size()));
+    }
+  } else {
+    frame.writeTo(stream);
+  }
+}
+
+template <typename Element> void readFrame(std::istream &stream, Common::Frame<Element> &frame) {
+  if (getValue<uint8_t>(stream) == 0) {
+    return;
+  }
+  const auto width = getValue<int32_t>(stream);
+  const auto height = getValue<int32_t>(stream);
+  const auto bitDepth = getValue<uint32_t>(stream);
+  const auto colorFormat = static_cast<Common::ColorFormat>(getValue<uint8_t>(stream));
+  frame.create({width, height}, bitDepth, colorFormat);
+
+  if constexpr (std::is_same_v<Element, bool>) {
+    for (auto &plane : frame.getPlanes()) {
+      auto buffer = std::vector<char>(plane.size());
+      stream.read(buffer.data(), Common::assertDownCast<std::streamsize>(buffer.size()));
+      std::transform(buffer.cbegin(), buffer.cend(), plane.begin(),
+                     [](char x) { return x != 0; });
+    }
+  } else {
+    frame.readFrom(stream);
+  }
+}
+
+template <typename Element> auto byteCount(const Common::Frame<Element> &frame) -> size_t {
+  return frame.empty() ? 0 : frame.getByteCount();
+}
+
+// The number of bytes that writeFrame() writes
+template <typename Element> auto spillByteCount(const Common::Frame<Element> &frame) -> size_t {
+  auto sum = sizeof(uint8_t);
+
+  if (!frame.empty()) {
+    sum += 2 * sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint8_t);
+
+    for (const auto &plane : frame.getPlanes()) {
+      sum += plane.size() * sizeof(Element);
+    }
+  }
+  return sum;
+}
+
+auto spillByteCount(const Common::DeepFrameList &frame) -> size_t {
+  auto sum = sizeof(uint32_t);
+
+  for (const auto &view : frame) {
+    sum += spillByteCount(view.texture) + spillByteCount(view.geometry) +
+           spillByteCount(view.entities) + spillByteCount(view.occupancy) +
+           spillByteCount(view.transparency);
+  }
+  return sum;
+}
+
+auto byteCount(const Common::DeepFrameList &frame) -> size_t {
+  auto sum = size_t{};
+
+  for (const auto &view : frame) {
+    sum += byteCount(view.texture) + byteCount(view.geometry) + byteCount(view.entities) +
+           byteCount(view.occupancy) + byteCount(view.transparency);
+  }
+  return sum;
+}
+
+auto uniqueSpillPath(const void *owner) {
+  const auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+  return std::filesystem::temp_directory_path() / fmt::format("tmiv-{}-{}.spill", ticks, owner);
+}
+} // namespace
+
+void ResidentBytes::add(size_t bytes) {
+  const auto lock = std::lock_guard{m_mutex};
+  m_current += bytes;
+  m_peak = std::max(m_peak, m_current);
+}
+
+void ResidentBytes::subtract(size_t bytes) {
+  const auto lock = std::lock_guard{m_mutex};
+  PRECONDITION(bytes <= m_current);
+  m_current -= bytes;
+}
+
+auto ResidentBytes::current() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_current;
+}
+
+auto ResidentBytes::peak() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_peak;
+}
+
+TransportViewBuffer::TransportViewBuffer(std::optional<size_t> memoryLimit,
+                                         std::shared_ptr<ResidentBytes> sharedBytes)
+    : m_memoryLimit{memoryLimit}, m_sharedBytes{std::move(sharedBytes)} {}
+
+TransportViewBuffer::~TransportViewBuffer() {
+  subtractResidentBytes(m_residentBytes);
+
+  if (m_spillFile.is_open()) {
+    m_spillFile.close();
+    auto ec = std::error_code{};
+    std::filesystem::remove(m_spillPath, ec);
+  }
+}
+
+void TransportViewBuffer::push_back(Common::DeepFrameList frame) {
+  const auto lock = std::lock_guard{m_mutex};
+
+  m_entries.emplace_back();
+  makeResident(m_entries.size() - 1, std::make_shared<Common::DeepFrameList>(std::move(frame)));
+  m_entries.back().dirty = true;
+  evict(m_entries.size() - 1);
+}
+
+void TransportViewBuffer::clear() {
+  const auto lock = std::lock_guard{m_mutex};
+
+  m_entries.clear();
+  subtractResidentBytes(m_residentBytes);
+
+  // Reuse the spill file for the next intra period
+  if (m_spillFile.is_open()) {
+    m_spillFile.close();
+    m_spillFile.open(m_spillPath,
+                     std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+  }
+}
+
+void TransportViewBuffer::release(size_t frameIdx) {
+  const auto lock = std::lock_guard{m_mutex};
+  auto &entry = m_entries.at(frameIdx);
+
+  if (entry.frame) {
+    subtractResidentBytes(entry.bytes);
+    entry.frame.reset();
+  }
+  entry.position.reset();
+  entry.dirty = false;
+}
+
+auto TransportViewBuffer::size() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_entries.size();
+}
+
+auto TransportViewBuffer::empty() const -> bool {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_entries.empty();
+}
+
+auto TransportViewBuffer::modify(size_t frameIdx) -> std::shared_ptr<Common::DeepFrameList> {
+  return acquire(frameIdx, true);
+}
+
+auto TransportViewBuffer::load(size_t frameIdx) const
+    -> std::shared_ptr<const Common::DeepFrameList> {
+  return acquire(frameIdx, false);
+}
+
+auto TransportViewBuffer::residentBytes() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_residentBytes;
+}
+
+auto TransportViewBuffer::peakResidentBytes() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return m_peakResidentBytes;
+}
+
+auto TransportViewBuffer::spilledFrameCount() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+  return static_cast<size_t>(
+      std::count_if(m_entries.cbegin(), m_entries.cend(),
+                    [](const Entry &entry) { return !entry.frame && entry.position; }));
+}
+
+auto TransportViewBuffer::spillFileBytes() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+
+  if (!m_spillFile.is_open()) {
+    return 0;
+  }
+  m_spillFile.seekp(0, std::ios::end);
+  return static_cast<size_t>(m_spillFile.tellp());
+}
+
+auto TransportViewBuffer::frameCapacity() const -> size_t {
+  const auto lock = std::lock_guard{m_mutex};
+
+  if (!m_memoryLimit) {
+    return m_entries.size();
+  }
+  const auto maxBytes = std::accumulate(
+      m_entries.cbegin(), m_entries.cend(), size_t{},
+      [](size_t max, const Entry &entry) { return std::max(max, entry.bytes); });
+  return std::max(size_t{1}, maxBytes == 0 ? m_entries.size() : *m_memoryLimit / maxBytes);
+}
+
+auto TransportViewBuffer::acquire(size_t frameIdx, bool modify) const
+    -> std::shared_ptr<Common::DeepFrameList> {
+  const auto lock = std::lock_guard{m_mutex};
+  auto &entry = m_entries.at(frameIdx);
+
+  if (!entry.frame) {
+    if (!entry.position) {
+      throw std::runtime_error(
+          fmt::format("Transport views of frame {} have already been released", frameIdx));
+    }
+    makeResident(frameIdx, std::make_shared<Common::DeepFrameList>(restore(*entry.position)));
+  }
+  entry.lastUse = ++m_useCounter;
+  entry.dirty = entry.dirty || modify;
+
+  auto result = entry.frame;
+  evict(frameIdx);
+  return result;
+}
+
+void TransportViewBuffer::makeResident(size_t frameIdx,
+                                       std::shared_ptr<Common::DeepFrameList> frame) const {
+  auto &entry = m_entries[frameIdx];
+  entry.bytes = byteCount(*frame);
+  entry.frame = std::move(frame);
+  entry.lastUse = ++m_useCounter;
+  addResidentBytes(entry.bytes);
+}
+
+// Spill least recently used frames until the resident frames fit. The frame that is being accessed
+// and frames that are held by a caller of load() are never spilled.
+void TransportViewBuffer::evict(size_t keepIdx) const {
+  if (!m_memoryLimit) {
+    return;
+  }
+  while (*m_memoryLimit < m_residentBytes) {
+    auto victim = m_entries.end();
+
+    for (auto i = m_entries.begin(); i != m_entries.end(); ++i) {
+      if (i->frame && i->frame.use_count() == 1 &&
+          static_cast<size_t>(i - m_entries.begin()) != keepIdx &&
+          (victim == m_entries.end() || i->lastUse < victim->lastUse)) {
+        victim = i;
+      }
+    }
+    if (victim == m_entries.end()) {
+      return;
+    }
+    spill(*victim);
+  }
+}
+
+void TransportViewBuffer::spill(Entry &entry) const {
+  if (entry.dirty || !entry.position) {
+    if (!m_spillFile.is_open()) {
+      m_spillPath = uniqueSpillPath(this);
+      m_spillFile.open(m_spillPath,
+                       std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+      if (!m_spillFile.good()) {
+        throw std::runtime_error(
+            fmt::format("Failed to open {} for writing", m_spillPath.string()));
+      }
+    }
+
+    // A frame that does not fit in its previous position is appended, such that it cannot
+    // overwrite its neighbour
+    const auto spillBytes = spillByteCount(*entry.frame);
+
+    if (entry.position && spillBytes <= entry.spillBytes) {
+      m_spillFile.seekp(*entry.position);
+    } else {
+      m_spillFile.seekp(0, std::ios::end);
+      entry.position = std::streamoff{m_spillFile.tellp()};
+      entry.spillBytes = spillBytes;
+    }
+    putValue(m_spillFile, static_cast<uint32_t>(entry.frame->size()));
+
+    for (const auto &view : *entry.frame) {
+      writeFrame(m_spillFile, view.texture);
+      writeFrame(m_spillFile, view.geometry);
+      writeFrame(m_spillFile, view.entities);
+      writeFrame(m_spillFile, view.occupancy);
+      writeFrame(m_spillFile, view.transparency);
+    }
+
+    if (!m_spillFile.good()) {
+      throw std::runtime_error(
+          fmt::format("Failed to spill transport views to {}", m_spillPath.string()));
+    }
+    entry.dirty = false;
+  }
+
+  subtractResidentBytes(entry.bytes);
+  entry.frame.reset();
+}
+
+auto TransportViewBuffer::restore(std::streamoff position) const -> Common::DeepFrameList {
+  m_spillFile.seekg(position);
+
+  auto frame = Common::DeepFrameList(getValue<uint32_t>(m_spillFile));
+
+  for (auto &view : frame) {
+    readFrame(m_spillFile, view.texture);
+    readFrame(m_spillFile, view.geometry);
+    readFrame(m_spillFile, view.entities);
+    readFrame(m_spillFile, view.occupancy);
+    readFrame(m_spillFile, view.transparency);
+  }
+  if (!m_spillFile.good()) {
+    throw std::runtime_error(
+        fmt::format("Failed to read transport views from {}", m_spillPath.string()));
+  }
+  return frame;
+}
+
+void TransportViewBuffer::addResidentBytes(size_t bytes) const {
+  m_residentBytes += bytes;
+  m_peakResidentBytes = std::max(m_peakResidentBytes, m_residentBytes);
+
+  if (m_sharedBytes) {
+    m_sharedBytes->add(bytes);
+  }
+}
+
+void TransportViewBuffer::subtractResidentBytes(size_t bytes) const {
+  m_residentBytes -= bytes;
+
+  if (m_sharedBytes) {
+    m_sharedBytes->subtract(bytes);
+  }
+}
+} // namespace TMIV::Encoder
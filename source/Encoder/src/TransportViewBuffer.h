@@ -0,0 +1,140 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_ENCODER_TRANSPORTVIEWBUFFER_H
+#define TMIV_ENCODER_TRANSPORTVIEWBUFFER_H
+
+#include <TMIV/Common/Frame.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace TMIV::Encoder {
+// The number of bytes that are resident at the same time in a group of buffers, and the maximum
+// thereof
+class ResidentBytes {
+public:
+  void add(size_t bytes);
+  void subtract(size_t bytes);
+
+  [[nodiscard]] auto current() const -> size_t;
+  [[nodiscard]] auto peak() const -> size_t;
+
+private:
+  mutable std::mutex m_mutex;
+  size_t m_current{};
+  size_t m_peak{};
+};
+
+// Buffer of the transport views of an intra period
+//
+// Without a memory limit all frames are kept in memory. With a memory limit, the least recently
+// used frames are spilled to a temporary file when the resident frames exceed the limit, and they
+// are read back on access. Frames are accessed through shared pointers that keep the frame in
+// memory for as long as they are held. Do not keep references into a frame after the pointer has
+// been dropped: the frame may then be spilled and its memory released.
+//
+// A spilled frame that is modified and spilled again is written back to its previous position in
+// the file when it fits, such that the file does not grow when frames are spilled repeatedly.
+//
+// Buffers that share a ResidentBytes object also report their resident bytes to it.
+class TransportViewBuffer {
+public:
+  explicit TransportViewBuffer(std::optional<size_t> memoryLimit = std::nullopt,
+                               std::shared_ptr<ResidentBytes> sharedBytes = nullptr);
+  TransportViewBuffer(const TransportViewBuffer &) = delete;
+  TransportViewBuffer(TransportViewBuffer &&) = delete;
+  auto operator=(const TransportViewBuffer &) -> TransportViewBuffer & = delete;
+  auto operator=(TransportViewBuffer &&) -> TransportViewBuffer & = delete;
+  ~TransportViewBuffer();
+
+  void push_back(Common::DeepFrameList frame);
+  void clear();
+
+  // Drop a frame that is no longer needed
+  void release(size_t frameIdx);
+
+  [[nodiscard]] auto size() const -> size_t;
+  [[nodiscard]] auto empty() const -> bool;
+
+  // Access a frame for modification. The frame is marked as modified, such that it is written
+  // again when it has to leave memory.
+  [[nodiscard]] auto modify(size_t frameIdx) -> std::shared_ptr<Common::DeepFrameList>;
+
+  // Read-only access
+  [[nodiscard]] auto load(size_t frameIdx) const -> std::shared_ptr<const Common::DeepFrameList>;
+
+  [[nodiscard]] auto memoryLimit() const noexcept { return m_memoryLimit; }
+  [[nodiscard]] auto residentBytes() const -> size_t;
+  [[nodiscard]] auto peakResidentBytes() const -> size_t;
+  [[nodiscard]] auto spilledFrameCount() const -> size_t;
+  [[nodiscard]] auto spillFileBytes() const -> size_t;
+
+  // The number of frames that can be held at the same time without exceeding the memory limit
+  // (at least one), or the number of frames when there is no memory limit
+  [[nodiscard]] auto frameCapacity() const -> size_t;
+
+private:
+  struct Entry {
+    std::shared_ptr<Common::DeepFrameList> frame;
+    std::optional<std::streamoff> position;
+    size_t spillBytes{};
+    size_t bytes{};
+    bool dirty{};
+    uint64_t lastUse{};
+  };
+
+  auto acquire(size_t frameIdx, bool modify) const -> std::shared_ptr<Common::DeepFrameList>;
+  void makeResident(size_t frameIdx, std::shared_ptr<Common::DeepFrameList> frame) const;
+  void evict(size_t keepIdx) const;
+  void spill(Entry &entry) const;
+  auto restore(std::streamoff position) const -> Common::DeepFrameList;
+  void addResidentBytes(size_t bytes) const;
+  void subtractResidentBytes(size_t bytes) const;
+
+  std::optional<size_t> m_memoryLimit;
+  std::shared_ptr<ResidentBytes> m_sharedBytes;
+  mutable std::filesystem::path m_spillPath;
+  mutable std::mutex m_mutex;
+  mutable std::fstream m_spillFile;
+  mutable std::vector<Entry> m_entries;
+  mutable size_t m_residentBytes{};
+  mutable size_t m_peakResidentBytes{};
+  mutable uint64_t m_useCounter{};
+};
+} // namespace TMIV::Encoder
+
+#endif
@@ -0,0 +1,223 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "TransportViewBuffer.h"
+
+#include <TMIV/Common/Thread.h>
+
+namespace {
+auto makeFrame(uint16_t value) {
+  auto view = TMIV::Common::DeepFrame{TMIV::Common::Frame<>::yuv420({8, 4}, 10),
+                                      TMIV::Common::Frame<>::lumaOnly({8, 4}, 16)};
+  view.texture.fillValue(value);
+  view.geometry.fillValue(static_cast<uint16_t>(value + 1));
+  view.occupancy = TMIV::Common::Frame<bool>::lumaOnly({8, 4}, 1);
+  view.occupancy.getPlane(0)(1, 2) = value % 2 == 1;
+  return TMIV::Common::DeepFrameList{view, view};
+}
+
+template <typename Element>
+auto samePlanes(const TMIV::Common::Frame<Element> &a, const TMIV::Common::Frame<Element> &b) {
+  return a.getPlanes().size() == b.getPlanes().size() &&
+         std::equal(a.getPlanes().cbegin(), a.getPlanes().cend(), b.getPlanes().cbegin(),
+                    [](const auto &x, const auto &y) {
+                      return x.sizes() == y.sizes() && std::equal(x.cbegin(), x.cend(), y.cbegin());
+                    });
+}
+
+auto sameFrame(const TMIV::Common::DeepFrameList &a, const TMIV::Common::DeepFrameList &b) {
+  return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), [](const auto &x, const auto &y) {
+    return samePlanes(x.texture, y.texture) && samePlanes(x.geometry, y.geometry) &&
+           samePlanes(x.entities, y.entities) && samePlanes(x.occupancy, y.occupancy) &&
+           x.texture.getBitDepth() == y.texture.getBitDepth() &&
+           x.geometry.getBitDepth() == y.geometry.getBitDepth();
+  });
+}
+
+// 2 views with a 10-bit 8x4 YUV 4:2:0 texture, a 8x4 geometry and a 8x4 occupancy map
+constexpr auto frameBytes = size_t{2 * (96 + 64 + 32)};
+} // namespace
+
+SCENARIO("Transport view buffer") {
+  GIVEN("A buffer without a memory limit") {
+    auto unit = TMIV::Encoder::TransportViewBuffer{};
+
+    WHEN("Pushing frames") {
+      for (uint16_t i = 0; i < 4; ++i) {
+        unit.push_back(makeFrame(i));
+      }
+
+      THEN("All frames are resident") {
+        REQUIRE(unit.size() == 4);
+        REQUIRE(unit.residentBytes() == 4 * frameBytes);
+        REQUIRE(unit.peakResidentBytes() == 4 * frameBytes);
+        REQUIRE(unit.spilledFrameCount() == 0);
+        REQUIRE(unit.frameCapacity() == 4);
+        REQUIRE((*unit.load(2))[1].texture.getPlane(1)(0, 0) == 2);
+      }
+
+      AND_WHEN("Releasing a frame") {
+        unit.release(1);
+
+        THEN("It is no longer resident") {
+          REQUIRE(unit.residentBytes() == 3 * frameBytes);
+          REQUIRE_THROWS(unit.load(1));
+        }
+
+        THEN("A failing load in a parallel loop reaches the caller") {
+          // Like Encoder::Impl::constructVideoFrames()
+          REQUIRE_THROWS(TMIV::Common::parallel_for(unit.size(), [&unit](size_t i) {
+            const auto frame = unit.load(i);
+            unit.release(i);
+          }));
+        }
+      }
+    }
+  }
+
+  GIVEN("A buffer with a memory limit of two frames") {
+    auto unit = TMIV::Encoder::TransportViewBuffer{2 * frameBytes};
+
+    WHEN("Pushing frames") {
+      for (uint16_t i = 0; i < 5; ++i) {
+        unit.push_back(makeFrame(i));
+      }
+
+      THEN("The least recently used frames are spilled") {
+        REQUIRE(unit.size() == 5);
+        REQUIRE(unit.spilledFrameCount() == 3);
+        REQUIRE(unit.peakResidentBytes() == 3 * frameBytes);
+        REQUIRE(unit.residentBytes() <= 2 * frameBytes);
+        REQUIRE(unit.frameCapacity() == 2);
+      }
+
+      THEN("Spilled frames are read back unmodified") {
+        for (uint16_t i = 0; i < 5; ++i) {
+          const auto frame = unit.load(i);
+          REQUIRE(sameFrame(*frame, makeFrame(i)));
+        }
+      }
+
+      THEN("Modifications of spilled frames are preserved") {
+        (*unit.modify(0))[1].geometry.getPlane(0)(3, 7) = 1000;
+
+        for (size_t i = 1; i < 5; ++i) {
+          REQUIRE(unit.load(i)->size() == 2);
+        }
+        REQUIRE(unit.spilledFrameCount() == 3);
+
+        const auto frame0 = unit.load(0);
+        REQUIRE((*frame0)[1].geometry.getPlane(0)(3, 7) == 1000);
+        REQUIRE((*frame0)[0].geometry.getPlane(0)(3, 7) == 1);
+      }
+
+      THEN("Loaded frames stay resident while they are held") {
+        const auto frame0 = unit.load(0);
+        const auto frame1 = unit.load(1);
+        const auto frame2 = unit.load(2);
+
+        REQUIRE(unit.residentBytes() >= 3 * frameBytes);
+        REQUIRE((*frame0)[0].texture.getPlane(0)(0, 0) == 0);
+        REQUIRE((*frame1)[0].texture.getPlane(0)(0, 0) == 1);
+        REQUIRE((*frame2)[0].texture.getPlane(0)(0, 0) == 2);
+      }
+
+      THEN("Modified frames stay resident while they are held") {
+        const auto frame0 = unit.modify(0);
+
+        for (size_t i = 1; i < 5; ++i) {
+          REQUIRE(unit.load(i)->size() == 2);
+        }
+        (*frame0)[0].texture.getPlane(0)(0, 0) = 7;
+        REQUIRE(unit.spilledFrameCount() == 3);
+        REQUIRE((*unit.load(0))[0].texture.getPlane(0)(0, 0) == 7);
+      }
+
+      THEN("Modified frames that are spilled again reuse their position in the spill file") {
+        const auto modifyAll = [&unit](uint16_t k) {
+          for (size_t i = 0; i < 5; ++i) {
+            (*unit.modify(i))[0].texture.getPlane(0)(0, 0) = static_cast<uint16_t>(10 * k + i);
+          }
+        };
+
+        // After the first round every frame has a position in the spill file
+        modifyAll(0);
+        const auto spillFileBytes = unit.spillFileBytes();
+        REQUIRE(spillFileBytes > 0);
+
+        for (uint16_t k = 1; k < 10; ++k) {
+          modifyAll(k);
+        }
+        REQUIRE(unit.spillFileBytes() == spillFileBytes);
+
+        for (size_t i = 0; i < 5; ++i) {
+          const auto frame = unit.load(i);
+          REQUIRE((*frame)[0].texture.getPlane(0)(0, 0) == 90 + i);
+          REQUIRE((*frame)[1].geometry.getPlane(0)(0, 0) == i + 1);
+        }
+      }
+    }
+  }
+
+  GIVEN("Two buffers that share their resident bytes") {
+    const auto sharedBytes = std::make_shared<TMIV::Encoder::ResidentBytes>();
+    auto first = TMIV::Encoder::TransportViewBuffer{std::nullopt, sharedBytes};
+    auto second = TMIV::Encoder::TransportViewBuffer{2 * frameBytes, sharedBytes};
+
+    WHEN("Frames are pushed to one buffer while the other one is drained") {
+      for (uint16_t i = 0; i < 3; ++i) {
+        first.push_back(makeFrame(i));
+      }
+      for (uint16_t i = 0; i < 3; ++i) {
+        second.push_back(makeFrame(i));
+        first.release(i);
+      }
+
+      THEN("The peak is that of the bytes that were resident at the same time") {
+        REQUIRE(first.peakResidentBytes() == 3 * frameBytes);
+        REQUIRE(second.peakResidentBytes() == 3 * frameBytes);
+        REQUIRE(sharedBytes->current() == first.residentBytes() + second.residentBytes());
+        REQUIRE(sharedBytes->peak() == 4 * frameBytes);
+      }
+
+      AND_WHEN("Clearing both buffers") {
+        first.clear();
+        second.clear();
+
+        THEN("Nothing is resident") { REQUIRE(sharedBytes->current() == 0); }
+      }
+    }
+  }
+}
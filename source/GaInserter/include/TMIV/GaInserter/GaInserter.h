@@ -50,6 +50,10 @@ public:
 
   void parseV3cSampleStream(std::istream &stream);
 
+  // Stream the bitstream to the recoded output without the HLS log. V3C units are copied
+  // byte-for-byte, except for the atlas data in which the SEI messages are inserted.
+  void rewriteV3cSampleStream(std::istream &stream);
+
 private:
   class Impl;
 
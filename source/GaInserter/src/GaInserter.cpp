@@ -35,6 +35,7 @@
 
 #include <TMIV/Common/Bytestream.h>
 #include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/verify.h>
 #include <TMIV/MivBitstream/AccessUnitDelimiterRBSP.h>
 #include <TMIV/MivBitstream/AtlasAdaptationParameterSetRBSP.h>
 #include <TMIV/MivBitstream/AtlasFrameParameterSetRBSP.h>
@@ -46,6 +47,8 @@
 #include <TMIV/MivBitstream/V3cSampleStreamFormat.h>
 #include <TMIV/MivBitstream/V3cUnit.h>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 
 using namespace std::string_view_literals;
@@ -74,7 +77,59 @@ public:
     m_log << '\n' << std::string(100, '=') << '\n';
   }
 
+  void rewriteV3cSampleStream(std::istream &stream) {
+    PRECONDITION(m_recoded != nullptr);
+
+    const auto ssvh = MivBitstream::SampleStreamV3cHeader::decodeFrom(stream);
+    ssvh.encodeTo(*m_recoded);
+    const auto precisionBytes = ssvh.ssvh_unit_size_precision_bytes_minus1() + size_t{1};
+
+    while (stream.peek(), !stream.eof()) {
+      const auto ssvu_v3c_unit_size = Common::readBytes(stream, precisionBytes);
+      VERIFY_V3CBITSTREAM(v3cUnitHeaderBytes <= ssvu_v3c_unit_size);
+
+      const auto vuhBytes = Common::readString(stream, v3cUnitHeaderBytes);
+      auto vuhStream = std::istringstream{vuhBytes};
+      const auto vuh = MivBitstream::V3cUnitHeader::decodeFrom(vuhStream);
+
+      if (insertsSei(vuh)) {
+        // Only this V3C unit is decoded and re-encoded
+        const auto unitBytes =
+            vuhBytes + Common::readString(stream, static_cast<size_t>(ssvu_v3c_unit_size) -
+                                                      v3cUnitHeaderBytes);
+        auto unitStream = std::istringstream{unitBytes};
+        auto asb = MivBitstream::V3cUnit::decodeFrom(unitStream, unitBytes.size())
+                       .v3c_unit_payload()
+                       .atlas_sub_bitstream();
+        asb.nal_units().push_back(takeSeiNalUnit());
+
+        std::ostringstream substream;
+        MivBitstream::V3cUnit{vuh, std::move(asb)}.encodeTo(substream);
+        MivBitstream::SampleStreamV3cUnit{substream.str()}.encodeTo(*m_recoded, ssvh);
+      } else {
+        Common::writeBytes(*m_recoded, ssvu_v3c_unit_size, precisionBytes);
+        m_recoded->write(vuhBytes.data(), static_cast<std::streamsize>(vuhBytes.size()));
+        copyBytes(stream, ssvu_v3c_unit_size - v3cUnitHeaderBytes);
+      }
+    }
+  }
+
 private:
+  static constexpr auto v3cUnitHeaderBytes = size_t{4};
+
+  // Copy through a fixed-size buffer to keep memory use independent of the V3C unit size
+  void copyBytes(std::istream &stream, uint64_t count) {
+    auto buffer = std::array<char, 0x10000>{};
+
+    while (0 < count) {
+      const auto chunkSize = static_cast<std::streamsize>(std::min<uint64_t>(count, buffer.size()));
+      stream.read(buffer.data(), chunkSize);
+      VERIFY_V3CBITSTREAM(stream.gcount() == chunkSize);
+      m_recoded->write(buffer.data(), chunkSize);
+      count -= static_cast<uint64_t>(chunkSize);
+    }
+  }
+
   void parseV3cUnit(std::istream &stream, size_t numBytesInV3CUnit) {
     auto vu = MivBitstream::V3cUnit::decodeFrom(stream, numBytesInV3CUnit);
     m_log << vu.v3c_unit_header();
@@ -108,23 +163,9 @@ private:
     for (const auto &nu : asb.nal_units()) {
       parseNalUnit(nu);
     }
-    if (!m_seiJsons.empty() && m_vuh.value().vuh_unit_type() == MivBitstream::VuhUnitType::V3C_AD) {
-      m_log << "*** inserting " << m_seiJsons.size() << " SEI messages\n";
-      std::vector<MivBitstream::SeiMessage> seiMessages;
-      for (auto &seiJson : m_seiJsons) {
-        seiMessages.emplace_back(
-            MivBitstream::PayloadType::geometry_assistance,
-            MivBitstream::SeiPayload{MivBitstream::GeometryAssistance::readFrom(seiJson)});
-      }
-      m_seiJsons.clear(); // only insert frames into first atlas for testing.
-
-      MivBitstream::SeiRBSP seiRbsp{std::move(seiMessages)};
-      std::ostringstream subStream;
-
-      static constexpr auto nut = MivBitstream::NalUnitType::NAL_PREFIX_NSEI;
-      seiRbsp.encodeTo(subStream, nut);
+    if (insertsSei(*m_vuh)) {
       auto asb_copy = asb;
-      asb_copy.nal_units().emplace_back(MivBitstream::NalUnitHeader{nut, 0, 1}, subStream.str());
+      asb_copy.nal_units().push_back(takeSeiNalUnit());
 
       const auto vu = MivBitstream::V3cUnit{*m_vuh, asb_copy};
       vu.encodeTo(m_substream);
@@ -134,6 +175,28 @@ private:
     }
   }
 
+  [[nodiscard]] auto insertsSei(const MivBitstream::V3cUnitHeader &vuh) const -> bool {
+    return !m_seiJsons.empty() && vuh.vuh_unit_type() == MivBitstream::VuhUnitType::V3C_AD;
+  }
+
+  auto takeSeiNalUnit() -> MivBitstream::NalUnit {
+    m_log << "*** inserting " << m_seiJsons.size() << " SEI messages\n";
+    std::vector<MivBitstream::SeiMessage> seiMessages;
+    for (auto &seiJson : m_seiJsons) {
+      seiMessages.emplace_back(
+          MivBitstream::PayloadType::geometry_assistance,
+          MivBitstream::SeiPayload{MivBitstream::GeometryAssistance::readFrom(seiJson)});
+    }
+    m_seiJsons.clear(); // only insert frames into first atlas for testing.
+
+    MivBitstream::SeiRBSP seiRbsp{std::move(seiMessages)};
+    std::ostringstream subStream;
+
+    static constexpr auto nut = MivBitstream::NalUnitType::NAL_PREFIX_NSEI;
+    seiRbsp.encodeTo(subStream, nut);
+    return MivBitstream::NalUnit{MivBitstream::NalUnitHeader{nut, 0, 1}, subStream.str()};
+  }
+
   void parseV3cUnitPayload(const MivBitstream::VideoSubBitstream & /* unused */) {
     m_log << "videosubstream\n";
   }
@@ -266,4 +329,8 @@ GaInserter::~GaInserter() = default;
 void GaInserter::parseV3cSampleStream(std::istream &stream) {
   return m_impl->parseV3cSampleStream(stream);
 }
+
+void GaInserter::rewriteV3cSampleStream(std::istream &stream) {
+  return m_impl->rewriteV3cSampleStream(stream);
+}
 } // namespace TMIV::GaInserter
@@ -37,6 +37,7 @@
 #include <TMIV/Common/LoggingStrategyFmt.h>
 
 #include <fstream>
+#include <sstream>
 #include <vector>
 
 using namespace std::string_view_literals;
@@ -48,11 +49,15 @@ auto main(int argc, const char *argv[]) -> int32_t {
   try {
     const auto args = std::vector(argv, argv + argc);
 
-    if ((args.size() != 5 && args.size() != 7) || args[1] != "-b"sv || args[3] != "-o"sv ||
-        (args.size() == 7 && args[5] != "-nf"sv)) {
-      logInfo("Usage: GaInserter -b BITSTREAM -o HLS_LOG_FILE [-nf nframes]");
+    // With -r the bitstream is streamed to the output file without writing an HLS log
+    if ((args.size() != 5 && args.size() != 7) || args[1] != "-b"sv ||
+        (args[3] != "-o"sv && args[3] != "-r"sv) || (args.size() == 7 && args[5] != "-nf"sv)) {
+      logInfo("Usage: GaInserter -b BITSTREAM (-o HLS_LOG_FILE | -r RECODED_BITSTREAM) "
+              "[-nf nframes]");
       return 1;
     }
+    const auto streaming = args[3] == "-r"sv;
+
     std::ifstream inStream{args[2], std::ios::binary};
     if (!inStream.good()) {
       logError("Failed to open {} for reading.\n", args[2]);
@@ -74,6 +79,12 @@ auto main(int argc, const char *argv[]) -> int32_t {
       const auto json = TMIV::Common::Json::loadFrom(stream);
       seiJsons.emplace_back(json);
     }
+    if (streaming) {
+      std::ostringstream unusedLog;
+      TMIV::GaInserter::GaInserter gaInserter{unusedLog, &outStream, seiJsons};
+      gaInserter.rewriteV3cSampleStream(inStream);
+      return 0;
+    }
     std::ofstream recodedStream{"recoded.bit", std::ios::binary};
     TMIV::GaInserter::GaInserter gaInserter{outStream, &recodedStream, seiJsons};
     gaInserter.parseV3cSampleStream(inStream);
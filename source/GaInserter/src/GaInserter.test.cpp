@@ -215,6 +215,8 @@ auto createTestBitstream() {
 } // namespace test
 
 TEST_CASE("GaInserter") {
+#include "GaInserter.test.reference.hpp"
+
   SECTION("no insertion leaves bitstream unchanged") {
     std::istringstream inStream{test::createTestBitstream()};
     std::ostringstream logStream;
@@ -230,8 +232,6 @@ TEST_CASE("GaInserter") {
     std::ostringstream recodedStream;
     std::vector<TMIV::Common::Json> seiJsons;
 
-#include "GaInserter.test.reference.hpp"
-
     std::istringstream jStream0{srcJson0};
     const auto json0 = TMIV::Common::Json::loadFrom(jStream0);
     seiJsons.push_back(json0);
@@ -254,4 +254,41 @@ TEST_CASE("GaInserter") {
     REQUIRE(inStream.str() != recodedStream.str());
     REQUIRE(logStream.str() == insertedLog);
   }
+
+  SECTION("streaming rewrite without insertion copies the bitstream") {
+    std::istringstream inStream{test::createTestBitstream()};
+    std::ostringstream logStream;
+    std::ostringstream rewrittenStream;
+    std::vector<TMIV::Common::Json> seiJsons;
+    auto gaInserter = TMIV::GaInserter::GaInserter{logStream, &rewrittenStream, seiJsons};
+    gaInserter.rewriteV3cSampleStream(inStream);
+    REQUIRE(inStream.str() == rewrittenStream.str());
+  }
+  SECTION("streaming rewrite inserts the same frames as recoding") {
+    const auto loadSeiJsons = [&]() {
+      std::vector<TMIV::Common::Json> seiJsons;
+      for (const auto *srcJson : {srcJson0, srcJson1}) {
+        std::istringstream jStream{srcJson};
+        seiJsons.push_back(TMIV::Common::Json::loadFrom(jStream));
+      }
+      return seiJsons;
+    };
+
+    std::ostringstream logStream;
+
+    std::istringstream inStream1{test::createTestBitstream()};
+    std::ostringstream recodedStream;
+    auto seiJsons1 = loadSeiJsons();
+    auto gaInserter = TMIV::GaInserter::GaInserter{logStream, &recodedStream, seiJsons1};
+    gaInserter.parseV3cSampleStream(inStream1);
+
+    std::istringstream inStream2{test::createTestBitstream()};
+    std::ostringstream rewrittenStream;
+    auto seiJsons2 = loadSeiJsons();
+    auto gaRewriter = TMIV::GaInserter::GaInserter{logStream, &rewrittenStream, seiJsons2};
+    gaRewriter.rewriteV3cSampleStream(inStream2);
+
+    REQUIRE(inStream2.str() != rewrittenStream.str());
+    REQUIRE(recodedStream.str() == rewrittenStream.str());
+  }
 }
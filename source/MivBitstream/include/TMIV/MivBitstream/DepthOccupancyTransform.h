@@ -39,6 +39,8 @@
 
 #include <TMIV/Common/Frame.h>
 
+#include <memory>
+
 namespace TMIV::MivBitstream {
 // Extract the occupancy transform for the specified view [and patch]
 class OccupancyTransform {
@@ -78,6 +80,9 @@ public:
   // Expand a matrix of levels to depth [m]
   //
   // See also expandDepth(uint16_t)
+  //
+  // This is a table look-up per sample. The table is shared by all depth transforms with the same
+  // depth quantization parameters and bit depth.
   [[nodiscard]] auto expandDepth(const Common::Mat<> &matrix) const -> Common::Mat<float>;
 
   // Expand a frame of levels to depth [m]
@@ -109,6 +114,12 @@ public:
   [[nodiscard]] auto minNormDisp() const -> float;
 
 private:
+  struct ExpansionTable;
+
+  // Expand a level (after clamping to the patch depth range) to normalized disparity [m^-1]
+  [[nodiscard]] auto computeNormDisp(Common::SampleValue level) const -> float;
+  [[nodiscard]] auto expansionTable() const -> std::shared_ptr<const ExpansionTable>;
+
   float m_normDispLow{};
   float m_normDispHigh{};
   float m_minNormDisp{};
@@ -123,6 +134,8 @@ private:
   float m_normDispInterval{};
   float m_normDispMax{};
 #endif
+
+  std::shared_ptr<const ExpansionTable> m_table;
 };
 
 } // namespace TMIV::MivBitstream
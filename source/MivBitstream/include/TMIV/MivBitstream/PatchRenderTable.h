@@ -0,0 +1,103 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_MIVBITSTREAM_PATCHRENDERTABLE_H
+#define TMIV_MIVBITSTREAM_PATCHRENDERTABLE_H
+
+#include "PatchParamsList.h"
+#include "ViewParamsList.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace TMIV::MivBitstream {
+// Integer affine coordinate transformation (a x + b y + c, d x + e y + f) with coefficients
+// {a, b, c, d, e, f}, i.e. the upper two rows of PatchParams::atlasToViewTransform() or
+// PatchParams::viewToAtlasTransform()
+struct PatchAffineTransform {
+  std::array<int32_t, 6> m{};
+
+  [[nodiscard]] constexpr auto operator()(Common::Vec2i xy) const noexcept -> Common::Vec2i {
+    return {m[0] * xy[0] + m[1] * xy[1] + m[2], m[3] * xy[0] + m[4] * xy[1] + m[5]};
+  }
+};
+
+// The patch render table is a flat structure-of-arrays derived from a patch parameters list. It
+// is built once per atlas frame, and indexed by patch index (as in the block-to-patch map) from
+// per-sample loops of the pre-renderer and the synthesizers. Compared to PatchParams it avoids
+// optional fields, recomputing the coordinate transformations per sample and the view index
+// look-up through the view ID.
+struct PatchRenderTable {
+  PatchRenderTable() = default;
+  PatchRenderTable(const PatchParamsList &ppl, const ViewParamsList &vpl);
+
+  [[nodiscard]] auto size() const noexcept { return viewIdx.size(); }
+  [[nodiscard]] auto empty() const noexcept { return viewIdx.empty(); }
+
+  // Is the atlas position (x, y) inside the 2D bounding box of patch k?
+  [[nodiscard]] auto contains(size_t k, Common::Vec2i xy) const noexcept {
+    return pos2dX[k] <= xy[0] && xy[0] < pos2dX[k] + size2dX[k] && pos2dY[k] <= xy[1] &&
+           xy[1] < pos2dY[k] + size2dY[k];
+  }
+
+  // Equivalent to PatchParams::atlasToView
+  [[nodiscard]] auto atlasToView(size_t k, Common::Vec2i xy) const noexcept {
+    return atlasToViewTransform[k](xy);
+  }
+
+  // Equivalent to PatchParams::viewToAtlas, thus limited to patches without LoD scaling
+  [[nodiscard]] auto viewToAtlas(size_t k, Common::Vec2i uv) const noexcept {
+    LIMITATION(viewToAtlasDenominator[k] == 1);
+    return viewToAtlasTransform[k](uv);
+  }
+
+  std::vector<int32_t> pos2dX;
+  std::vector<int32_t> pos2dY;
+  std::vector<int32_t> size2dX;
+  std::vector<int32_t> size2dY;
+  std::vector<int32_t> offset3dU;
+  std::vector<int32_t> offset3dV;
+  std::vector<Common::SampleValue> offset3dD;
+  std::vector<Common::SampleValue> range3dD;
+  std::vector<FlexiblePatchOrientation> orientation;
+  std::vector<uint16_t> viewIdx; // index into the view parameters list
+  std::vector<Common::SampleValue> entityId;
+
+  std::vector<PatchAffineTransform> atlasToViewTransform;
+  std::vector<PatchAffineTransform> viewToAtlasTransform;
+  std::vector<int32_t> viewToAtlasDenominator; // lcm(lodX, lodY)
+};
+} // namespace TMIV::MivBitstream
+
+#endif
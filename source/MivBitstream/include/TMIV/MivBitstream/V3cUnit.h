@@ -42,6 +42,7 @@
 #include <cstdlib>
 #include <iosfwd>
 #include <string>
+#include <utility>
 #include <variant>
 
 namespace TMIV::MivBitstream {
@@ -115,8 +116,12 @@ public:
   [[nodiscard]] constexpr auto payload() const noexcept -> auto & { return m_payload; }
 
   [[nodiscard]] auto v3c_parameter_set() const noexcept -> const V3cParameterSet &;
-  [[nodiscard]] auto atlas_sub_bitstream() const noexcept -> const AtlasSubBitstream &;
-  [[nodiscard]] auto video_sub_bitstream() const noexcept -> const VideoSubBitstream &;
+  [[nodiscard]] auto atlas_sub_bitstream() const & noexcept -> const AtlasSubBitstream &;
+  [[nodiscard]] auto video_sub_bitstream() const & noexcept -> const VideoSubBitstream &;
+
+  // Move the sub-bitstream out of an expiring payload
+  [[nodiscard]] auto atlas_sub_bitstream() && noexcept -> AtlasSubBitstream &&;
+  [[nodiscard]] auto video_sub_bitstream() && noexcept -> VideoSubBitstream &&;
 
   friend auto operator<<(std::ostream &stream, const V3cUnitPayload &x) -> std::ostream &;
 
@@ -141,9 +146,12 @@ public:
   [[nodiscard]] constexpr auto v3c_unit_header() const noexcept -> auto & {
     return m_v3c_unit_header;
   }
-  [[nodiscard]] constexpr auto v3c_unit_payload() const noexcept -> auto & {
+  [[nodiscard]] constexpr auto v3c_unit_payload() const & noexcept -> auto & {
     return m_v3c_unit_payload;
   }
+  [[nodiscard]] constexpr auto v3c_unit_payload() && noexcept -> auto && {
+    return std::move(m_v3c_unit_payload);
+  }
 
   friend auto operator<<(std::ostream &stream, const V3cUnit &x) -> std::ostream &;
 
@@ -101,6 +101,10 @@ struct ViewParams {
 };
 
 // Vector of ViewParams with indexing of view ID
+//
+// The view ID index is a dense table that maps a view ID to a view index in constant time. It is
+// (re)built by constructViewIdIndex() and assignViewIds(). After any other change to the list, the
+// index has to be rebuilt with constructViewIdIndex(): indexOf() fails on a stale index.
 class ViewParamsList : public std::vector<ViewParams> {
 public:
   void constructViewIdIndex();
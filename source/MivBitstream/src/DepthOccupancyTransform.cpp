@@ -36,8 +36,25 @@
 #include <fmt/format.h>
 
 #include <cassert>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace TMIV::MivBitstream {
+namespace {
+// Limit the table size to 2^16 entries per transfer function
+constexpr auto maxTableBitDepth = 16U;
+
+// Limit the number of distinct transfer functions that are kept alive by the cache
+constexpr auto maxCachedTables = size_t{64};
+} // namespace
+
+// The expansion of each level in [0, maxLevel(bitDepth)], before clamping to a patch depth range
+struct DepthTransform::ExpansionTable {
+  std::vector<float> normDisp;
+  std::vector<float> depth;
+};
+
 DepthTransform::DepthTransform(const DepthQuantization &dq, uint32_t bitDepth)
     : m_normDispLow{dq.dq_norm_disp_low()}
     , m_normDispHigh{dq.dq_norm_disp_high()}
@@ -75,6 +92,8 @@ DepthTransform::DepthTransform(const DepthQuantization &dq, uint32_t bitDepth)
         (m_normDispMax - m_normDispMap[0]) / static_cast<float>(m_viewPivotCount + 1);
   }
 #endif
+
+  m_table = expansionTable();
 }
 
 DepthTransform::DepthTransform(const DepthQuantization &dq, const PatchParams &patchParams,
@@ -85,38 +104,40 @@ DepthTransform::DepthTransform(const DepthQuantization &dq, const PatchParams &p
 }
 
 auto DepthTransform::expandNormDisp(Common::SampleValue x) const -> float {
-  const auto level = Common::expandValue(std::clamp(x, m_depthStart, m_depthEnd), m_bitDepth);
+  const auto level = std::clamp(x, m_depthStart, m_depthEnd);
 
-#if ENABLE_M57419
-  if (m_quantizationLaw == 2) {
-    float normDisp = m_normDispLow + (m_normDispHigh - m_normDispLow) * level;
-
-    for (int32_t i = 0; i <= m_viewPivotCount; i++) {
-      if (normDisp <= m_normDispMap[i + 1]) {
-        const auto x1 = m_normDispMap[i];
-        const auto x2 = m_normDispMap[i + 1];
-        const auto mappedIntervalSize = x2 - x1;
-        float orgStartMap = m_normDispMap[0] + static_cast<float>(i) * m_normDispInterval;
-        normDisp = std::max(m_minNormDisp, orgStartMap + (normDisp - x1) * m_normDispInterval /
-                                                             mappedIntervalSize);
-        break;
-      }
-    }
-    return normDisp;
+  if (m_table && level < m_table->normDisp.size()) {
+    return m_table->normDisp[level];
   }
-#endif
-
-  return std::max(m_minNormDisp, m_normDispLow + (m_normDispHigh - m_normDispLow) * level);
+  return computeNormDisp(level);
 }
 
 auto DepthTransform::expandDepth(Common::SampleValue x) const -> float {
-  return 1.F / expandNormDisp(x);
+  const auto level = std::clamp(x, m_depthStart, m_depthEnd);
+
+  if (m_table && level < m_table->depth.size()) {
+    return m_table->depth[level];
+  }
+  return 1.F / computeNormDisp(level);
 }
 
 auto DepthTransform::expandDepth(const Common::Mat<> &matrix) const -> Common::Mat<float> {
   auto depth = Common::Mat<float>(matrix.sizes());
-  std::transform(std::begin(matrix), std::end(matrix), std::begin(depth),
-                 [this](auto x) { return expandDepth(x); });
+
+  if (!m_table) {
+    std::transform(std::begin(matrix), std::end(matrix), std::begin(depth),
+                   [this](auto x) { return 1.F / computeNormDisp(std::clamp<Common::SampleValue>(
+                                                     x, m_depthStart, m_depthEnd)); });
+    return depth;
+  }
+
+  const auto *const table = m_table->depth.data();
+  const auto tableSize = m_table->depth.size();
+
+  std::transform(std::begin(matrix), std::end(matrix), std::begin(depth), [=](auto x) {
+    const auto level = std::clamp<Common::SampleValue>(x, m_depthStart, m_depthEnd);
+    return level < tableSize ? table[level] : 1.F / computeNormDisp(level);
+  });
   return depth;
 }
 
@@ -157,4 +178,69 @@ auto DepthTransform::quantizeNormDisp(float x, Common::SampleValue minLevel) con
 }
 
 auto DepthTransform::minNormDisp() const -> float { return m_minNormDisp; }
+
+auto DepthTransform::computeNormDisp(Common::SampleValue level) const -> float {
+  const auto x = Common::expandValue(level, m_bitDepth);
+
+#if ENABLE_M57419
+  if (m_quantizationLaw == 2) {
+    float normDisp = m_normDispLow + (m_normDispHigh - m_normDispLow) * x;
+
+    for (int32_t i = 0; i <= m_viewPivotCount; i++) {
+      if (normDisp <= m_normDispMap[i + 1]) {
+        const auto x1 = m_normDispMap[i];
+        const auto x2 = m_normDispMap[i + 1];
+        const auto mappedIntervalSize = x2 - x1;
+        float orgStartMap = m_normDispMap[0] + static_cast<float>(i) * m_normDispInterval;
+        normDisp = std::max(m_minNormDisp, orgStartMap + (normDisp - x1) * m_normDispInterval /
+                                                             mappedIntervalSize);
+        break;
+      }
+    }
+    return normDisp;
+  }
+#endif
+
+  return std::max(m_minNormDisp, m_normDispLow + (m_normDispHigh - m_normDispLow) * x);
+}
+
+auto DepthTransform::expansionTable() const -> std::shared_ptr<const ExpansionTable> {
+  if (m_bitDepth == 0 || maxTableBitDepth < m_bitDepth) {
+    return {};
+  }
+
+  // The table only depends on the transfer function, not on the patch depth range
+  using Key = std::tuple<float, float, uint32_t, std::vector<float>>;
+  auto key = Key{m_normDispLow, m_normDispHigh, m_bitDepth, {}};
+#if ENABLE_M57419
+  if (m_quantizationLaw == 2) {
+    std::get<3>(key) = m_normDispMap;
+  }
+#endif
+
+  static std::mutex mutex;
+  static std::map<Key, std::shared_ptr<const ExpansionTable>> cache;
+
+  const auto lock = std::lock_guard{mutex};
+
+  if (const auto entry = cache.find(key); entry != cache.cend()) {
+    return entry->second;
+  }
+
+  auto table = std::make_shared<ExpansionTable>();
+  const auto size = size_t{Common::maxLevel(m_bitDepth)} + 1;
+  table->normDisp.reserve(size);
+  table->depth.reserve(size);
+
+  for (Common::SampleValue level = 0; level < size; ++level) {
+    const auto normDisp = computeNormDisp(level);
+    table->normDisp.push_back(normDisp);
+    table->depth.push_back(1.F / normDisp);
+  }
+
+  if (maxCachedTables <= cache.size()) {
+    cache.clear();
+  }
+  return cache.emplace(std::move(key), std::move(table)).first->second;
+}
 } // namespace TMIV::MivBitstream
\ No newline at end of file
@@ -283,6 +283,40 @@ TEST_CASE("DepthTransform") {
     }
   }
 
+  SECTION("Expansion of all levels matches the transfer function exactly") {
+    const auto bitDepth = GENERATE(1U, 10U, 16U);
+    const auto maxLevel = TMIV::Common::maxLevel(bitDepth);
+
+    auto dq = DepthQuantization{};
+    dq.dq_norm_disp_low(0.2F);
+    dq.dq_norm_disp_high(4.F);
+
+    auto pp = PatchParams{};
+    pp.atlasPatch3dOffsetD(maxLevel / 4);
+    pp.atlasPatch3dRangeD(maxLevel / 2);
+
+    const auto perView = DepthTransform{dq, bitDepth};
+    const auto perPatch = DepthTransform{dq, pp, bitDepth};
+
+    auto frame = TMIV::Common::Frame<>::lumaOnly({static_cast<int32_t>(maxLevel) + 1, 1}, bitDepth);
+    std::iota(frame.getPlane(0).begin(), frame.getPlane(0).end(), uint16_t{});
+
+    const auto perViewDepth = perView.expandDepth(frame);
+    const auto perPatchDepth = perPatch.expandDepth(frame);
+
+    for (uint32_t x = 0; x <= maxLevel; ++x) {
+      const auto level = TMIV::Common::expandValue(x, bitDepth);
+      const auto normDisp = std::max(perView.minNormDisp(), 0.2F + (4.F - 0.2F) * level);
+      REQUIRE(perView.expandNormDisp(x) == normDisp);
+      REQUIRE(perView.expandDepth(x) == 1.F / normDisp);
+      REQUIRE(perViewDepth[x] == 1.F / normDisp);
+
+      const auto y = std::clamp(x, maxLevel / 4, maxLevel / 4 + maxLevel / 2);
+      REQUIRE(perPatch.expandNormDisp(x) == perView.expandNormDisp(y));
+      REQUIRE(perPatchDepth[x] == perView.expandDepth(y));
+    }
+  }
+
   SECTION("Quantize normalized disparity [m^-1] to a level") {
     const auto normDispLow = GENERATE(-2.F, 3.F);
     const auto normDispHigh = GENERATE(5.F, 7.F);
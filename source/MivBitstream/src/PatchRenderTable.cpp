@@ -0,0 +1,77 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TMIV/MivBitstream/PatchRenderTable.h>
+
+namespace TMIV::MivBitstream {
+namespace {
+auto affineTransform(const Common::Mat3x3i &m) noexcept {
+  return PatchAffineTransform{{m(0, 0), m(0, 1), m(0, 2), m(1, 0), m(1, 1), m(1, 2)}};
+}
+} // namespace
+
+PatchRenderTable::PatchRenderTable(const PatchParamsList &ppl, const ViewParamsList &vpl) {
+  const auto n = ppl.size();
+
+  for (auto *v : {&pos2dX, &pos2dY, &size2dX, &size2dY, &offset3dU, &offset3dV,
+                  &viewToAtlasDenominator}) {
+    v->reserve(n);
+  }
+  for (auto *v : {&offset3dD, &range3dD, &entityId}) {
+    v->reserve(n);
+  }
+  orientation.reserve(n);
+  viewIdx.reserve(n);
+  atlasToViewTransform.reserve(n);
+  viewToAtlasTransform.reserve(n);
+
+  for (const auto &pp : ppl) {
+    pos2dX.push_back(pp.atlasPatch2dPosX());
+    pos2dY.push_back(pp.atlasPatch2dPosY());
+    size2dX.push_back(pp.atlasPatch2dSizeX());
+    size2dY.push_back(pp.atlasPatch2dSizeY());
+    offset3dU.push_back(pp.atlasPatch3dOffsetU());
+    offset3dV.push_back(pp.atlasPatch3dOffsetV());
+    offset3dD.push_back(pp.atlasPatch3dOffsetD());
+    range3dD.push_back(pp.atlasPatch3dRangeD());
+    orientation.push_back(pp.atlasPatchOrientationIndex());
+    viewIdx.push_back(vpl.indexOf(pp.atlasPatchProjectionId()));
+    entityId.push_back(pp.atlasPatchEntityId());
+
+    const auto invM = pp.viewToAtlasTransform();
+    atlasToViewTransform.push_back(affineTransform(pp.atlasToViewTransform()));
+    viewToAtlasTransform.push_back(affineTransform(invM));
+    viewToAtlasDenominator.push_back(invM(2, 2));
+  }
+}
+} // namespace TMIV::MivBitstream
@@ -0,0 +1,143 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/MivBitstream/PatchRenderTable.h>
+
+using TMIV::Common::Vec2i;
+using TMIV::MivBitstream::FlexiblePatchOrientation;
+using TMIV::MivBitstream::PatchParams;
+using TMIV::MivBitstream::PatchParamsList;
+using TMIV::MivBitstream::PatchRenderTable;
+using TMIV::MivBitstream::ViewId;
+using TMIV::MivBitstream::ViewParamsList;
+
+TEST_CASE("TMIV::MivBitstream::PatchRenderTable") {
+  auto vpl = ViewParamsList{};
+  vpl.emplace_back().viewId = ViewId{3};
+  vpl.emplace_back().viewId = ViewId{1};
+  vpl.constructViewIdIndex();
+
+  SECTION("Default construction") {
+    const auto unit = PatchRenderTable{};
+    CHECK(unit.empty());
+    CHECK(unit.size() == 0);
+  }
+
+  SECTION("Per-patch fields") {
+    auto ppl = PatchParamsList(2);
+    ppl[0]
+        .atlasPatch2dPosX(8)
+        .atlasPatch2dPosY(16)
+        .atlasPatch2dSizeX(32)
+        .atlasPatch2dSizeY(24)
+        .atlasPatch3dOffsetU(5)
+        .atlasPatch3dOffsetV(7)
+        .atlasPatch3dOffsetD(11)
+        .atlasPatch3dRangeD(100)
+        .atlasPatchProjectionId(ViewId{1})
+        .atlasPatchOrientationIndex(FlexiblePatchOrientation::FPO_ROT90)
+        .atlasPatchEntityId(4);
+    ppl[1]
+        .atlasPatchProjectionId(ViewId{3})
+        .atlasPatchOrientationIndex(FlexiblePatchOrientation::FPO_NULL);
+
+    const auto unit = PatchRenderTable{ppl, vpl};
+
+    REQUIRE(unit.size() == 2);
+    CHECK(unit.pos2dX[0] == 8);
+    CHECK(unit.pos2dY[0] == 16);
+    CHECK(unit.size2dX[0] == 32);
+    CHECK(unit.size2dY[0] == 24);
+    CHECK(unit.offset3dU[0] == 5);
+    CHECK(unit.offset3dV[0] == 7);
+    CHECK(unit.offset3dD[0] == 11);
+    CHECK(unit.range3dD[0] == 100);
+    CHECK(unit.orientation[0] == FlexiblePatchOrientation::FPO_ROT90);
+    CHECK(unit.entityId[0] == 4);
+    CHECK(unit.viewIdx[0] == 1);
+    CHECK(unit.viewIdx[1] == 0);
+
+    CHECK(unit.contains(0, {8, 16}));
+    CHECK(unit.contains(0, {39, 39}));
+    CHECK_FALSE(unit.contains(0, {40, 39}));
+    CHECK_FALSE(unit.contains(0, {39, 40}));
+    CHECK_FALSE(unit.contains(0, {7, 16}));
+  }
+
+  SECTION("Coordinate transformations match PatchParams") {
+    const auto orientation =
+        GENERATE(FlexiblePatchOrientation::FPO_NULL, FlexiblePatchOrientation::FPO_SWAP,
+                 FlexiblePatchOrientation::FPO_ROT90, FlexiblePatchOrientation::FPO_ROT180,
+                 FlexiblePatchOrientation::FPO_ROT270, FlexiblePatchOrientation::FPO_MIRROR,
+                 FlexiblePatchOrientation::FPO_MROT90, FlexiblePatchOrientation::FPO_MROT180);
+    const auto lodX = GENERATE(1, 2);
+    const auto lodY = GENERATE(1, 3);
+    CAPTURE(orientation, lodX, lodY);
+
+    auto ppl = PatchParamsList(1);
+    ppl[0]
+        .atlasPatch2dPosX(19)
+        .atlasPatch2dPosY(3)
+        .atlasPatch2dSizeX(16)
+        .atlasPatch2dSizeY(23)
+        .atlasPatch3dOffsetU(5)
+        .atlasPatch3dOffsetV(45)
+        .atlasPatchProjectionId(ViewId{3})
+        .atlasPatchOrientationIndex(orientation)
+        .atlasPatchLoDScaleX(lodX)
+        .atlasPatchLoDScaleY(lodY);
+    const auto &pp = ppl.front();
+
+    const auto unit = PatchRenderTable{ppl, vpl};
+    REQUIRE(unit.size() == 1);
+
+    for (int32_t y = 3; y < 3 + 23; ++y) {
+      for (int32_t x = 19; x < 19 + 16; ++x) {
+        REQUIRE(unit.atlasToView(0, {x, y}) == pp.atlasToView({x, y}));
+      }
+    }
+
+    const auto invM = pp.viewToAtlasTransform();
+    CHECK(unit.viewToAtlasDenominator[0] == invM(2, 2));
+
+    for (const auto uv : {Vec2i{13, 16}, Vec2i{78, 17}}) {
+      REQUIRE(unit.viewToAtlasTransform[0](uv) == PatchParams::atlasToView(uv, invM));
+
+      if (lodX == 1 && lodY == 1) {
+        REQUIRE(unit.viewToAtlas(0, uv) == pp.viewToAtlas(uv));
+      }
+    }
+  }
+}
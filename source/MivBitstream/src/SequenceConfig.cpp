@@ -217,7 +217,6 @@ auto SequenceConfig::sourceViewParams() const -> ViewParamsList {
   std::transform(sourceCameraNames.cbegin(), sourceCameraNames.cend(), std::back_inserter(vpl),
                  [this](const std::string &name) { return cameraByName(name).viewParams; });
   vpl.assignViewIds(sourceCameraIds);
-  vpl.constructViewIdIndex();
   return ViewParamsList{vpl};
 }
 
@@ -162,16 +162,26 @@ auto V3cUnitPayload::v3c_parameter_set() const noexcept -> const V3cParameterSet
   return *std::get_if<V3cParameterSet>(&m_payload);
 }
 
-auto V3cUnitPayload::atlas_sub_bitstream() const noexcept -> const AtlasSubBitstream & {
+auto V3cUnitPayload::atlas_sub_bitstream() const & noexcept -> const AtlasSubBitstream & {
   PRECONDITION(std::holds_alternative<AtlasSubBitstream>(m_payload));
   return *std::get_if<AtlasSubBitstream>(&m_payload);
 }
 
-auto V3cUnitPayload::video_sub_bitstream() const noexcept -> const VideoSubBitstream & {
+auto V3cUnitPayload::video_sub_bitstream() const & noexcept -> const VideoSubBitstream & {
   PRECONDITION(std::holds_alternative<VideoSubBitstream>(m_payload));
   return *std::get_if<VideoSubBitstream>(&m_payload);
 }
 
+auto V3cUnitPayload::atlas_sub_bitstream() && noexcept -> AtlasSubBitstream && {
+  PRECONDITION(std::holds_alternative<AtlasSubBitstream>(m_payload));
+  return std::move(*std::get_if<AtlasSubBitstream>(&m_payload));
+}
+
+auto V3cUnitPayload::video_sub_bitstream() && noexcept -> VideoSubBitstream && {
+  PRECONDITION(std::holds_alternative<VideoSubBitstream>(m_payload));
+  return std::move(*std::get_if<VideoSubBitstream>(&m_payload));
+}
+
 auto operator<<(std::ostream &stream, const V3cUnitPayload &x) -> std::ostream & {
   visit(overload([&](const std::monostate & /* unused */) { stream << "[unknown]\n"; },
                  [&](const auto &payload) { stream << payload; }),
@@ -232,6 +232,11 @@ auto ViewParams::viewParentIdx(uint16_t i) const -> uint16_t {
 }
 
 void ViewParamsList::constructViewIdIndex() {
+  if (empty()) {
+    m_viewIdIndex.clear();
+    return;
+  }
+
   // Test for duplicate ID's
   auto usedSlot = std::vector<bool>(maxViewIdValue() + size_t{1}, false);
 
@@ -257,6 +262,8 @@ void ViewParamsList::assignViewIds(vector<uint16_t> sourceCameraIds) {
       vp.viewId = ViewId{sourceCameraIds[viewIdx++]};
     }
   }
+
+  constructViewIdIndex();
 }
 
 auto ViewParamsList::maxViewIdValue() const noexcept -> uint16_t {
@@ -232,3 +232,37 @@ TEST_CASE("ViewParams") {
     REQUIRE(unit.dq.dq_norm_disp_high() == 0.F);
   }
 }
+
+TEST_CASE("ViewParamsList") {
+  using TMIV::MivBitstream::ViewId;
+
+  auto unit = TMIV::MivBitstream::ViewParamsList{};
+  unit.resize(3);
+
+  SECTION("assignViewIds constructs the view ID index") {
+    unit.assignViewIds({7, 2, 5});
+
+    REQUIRE(unit.indexOf(ViewId{7}) == 0);
+    REQUIRE(unit.indexOf(ViewId{2}) == 1);
+    REQUIRE(unit.indexOf(ViewId{5}) == 2);
+    REQUIRE_THROWS(unit.indexOf(ViewId{3}));
+    REQUIRE_THROWS(unit.indexOf(ViewId{8}));
+  }
+
+  SECTION("A stale view ID index is detected") {
+    unit.assignViewIds({});
+    unit[1].viewId = ViewId{9};
+
+    REQUIRE_THROWS(unit.indexOf(ViewId{1}));
+
+    unit.constructViewIdIndex();
+    REQUIRE(unit.indexOf(ViewId{9}) == 1);
+  }
+
+  SECTION("The index of an empty list is empty") {
+    unit.clear();
+    unit.constructViewIdIndex();
+
+    REQUIRE_THROWS(unit.indexOf(ViewId{0}));
+  }
+}
@@ -87,6 +87,7 @@ struct Attribute {
 // made of 2 uint16_t and 1 pointer. The former calculus now gives 4500 x 3500 x 32 x (2 x 2 +
 // 8) = 4.32GB i.e. more than 4GB saved. Smarter implementation to save even more memory could be
 // envisioned (with look-up tables), but you would lose in usability from my point of view.
+// For read-only use, CompactFrame is such an implementation.
 class Pixel {
 public:
   using value_type = Attribute;
@@ -134,6 +135,7 @@ public:
   Frame(const Common::Vec2i &size, std::vector<Pixel> pixelList)
       : m_size{size}, m_pixelList{std::move(pixelList)} {}
   auto operator==(const Frame &other) const noexcept -> bool;
+  [[nodiscard]] auto getSize() const -> Common::Vec2i { return m_size; }
   [[nodiscard]] auto getPixelList() const -> const std::vector<Pixel> & { return m_pixelList; }
   auto operator()(int32_t i, int32_t j) const -> const Pixel & {
     ASSERT(i * m_size.x() + j < static_cast<int32_t>(m_pixelList.size()));
@@ -146,6 +148,72 @@ private:
   Common::Vec2i m_size{};
   std::vector<Pixel> m_pixelList{};
 };
+
+// Read-only view on the attributes of one pixel of a CompactFrame
+class PixelView {
+public:
+  using value_type = Attribute;
+  using size_type = Pixel::size_type;
+  using iterator = const value_type *;
+
+  PixelView(iterator first, iterator last) : m_first{first}, m_last{last} {}
+
+  [[nodiscard]] auto size() const -> size_type { return static_cast<size_type>(m_last - m_first); }
+  [[nodiscard]] auto empty() const -> bool { return m_first == m_last; }
+  [[nodiscard]] auto begin() const -> iterator { return m_first; }
+  [[nodiscard]] auto end() const -> iterator { return m_last; }
+  auto operator[](size_type k) const -> const value_type & { return m_first[k]; }
+  auto operator==(const PixelView &other) const noexcept -> bool;
+
+private:
+  iterator m_first;
+  iterator m_last;
+};
+
+// An immutable MPI frame in compressed sparse row (CSR) format: one offset per pixel
+// into one contiguous attribute list. Compared to Frame, there is no per-pixel heap allocation and
+// the footprint is 4 bytes per pixel plus 10 bytes per attribute. This is the preferred format for
+// buffering the frames of an intra period.
+class CompactFrame {
+public:
+  using Offset = uint32_t;
+
+  // Random-access view on the pixels of a CompactFrame, with the same interface as
+  // Frame::getPixelList()
+  class PixelList {
+  public:
+    explicit PixelList(const CompactFrame &frame) : m_frame{&frame} {}
+
+    [[nodiscard]] auto size() const -> size_t { return m_frame->m_offsets.size() - 1; }
+    auto operator[](size_t k) const -> PixelView {
+      return {m_frame->m_attributes.data() + m_frame->m_offsets[k],
+              m_frame->m_attributes.data() + m_frame->m_offsets[k + 1]};
+    }
+
+  private:
+    const CompactFrame *m_frame;
+  };
+
+  CompactFrame() = default;
+  explicit CompactFrame(const Frame &frame);
+  CompactFrame(const Common::Vec2i &size, std::vector<Offset> offsets,
+               std::vector<Attribute> attributes);
+
+  auto operator==(const CompactFrame &other) const noexcept -> bool;
+  [[nodiscard]] auto getSize() const -> Common::Vec2i { return m_size; }
+  [[nodiscard]] auto getPixelList() const -> PixelList { return PixelList{*this}; }
+  [[nodiscard]] auto getAttributeCount() const -> size_t { return m_attributes.size(); }
+  auto operator()(int32_t i, int32_t j) const -> PixelView {
+    ASSERT(i * m_size.x() + j + 1 < static_cast<int32_t>(m_offsets.size()));
+    return getPixelList()[i * m_size.x() + j];
+  }
+  [[nodiscard]] auto getLayer(Attribute::GeometryValue layerId) const -> TextureTransparency8Frame;
+
+private:
+  Common::Vec2i m_size{};
+  std::vector<Offset> m_offsets{0};
+  std::vector<Attribute> m_attributes{};
+};
 } // namespace TMIV::MpiPcs
 
 #endif
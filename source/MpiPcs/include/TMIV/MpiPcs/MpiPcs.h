@@ -38,31 +38,60 @@
 
 #include <TMIV/IO/IO.h>
 
+#include <fstream>
+
 namespace TMIV::MpiPcs {
 class FileHeader {
 public:
   static void read(std::istream &stream);
   static void write(std::ostream &stream);
+  static constexpr auto size() noexcept -> std::streamoff { return content.size(); }
 
 private:
   static constexpr std::array<char, 10> content{'M', 'P', 'I', '_', 'P', 'C', 'S', '_', '1', '\0'};
 };
 
+// Optional sidecar file "<.pcs path>.idx" with the stream position of each frame in the .pcs file
+class IndexFile {
+public:
+  static auto path(const std::filesystem::path &pcsPath) -> std::filesystem::path;
+  static auto read(std::istream &stream) -> std::vector<std::streampos>;
+  static void writeHeader(std::ostream &stream);
+  static void writeEntry(std::ostream &stream, std::streampos pos);
+
+private:
+  static constexpr std::array<char, 10> content{'M', 'P', 'I', '_', 'I', 'D', 'X', '_', '1', '\0'};
+};
+
 class Reader {
 public:
   Reader() = default;
+
+  // When buildIndexOn is set, the frame index is loaded from the sidecar file, or when that is
+  // absent or stale, by scanning the entire .pcs file.
   Reader(const Common::Json &config, const IO::Placeholders &placeholders,
          const MivBitstream::SequenceConfig &sc, bool buildIndexOn = true);
   [[nodiscard]] auto getPath() const -> const std::filesystem::path & { return m_path; }
+  [[nodiscard]] auto getIndex() const -> const std::vector<std::streampos> & { return m_index; }
   auto read(std::istream &stream, std::streampos posId, Common::Vec2i size) -> Frame;
   auto read(int32_t frameIdx) -> Frame;
+  auto readCompact(std::istream &stream, std::streampos posId, Common::Vec2i size)
+      -> CompactFrame;
+  auto readCompact(int32_t frameIdx) -> CompactFrame;
+
+  // Write the frame index to the sidecar file
+  void saveIndex() const;
 
 private:
+  auto stream() -> std::istream &;
+  auto loadIndex() -> bool;
+  void buildIndex();
+
   std::filesystem::path m_path{};
   Common::Vec2i m_size{};
   std::vector<std::streampos> m_index{};
   int32_t m_startFrame{};
-  void buildIndex();
+  std::ifstream m_stream{};
 };
 
 class Writer {
@@ -72,9 +101,14 @@ public:
          const MivBitstream::SequenceConfig &sc);
   [[nodiscard]] auto getPath() const -> const std::filesystem::path & { return m_path; }
   void append(std::ostream &stream, const Frame &mpiPcsFrame);
+  void append(std::ostream &stream, const CompactFrame &mpiPcsFrame);
   void append(const Frame &mpiPcsFrame);
+  void append(const CompactFrame &mpiPcsFrame);
 
 private:
+  template <typename FrameType>
+  void appendFrame(std::ostream &stream, const FrameType &mpiPcsFrame);
+  template <typename FrameType> void appendFrame(const FrameType &mpiPcsFrame);
   template <typename T> void writeToStream(std::ostream &stream, std::vector<T> &items) const;
 
   std::filesystem::path m_path{};
@@ -33,53 +33,54 @@
 
 #include <TMIV/MpiPcs/Frame.h>
 
-#include <TMIV/Common/Bytestream.h>
 #include <TMIV/Common/Common.h>
 #include <TMIV/Common/Thread.h>
 
-#include <sstream>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 namespace TMIV::MpiPcs {
-using Common::getUint16;
-using Common::getUint8;
-using Common::putUint16;
-using Common::putUint8;
-using Common::swapEndianness;
-
 auto Attribute::operator==(const Attribute &other) const noexcept -> bool {
   return texture == other.texture && geometry == other.geometry &&
          transparency == other.transparency;
 }
 
-auto Attribute::fromBuffer(const Buffer &buffer) -> Attribute {
-  const auto blob = std::string{buffer.cbegin(), buffer.cend()}; // likely SSO
-  std::istringstream stream{blob};
+// The attributes are stored in little-endian byte order. The byte operations are inlined and avoid
+// the overhead of string streams when (de)serializing millions of attributes per frame.
+namespace {
+constexpr auto getUint16LE(const Attribute::Buffer &buffer, size_t i) noexcept -> uint16_t {
+  return static_cast<uint16_t>(static_cast<uint8_t>(buffer[i]) |
+                               static_cast<uint8_t>(buffer[i + 1]) << 8);
+}
+
+constexpr void putUint16LE(Attribute::Buffer &buffer, size_t i, uint16_t value) noexcept {
+  buffer[i] = static_cast<char>(value & 0xFFU);
+  buffer[i + 1] = static_cast<char>(value >> 8);
+}
+} // namespace
 
+auto Attribute::fromBuffer(const Buffer &buffer) -> Attribute {
   Attribute a;
-  a.texture[0] = swapEndianness(getUint16(stream));
-  a.texture[1] = swapEndianness(getUint16(stream));
-  a.texture[2] = swapEndianness(getUint16(stream));
-  a.geometry = swapEndianness(getUint16(stream));
-  a.transparency = getUint8(stream);
+  a.texture[0] = getUint16LE(buffer, 0);
+  a.texture[1] = getUint16LE(buffer, 2);
+  a.texture[2] = getUint16LE(buffer, 4);
+  a.geometry = getUint16LE(buffer, 6);
+  a.transparency = static_cast<uint8_t>(buffer[8]);
 
   return a;
 }
 
 auto Attribute::toBuffer() const -> Buffer {
   auto buffer = Buffer{};
-
-  std::ostringstream stream;
-  putUint16(stream, swapEndianness(texture[0]));
-  putUint16(stream, swapEndianness(texture[1]));
-  putUint16(stream, swapEndianness(texture[2]));
-  putUint16(stream, swapEndianness(geometry));
-  putUint8(stream, transparency);
-
-  const auto blob = stream.str(); // likely SSO
   static_assert(buffer.size() == attributeSize);
-  ASSERT(blob.size() == buffer.size());
 
-  std::copy(blob.cbegin(), blob.cend(), buffer.begin());
+  putUint16LE(buffer, 0, texture[0]);
+  putUint16LE(buffer, 2, texture[1]);
+  putUint16LE(buffer, 4, texture[2]);
+  putUint16LE(buffer, 6, geometry);
+  buffer[8] = static_cast<char>(transparency);
+
   return buffer;
 }
 
@@ -184,14 +185,19 @@ void Frame::appendLayer(Attribute::GeometryValue layerId, const TextureTranspare
   });
 }
 
-auto Frame::getLayer(Attribute::GeometryValue layerId) const -> TextureTransparency8Frame {
-  auto textureFrame = Common::Frame<>::yuv444(m_size, 10);
-  auto transparencyFrame = Common::Frame<uint8_t>::lumaOnly(m_size);
+namespace {
+template <typename FrameType>
+auto getLayerImpl(const FrameType &frame, Common::Vec2i size, Attribute::GeometryValue layerId)
+    -> TextureTransparency8Frame {
+  auto textureFrame = Common::Frame<>::yuv444(size, 10);
+  auto transparencyFrame = Common::Frame<uint8_t>::lumaOnly(size);
 
   textureFrame.fillNeutral();
 
-  Common::parallel_for(m_pixelList.size(), [&](size_t k) {
-    const auto &pixel = m_pixelList[k];
+  const auto &pixelList = frame.getPixelList();
+
+  Common::parallel_for(pixelList.size(), [&](size_t k) {
+    const auto &pixel = pixelList[k];
     auto *const iter =
         std::lower_bound(pixel.begin(), pixel.end(), layerId,
                          [](auto pixel_, auto layerId_) { return pixel_.geometry < layerId_; });
@@ -207,4 +213,51 @@ auto Frame::getLayer(Attribute::GeometryValue layerId) const -> TextureTranspare
 
   return {yuv420(textureFrame), std::move(transparencyFrame)};
 }
+} // namespace
+
+auto Frame::getLayer(Attribute::GeometryValue layerId) const -> TextureTransparency8Frame {
+  return getLayerImpl(*this, m_size, layerId);
+}
+
+auto PixelView::operator==(const PixelView &other) const noexcept -> bool {
+  return (size() == other.size()) && std::equal(begin(), end(), other.begin());
+}
+
+CompactFrame::CompactFrame(const Frame &frame) : m_size{frame.getSize()} {
+  const auto &pixelList = frame.getPixelList();
+
+  m_offsets.reserve(pixelList.size() + 1);
+
+  auto count = size_t{};
+
+  for (const auto &pixel : pixelList) {
+    count += pixel.size();
+
+    if (std::numeric_limits<Offset>::max() < count) {
+      throw std::runtime_error("Too many MPI attributes in a frame for a compact frame");
+    }
+    m_offsets.push_back(static_cast<Offset>(count));
+  }
+
+  m_attributes.resize(count);
+
+  Common::parallel_for(pixelList.size(), [&](size_t k) {
+    std::copy(pixelList[k].begin(), pixelList[k].end(), m_attributes.begin() + m_offsets[k]);
+  });
+}
+
+CompactFrame::CompactFrame(const Common::Vec2i &size, std::vector<Offset> offsets,
+                           std::vector<Attribute> attributes)
+    : m_size{size}, m_offsets{std::move(offsets)}, m_attributes{std::move(attributes)} {
+  PRECONDITION(m_offsets.size() == static_cast<size_t>(m_size.x() * m_size.y()) + 1);
+  PRECONDITION(m_offsets.front() == 0 && m_offsets.back() == m_attributes.size());
+}
+
+auto CompactFrame::operator==(const CompactFrame &other) const noexcept -> bool {
+  return m_offsets == other.m_offsets && m_attributes == other.m_attributes;
+}
+
+auto CompactFrame::getLayer(Attribute::GeometryValue layerId) const -> TextureTransparency8Frame {
+  return getLayerImpl(*this, m_size, layerId);
+}
 } // namespace TMIV::MpiPcs
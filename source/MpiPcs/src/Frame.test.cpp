@@ -83,6 +83,52 @@ TEST_CASE("MpiPcs : Frame") {
   }
 }
 
+TEST_CASE("MpiPcs : CompactFrame") {
+  MpiPcs::Frame frame({6, 6});
+  auto mpiLayer1 = TextureTransparency8Frame{Common::Frame<>::yuv420({6, 6}, 10),
+                                             Common::Frame<uint8_t>::lumaOnly({6, 6})};
+  auto mpiLayer2 = TextureTransparency8Frame{Common::Frame<>::yuv420({6, 6}, 10),
+                                             Common::Frame<uint8_t>::lumaOnly({6, 6})};
+
+  mpiLayer1.transparency.getPlane(0)(0, 2) = 255;
+  mpiLayer2.transparency.getPlane(0)(0, 2) = 255;
+  mpiLayer2.transparency.getPlane(0)(3, 4) = 255;
+  frame.appendLayer(1, mpiLayer1);
+  frame.appendLayer(2, mpiLayer2);
+
+  const auto unit = MpiPcs::CompactFrame{frame};
+
+  SECTION("construction from MpiPcs frame") {
+    REQUIRE(unit.getSize() == Common::Vec2i{6, 6});
+    REQUIRE(unit.getAttributeCount() == 3);
+    REQUIRE(unit.getPixelList().size() == frame.getPixelList().size());
+    REQUIRE(unit(0, 2).size() == 2);
+    REQUIRE(unit(0, 2)[1].geometry == 2);
+    REQUIRE(unit(3, 4).size() == 1);
+    REQUIRE(unit.getPixelList()[1].empty());
+  }
+
+  SECTION("construction from offsets and attributes") {
+    auto offsets = std::vector<MpiPcs::CompactFrame::Offset>(37, 3);
+    std::fill(offsets.begin(), offsets.begin() + 3, 0);
+    std::fill(offsets.begin() + 3, offsets.begin() + 23, 2);
+    const auto attributes = std::vector<Attribute>{frame(0, 2)[0], frame(0, 2)[1], frame(3, 4)[0]};
+
+    REQUIRE(MpiPcs::CompactFrame{{6, 6}, offsets, attributes} == unit);
+  }
+
+  SECTION("layer equal operator") {
+    REQUIRE(unit.getLayer(1).transparency.getPlane(0) == mpiLayer1.transparency.getPlane(0));
+    REQUIRE(unit.getLayer(2).transparency.getPlane(0) == mpiLayer2.transparency.getPlane(0));
+    REQUIRE(unit.getLayer(2).texture.getPlanes() == frame.getLayer(2).texture.getPlanes());
+  }
+
+  SECTION("Frame (not) equal operator") {
+    REQUIRE(MpiPcs::CompactFrame{} == MpiPcs::CompactFrame{MpiPcs::Frame{}});
+    REQUIRE_FALSE(unit == MpiPcs::CompactFrame{});
+  }
+}
+
 TEST_CASE("MpiPcs : Attribute") {
   MpiPcs::Attribute unit{};
   unit.geometry = 3;
@@ -103,6 +149,12 @@ TEST_CASE("MpiPcs : Attribute") {
     REQUIRE(unit == unit);
   }
 
+  SECTION("buffer conversion") {
+    const auto buffer = unit.toBuffer();
+    REQUIRE(buffer == Attribute::Buffer{1, 0, 10, 0, 100, 0, 3, 0, 77});
+    REQUIRE(Attribute::fromBuffer(buffer) == unit);
+  }
+
   SECTION("construction from attribute") {
     const auto t = MpiPcs::Attribute::TextureValue{1, 10, 100};
     const auto g = MpiPcs::Attribute::GeometryValue{3};
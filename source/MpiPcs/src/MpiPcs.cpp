@@ -33,24 +33,41 @@
 
 #include <TMIV/MpiPcs/MpiPcs.h>
 
+#include <TMIV/Common/Bytestream.h>
 #include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/Thread.h>
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
 
 namespace TMIV::MpiPcs {
 namespace {
+// Attributes are decoded in parallel in chunks of this size
+constexpr auto attributeChunkSize = size_t{0x10000};
+
 template <typename T>
 auto readFromStream(std::istream &stream, uint64_t numberOfItems) -> std::vector<T> {
-  std::string itemBuffer(numberOfItems * sizeof(T), '0');
-  stream.read(itemBuffer.data(), Common::downCast<std::streamsize>(itemBuffer.size()));
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  std::vector<T> items(numberOfItems);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  stream.read(reinterpret_cast<char *>(items.data()),
+              Common::downCast<std::streamsize>(items.size() * sizeof(T)));
   if (!stream.good()) {
     throw std::runtime_error("Failed to read stream");
   }
-
-  std::vector<T> items(numberOfItems);
-  memcpy(items.data(), itemBuffer.data(), itemBuffer.size());
   return items;
 }
+
+auto frameLength(const std::vector<Attribute::Count> &countList) {
+  const auto numberOfAttributes = std::accumulate(countList.begin(), countList.end(), 0ULL);
+
+  return Common::downCast<std::streamoff>(countList.size() * sizeof(Attribute::Count) +
+                                          numberOfAttributes * Attribute::attributeSize);
+}
 } // namespace
 
 const std::string inputMpiPcsPathFmt = "inputMpiPcsPathFmt";
@@ -76,6 +93,42 @@ void FileHeader::write(std::ostream &stream) {
   }
 }
 
+auto IndexFile::path(const std::filesystem::path &pcsPath) -> std::filesystem::path {
+  auto result = pcsPath;
+  result += ".idx";
+  return result;
+}
+
+auto IndexFile::read(std::istream &stream) -> std::vector<std::streampos> {
+  std::array<char, content.size()> buffer{};
+
+  stream.read(buffer.data(), buffer.size());
+  if (!stream.good() || buffer != content) {
+    throw std::runtime_error("MpiPcs index file header mismatch");
+  }
+
+  std::vector<std::streampos> index;
+
+  while (stream.peek() != std::istream::traits_type::eof()) {
+    index.emplace_back(Common::downCast<std::streamoff>(Common::getUint64(stream)));
+  }
+  return index;
+}
+
+void IndexFile::writeHeader(std::ostream &stream) {
+  stream.write(content.data(), content.size());
+  if (!stream.good()) {
+    throw std::runtime_error("Failed to write to stream");
+  }
+}
+
+void IndexFile::writeEntry(std::ostream &stream, std::streampos pos) {
+  Common::putUint64(stream, static_cast<uint64_t>(std::streamoff{pos}));
+  if (!stream.good()) {
+    throw std::runtime_error("Failed to write to stream");
+  }
+}
+
 Reader::Reader(const Common::Json &config, const IO::Placeholders &placeholders,
                const MivBitstream::SequenceConfig &sc, const bool buildIndexOn)
     : m_startFrame{placeholders.startFrame} {
@@ -94,55 +147,153 @@ Reader::Reader(const Common::Json &config, const IO::Placeholders &placeholders,
                              placeholders.contentId, placeholders.testId, cameraName, m_size.x(),
                              m_size.y(), videoFormat);
 
-  if (buildIndexOn) {
+  if (buildIndexOn && !loadIndex()) {
     buildIndex();
   }
 }
 
 auto Reader::read(std::istream &stream, std::streampos posId, Common::Vec2i size) -> Frame {
+  const auto compactFrame = readCompact(stream, posId, size);
+  const auto compactPixelList = compactFrame.getPixelList();
+
+  std::vector<Pixel> pixelList(compactPixelList.size());
+
+  Common::parallel_for(pixelList.size(), [&](size_t k) {
+    const auto attributes = compactPixelList[k];
+
+    if (!attributes.empty()) {
+      pixelList[k] = Pixel{attributes.size()};
+      std::copy(attributes.begin(), attributes.end(), pixelList[k].begin());
+    }
+  });
+
+  return Frame{size, std::move(pixelList)};
+}
+
+auto Reader::read(int32_t frameIdx) -> Frame {
+  Common::logInfo("Loading MPI pcs frame {0} with start frame offset {1} (= {2}).", frameIdx,
+                  m_startFrame, frameIdx + m_startFrame);
+
+  return read(stream(), m_index[frameIdx + m_startFrame], m_size);
+}
+
+auto Reader::readCompact(std::istream &stream, std::streampos posId, Common::Vec2i size)
+    -> CompactFrame {
   stream.seekg(posId);
   if (!stream.good()) {
     throw std::runtime_error(fmt::format("Failed to seek stream at position {}", posId));
   }
 
-  std::vector<Pixel> pixelList(size.x() * size.y());
+  const auto countList = readFromStream<Attribute::Count>(stream, size.x() * size.y());
 
-  const auto countList = readFromStream<Attribute::Count>(stream, pixelList.size());
+  auto offsets = std::vector<CompactFrame::Offset>(countList.size() + 1);
+  auto numberOfAttributes = uint64_t{};
 
-  const auto numberOfAttributes = std::accumulate(countList.begin(), countList.end(), 0ULL);
+  for (size_t k = 0; k < countList.size(); ++k) {
+    numberOfAttributes += countList[k];
+
+    if (std::numeric_limits<CompactFrame::Offset>::max() < numberOfAttributes) {
+      throw std::runtime_error("Too many MPI attributes in a frame for a compact frame");
+    }
+    offsets[k + 1] = static_cast<CompactFrame::Offset>(numberOfAttributes);
+  }
 
   const auto bufferList = readFromStream<Attribute::Buffer>(stream, numberOfAttributes);
+  auto attributes = std::vector<Attribute>(bufferList.size());
 
-  for (auto k = 0ULL, l = 0ULL; k < pixelList.size(); ++k) {
-    auto &pixel = pixelList[k];
+  Common::parallel_for((bufferList.size() + attributeChunkSize - 1) / attributeChunkSize,
+                       [&](size_t chunk) {
+                         const auto first = chunk * attributeChunkSize;
+                         const auto last = std::min(first + attributeChunkSize, bufferList.size());
 
-    pixel.reserve(countList[k]);
+                         for (auto i = first; i < last; ++i) {
+                           attributes[i] = Attribute::fromBuffer(bufferList[i]);
+                         }
+                       });
 
-    for (Attribute::Count i = 0; i < countList[k]; ++i, ++l) {
-      pixel.push_back(Attribute::fromBuffer(bufferList[l]));
-    }
-  }
+  return CompactFrame{size, std::move(offsets), std::move(attributes)};
+}
 
-  return Frame{m_size, std::move(pixelList)};
+auto Reader::readCompact(int32_t frameIdx) -> CompactFrame {
+  Common::logInfo("Loading MPI pcs frame {0} with start frame offset {1} (= {2}).", frameIdx,
+                  m_startFrame, frameIdx + m_startFrame);
+
+  return readCompact(stream(), m_index[frameIdx + m_startFrame], m_size);
 }
 
-auto Reader::read(int32_t frameIdx) -> Frame {
-  std::ifstream stream{m_path, std::ifstream::binary};
+void Reader::saveIndex() const {
+  const auto indexPath = IndexFile::path(m_path);
+
+  std::ofstream stream{indexPath, std::ofstream::binary};
   if (!stream.good()) {
-    throw std::runtime_error(fmt::format("Failed to open {} for reading", m_path));
+    throw std::runtime_error(fmt::format("Failed to open {} for writing", indexPath));
   }
 
-  Common::logInfo("Loading MPI pcs frame {0} with start frame offset {1} (= {2}).", frameIdx,
-                  m_startFrame, frameIdx + m_startFrame);
+  IndexFile::writeHeader(stream);
 
-  return read(stream, m_index[frameIdx + m_startFrame], m_size);
+  for (const auto pos : m_index) {
+    IndexFile::writeEntry(stream, pos);
+  }
 }
 
-void Reader::buildIndex() {
-  std::ifstream stream{m_path, std::ifstream::binary};
-  if (!stream.good()) {
+// The .pcs file is kept open in between frames
+auto Reader::stream() -> std::istream & {
+  if (!m_stream.is_open()) {
+    m_stream.open(m_path, std::ifstream::binary);
+  }
+  if (!m_stream.good()) {
     throw std::runtime_error(fmt::format("Failed to open {} for reading", m_path));
   }
+  return m_stream;
+}
+
+// Load the index from the sidecar file, and check that it matches the .pcs file, in constant time
+auto Reader::loadIndex() -> bool {
+  const auto indexPath = IndexFile::path(m_path);
+
+  if (!std::filesystem::exists(indexPath)) {
+    return false;
+  }
+
+  std::ifstream indexStream{indexPath, std::ifstream::binary};
+  if (!indexStream.good()) {
+    throw std::runtime_error(fmt::format("Failed to open {} for reading", indexPath));
+  }
+
+  auto index = IndexFile::read(indexStream);
+  const auto length = static_cast<std::streamoff>(std::filesystem::file_size(m_path));
+
+  const auto valid = [&]() {
+    const auto pixelCount = static_cast<size_t>(m_size.x() * m_size.y());
+    const auto minFrameLength = static_cast<std::streamoff>(pixelCount * sizeof(Attribute::Count));
+
+    // Offsets are strictly increasing and each frame has at least its count list in the file
+    if (index.empty() || std::streamoff{index.front()} != FileHeader::size() ||
+        std::adjacent_find(index.cbegin(), index.cend(), std::greater_equal<>{}) != index.cend() ||
+        std::any_of(index.cbegin(), index.cend(), [=](std::streampos pos) {
+          return length < std::streamoff{pos} + minFrameLength;
+        })) {
+      return false;
+    }
+
+    // The last frame has to end at the end of the file
+    stream().seekg(index.back());
+    const auto countList = readFromStream<Attribute::Count>(stream(), pixelCount);
+    return std::streamoff{index.back()} + frameLength(countList) == length;
+  }();
+
+  if (!valid) {
+    Common::logWarning("Ignoring MPI pcs index {} because it does not match {}", indexPath,
+                       m_path);
+    return false;
+  }
+
+  m_index = std::move(index);
+  return true;
+}
+
+void Reader::buildIndex() {
+  auto &stream = this->stream();
 
   stream.seekg(0, std::ifstream::end);
   if (!stream.good()) {
@@ -158,8 +309,6 @@ void Reader::buildIndex() {
 
   FileHeader::read(stream);
 
-  std::vector<Attribute::Count> countList(m_size.x() * m_size.y());
-
   auto pos = stream.tellg();
 
   while (pos < length) {
@@ -170,20 +319,7 @@ void Reader::buildIndex() {
       throw std::runtime_error(fmt::format("Failed to seekg from {}", m_path));
     }
 
-    std::string attributeCountBuffer(countList.size() * sizeof(Attribute::Count), '0');
-
-    stream.read(attributeCountBuffer.data(),
-                Common::downCast<std::streamsize>(attributeCountBuffer.size()));
-    if (!stream.good()) {
-      throw std::runtime_error(fmt::format("Failed to read from {}", m_path));
-    }
-
-    std::memcpy(countList.data(), attributeCountBuffer.data(), attributeCountBuffer.size());
-
-    const auto nbAttribute = std::accumulate(countList.begin(), countList.end(), 0ULL);
-
-    pos += Common::downCast<std::streamoff>(countList.size() * sizeof(Attribute::Count) +
-                                            nbAttribute * Attribute::attributeSize);
+    pos += frameLength(readFromStream<Attribute::Count>(stream, m_size.x() * m_size.y()));
   }
 }
 
@@ -212,13 +348,33 @@ Writer::Writer(const Common::Json &config, const IO::Placeholders &placeholders,
   }
 
   FileHeader::write(stream);
+
+  const auto indexPath = IndexFile::path(m_path);
+
+  std::ofstream indexStream{indexPath, std::ofstream::binary};
+  if (!indexStream.good()) {
+    throw std::runtime_error(fmt::format("Failed to open {} for writing", indexPath));
+  }
+
+  IndexFile::writeHeader(indexStream);
 }
 
 void Writer::append(std::ostream &stream, const Frame &mpiPcsFrame) {
+  appendFrame(stream, mpiPcsFrame);
+}
+
+void Writer::append(std::ostream &stream, const CompactFrame &mpiPcsFrame) {
+  appendFrame(stream, mpiPcsFrame);
+}
+
+template <typename FrameType>
+void Writer::appendFrame(std::ostream &stream, const FrameType &mpiPcsFrame) {
   std::vector<Attribute::Count> counts;
   std::vector<Attribute::Buffer> buffers;
 
-  for (const auto &pixel : mpiPcsFrame.getPixelList()) {
+  for (size_t k = 0; k < mpiPcsFrame.getPixelList().size(); ++k) {
+    const auto &pixel = mpiPcsFrame.getPixelList()[k];
+
     counts.emplace_back(static_cast<Attribute::Count>(pixel.size()));
 
     for (const auto &attribute : pixel) {
@@ -241,12 +397,27 @@ void Writer::writeToStream(std::ostream &stream, std::vector<T> &items) const {
   }
 }
 
-void Writer::append(const Frame &mpiPcsFrame) {
+void Writer::append(const Frame &mpiPcsFrame) { appendFrame(mpiPcsFrame); }
+
+void Writer::append(const CompactFrame &mpiPcsFrame) { appendFrame(mpiPcsFrame); }
+
+template <typename FrameType> void Writer::appendFrame(const FrameType &mpiPcsFrame) {
+  const auto pos = static_cast<std::streamoff>(std::filesystem::file_size(m_path));
+
   std::ofstream stream{m_path, std::ofstream::binary | std::ofstream::app};
   if (!stream.good()) {
     throw std::runtime_error(fmt::format("Failed to open {} for appending", m_path));
   }
 
   append(stream, mpiPcsFrame);
+
+  const auto indexPath = IndexFile::path(m_path);
+
+  std::ofstream indexStream{indexPath, std::ofstream::binary | std::ofstream::app};
+  if (!indexStream.good()) {
+    throw std::runtime_error(fmt::format("Failed to open {} for appending", indexPath));
+  }
+
+  IndexFile::writeEntry(indexStream, pos);
 }
 } // namespace TMIV::MpiPcs
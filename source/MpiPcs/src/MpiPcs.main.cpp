@@ -45,7 +45,7 @@ const std::string outputTransparencyPathFmt = "outputTransparencyPathFmt";
 
 class Application : public Common::Application {
 private:
-  enum class ConversionMode { None, RawToPcs, PcsToRaw };
+  enum class ConversionMode { None, RawToPcs, PcsToRaw, PcsToIndex };
 
   const std::string &m_contentId;
   int32_t m_numberOfInputFrames;
@@ -68,7 +68,7 @@ public:
                                 {"-s", "Content ID (e.g. B for Museum)", false},
                                 {"-n", "Number of input frames (e.g. 97)", false},
                                 {"-f", "Input start frame (e.g. 23)", false},
-                                {"-x", "Conversion mode (raw2pcs or pcs2raw)", false}}}
+                                {"-x", "Conversion mode (raw2pcs, pcs2raw or pcs2idx)", false}}}
       , m_contentId{optionValues("-s"sv).front()}
       , m_numberOfInputFrames{std::stoi(optionValues("-n"sv).front())}
       , m_startFrame{std::stoi(optionValues("-f"sv).front())}
@@ -79,8 +79,10 @@ public:
       m_conversionMode = ConversionMode::RawToPcs;
     } else if (conversionModeOption == "pcs2raw") {
       m_conversionMode = ConversionMode::PcsToRaw;
+    } else if (conversionModeOption == "pcs2idx") {
+      m_conversionMode = ConversionMode::PcsToIndex;
     } else {
-      throw std::runtime_error("Invalid conversion options (expected raw2pcs or pcs2raw)");
+      throw std::runtime_error("Invalid conversion options (expected raw2pcs, pcs2raw or pcs2idx)");
     }
   }
   void run() override {
@@ -91,6 +93,9 @@ public:
     case ConversionMode::PcsToRaw:
       doPcsToRawConversion();
       break;
+    case ConversionMode::PcsToIndex:
+      doPcsToIndexConversion();
+      break;
     default:;
     }
   }
@@ -185,7 +190,7 @@ private:
     const auto layerCount = Common::verifyDownCast<geometryValue>(viewParams.nbMpiLayers);
 
     for (int32_t frameIdx = 0; frameIdx < m_numberOfInputFrames; ++frameIdx) {
-      const auto mpiPcsFrame = mpiPcsReader.read(frameIdx);
+      const auto mpiPcsFrame = mpiPcsReader.readCompact(frameIdx);
 
       for (geometryValue layerId = 0; layerId < layerCount; ++layerId) {
         const auto [textureLayer, transparencyLayer] = mpiPcsFrame.getLayer(layerId);
@@ -207,6 +212,16 @@ private:
 
     Common::logInfo("PCS to RAW conversion completed");
   }
+
+  // Generate the index sidecar file of a .pcs file that was written without one
+  void doPcsToIndexConversion() const {
+    MpiPcs::Reader mpiPcsReader{json(), placeholders(), m_inputSequenceConfig};
+
+    mpiPcsReader.saveIndex();
+
+    Common::logInfo("PCS to IDX conversion completed: {} frames indexed in {}",
+                    mpiPcsReader.getIndex().size(), IndexFile::path(mpiPcsReader.getPath()));
+  }
 };
 
 } // namespace TMIV::MpiPcs
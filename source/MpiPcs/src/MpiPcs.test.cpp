@@ -40,6 +40,9 @@ using Catch::Matchers::Contains;
 
 #include <fmt/format.h>
 
+#include <chrono>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
 using namespace std::string_literals;
@@ -171,6 +174,10 @@ TEST_CASE("MpiPcs writer and reader") {
       ss2 << fmt::format("{:02X}", int32_t{n[0]});
     }
     REQUIRE(ss2.str() == expected_string);
+
+    std::stringstream ss3;
+    writer.append(ss3, CompactFrame{mpiPcsFrame});
+    REQUIRE(ss3.str() == ss.str());
   }
 
   SECTION("Reader") {
@@ -217,6 +224,115 @@ TEST_CASE("MpiPcs writer and reader") {
 
     REQUIRE(rd_mpiPcsFrame.getPixelList().size() == mpiPcsFrame.getPixelList().size());
     REQUIRE(rd_mpiPcsFrame.getPixelList() == mpiPcsFrame.getPixelList());
+
+    const auto rd_compactFrame = reader.readCompact(ss, 0, Common::Vec2i({2, 2}));
+
+    REQUIRE(rd_compactFrame == CompactFrame{mpiPcsFrame});
+  }
+
+  SECTION("IndexFile") {
+    REQUIRE(IndexFile::path("C:/fakeDir/fake.pcs") == "C:/fakeDir/fake.pcs.idx");
+
+    std::stringstream ss;
+    IndexFile::writeHeader(ss);
+    REQUIRE(IndexFile::read(ss).empty());
+
+    ss.clear();
+    ss.seekg(0);
+    IndexFile::writeEntry(ss, 10);
+    IndexFile::writeEntry(ss, 0x123456789);
+    REQUIRE(IndexFile::read(ss) == std::vector<std::streampos>{10, 0x123456789});
+
+    std::stringstream ss2;
+    FileHeader::write(ss2);
+    REQUIRE_THROWS(IndexFile::read(ss2));
+  }
+
+  SECTION("Reader index") {
+    const auto size = Common::Vec2i{2, 2};
+    const auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto dir = std::filesystem::temp_directory_path() / fmt::format("tmiv-mpipcs-{}", ticks);
+    std::filesystem::create_directories(dir);
+    const auto pcsPath = dir / "fake.pcs";
+
+    // Three frames with 1, 0 and 3 active pixels
+    {
+      std::ofstream stream{pcsPath, std::ofstream::binary};
+      FileHeader::write(stream);
+
+      for (const auto activePixels : {1, 0, 3}) {
+        Frame mpiPcsFrame(size);
+        auto mpiLayer = TextureTransparency8Frame{Common::Frame<>::yuv420(size, 10),
+                                                  Common::Frame<uint8_t>::lumaOnly(size)};
+        for (int32_t i = 0; i < activePixels; ++i) {
+          mpiLayer.transparency.getPlane(0)[i] = 255;
+        }
+        mpiPcsFrame.appendLayer(7, mpiLayer);
+        Writer{}.append(stream, mpiPcsFrame);
+      }
+    }
+
+    // Each frame has a count list of 4 x 2 bytes and 9 bytes per active pixel
+    const auto frame0 = FileHeader::size();
+    const auto frame1 = frame0 + 8 + 1 * 9;
+    const auto frame2 = frame1 + 8;
+    const auto expectedIndex = std::vector<std::streampos>{frame0, frame1, frame2};
+
+    auto config = Common::Json{std::in_place_type_t<Common::Json::Object>{},
+                               std::pair{"inputDirectory"s, Common::Json{dir.string()}},
+                               std::pair{"inputMpiPcsPathFmt"s, Common::Json{"fake.pcs"}}};
+
+    auto viewParams = MivBitstream::ViewParams{};
+    viewParams.ci.ci_projection_plane_width_minus1(size.x() - 1);
+    viewParams.ci.ci_projection_plane_height_minus1(size.y() - 1);
+    viewParams.name = "fake_name";
+
+    auto cameraConfig = MivBitstream::CameraConfig{};
+    cameraConfig.viewParams = viewParams;
+    cameraConfig.bitDepthTransparency = 8;
+
+    auto sequenceConfig = MivBitstream::SequenceConfig{};
+    sequenceConfig.cameras.push_back(cameraConfig);
+    sequenceConfig.sourceCameraNames.push_back(viewParams.name);
+
+    const auto writeIndex = [&](const std::vector<std::streampos> &index) {
+      std::ofstream stream{IndexFile::path(pcsPath), std::ofstream::binary};
+      IndexFile::writeHeader(stream);
+
+      for (const auto pos : index) {
+        IndexFile::writeEntry(stream, pos);
+      }
+    };
+
+    const auto loadedIndex = [&]() {
+      return Reader{config, IO::Placeholders{}, sequenceConfig}.getIndex();
+    };
+
+    // Without an index file the .pcs file is scanned
+    REQUIRE(loadedIndex() == expectedIndex);
+
+    // The index file is used when it matches the .pcs file
+    Reader{config, IO::Placeholders{}, sequenceConfig}.saveIndex();
+    REQUIRE(std::filesystem::exists(IndexFile::path(pcsPath)));
+    REQUIRE(loadedIndex() == expectedIndex);
+
+    // Corrupt index files are ignored and the .pcs file is scanned instead
+    const auto length = static_cast<std::streamoff>(std::filesystem::file_size(pcsPath));
+    const auto corruptIndices = std::vector<std::vector<std::streampos>>{
+        {},
+        {frame1, frame2},
+        {frame0, frame2, frame1},
+        {frame0, frame1, frame1, frame2},
+        {frame0, frame1, length},
+        {frame0, frame1},
+    };
+
+    for (const auto &corruptIndex : corruptIndices) {
+      writeIndex(corruptIndex);
+      REQUIRE(loadedIndex() == expectedIndex);
+    }
+
+    std::filesystem::remove_all(dir);
   }
 }
 
@@ -36,6 +36,7 @@
 
 #include <TMIV/Common/Frame.h>
 
+#include <array>
 #include <queue>
 #include <tuple>
 
@@ -86,26 +87,42 @@ public:
     return out;
   }
   static auto setEntityId(const Cluster &c, int32_t entityId) -> Cluster;
+  static auto setClusterId(const Cluster &c, int32_t clusterId) -> Cluster;
   static auto align(const Cluster &c, int32_t alignment) -> Cluster;
   static auto merge(const Cluster &c1, const Cluster &c2) -> Cluster;
 
 private:
+  // For each row (or column) of a cluster, the first and last column (or row) that has a pixel of
+  // the cluster, or -1 when there is none. Split clusters inherit the extents along the split
+  // direction, because the rows (or columns) of both parts are rows (or columns) of the parent.
+  struct Extents {
+    int32_t offset{};
+    std::vector<int32_t> first;
+    std::vector<int32_t> last;
+  };
+  using AggregatedExtents = std::array<std::vector<int32_t>, 2>;
+
+  void recursiveSplit(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
+                      int32_t alignment, int32_t minPatchSize, const Extents *rowExtents,
+                      const Extents *columnExtents) const;
   auto splitLPatchVertically(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
                              int32_t alignment, int32_t minPatchSize,
-                             const std::array<std::deque<int32_t>, 2> &min_h_agg,
-                             const std::array<std::deque<int32_t>, 2> &max_h_agg) const -> bool;
+                             const Extents &columnExtents) const -> bool;
   auto splitLPatchHorizontally(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
                                int32_t alignment, int32_t minPatchSize,
-                               const std::array<std::deque<int32_t>, 2> &min_w_agg,
-                               const std::array<std::deque<int32_t>, 2> &max_w_agg) const -> bool;
+                               const Extents &rowExtents) const -> bool;
   auto splitCPatchVertically(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
-                             int32_t alignment, int32_t minPatchSize) const -> bool;
+                             int32_t alignment, int32_t minPatchSize,
+                             const Extents &columnExtents) const -> bool;
   auto splitCPatchHorizontally(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
-                               int32_t alignment, int32_t minPatchSize) const -> bool;
-  [[nodiscard]] auto createAggregatedQueues(const ClusteringMap &clusteringMap,
+                               int32_t alignment, int32_t minPatchSize,
+                               const Extents &rowExtents) const -> bool;
+  [[nodiscard]] auto computeExtents(const ClusteringMap &clusteringMap,
+                                    bool aggregateHorizontally) const -> Extents;
+  [[nodiscard]] auto createAggregatedQueues(const Extents &extents,
                                             bool aggregateHorizontally) const
-      -> std::tuple<std::array<std::deque<int32_t>, 2>, std::array<std::deque<int32_t>, 2>>;
-  [[nodiscard]] auto computeMinAndMaxVectors(const ClusteringMap &clusteringMap,
+      -> std::tuple<AggregatedExtents, AggregatedExtents>;
+  [[nodiscard]] auto computeMinAndMaxVectors(const Extents &extents,
                                              bool aggregateHorizontally) const
       -> std::tuple<std::vector<int32_t>, std::vector<int32_t>>;
 
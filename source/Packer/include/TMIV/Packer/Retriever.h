@@ -40,5 +40,9 @@ namespace TMIV::Packer {
 auto retrieveClusters(int32_t viewIdx, const Common::Frame<uint8_t> &maskMap,
                       int32_t firstClusterId, bool isBasicView, bool enableMerging,
                       bool multiEntity) -> std::pair<ClusterList, ClusteringMap>;
+
+// Renumber the output of retrieveClusters as if it was called with a first cluster ID that is the
+// specified offset higher
+void offsetClusterIds(std::pair<ClusterList, ClusteringMap> &clusters, int32_t offset);
 } // namespace TMIV::Packer
 #endif // TMIV_PACKER_RETRIEVER_H
@@ -68,6 +68,12 @@ auto Cluster::setEntityId(const Cluster &c, int32_t entityId) -> Cluster {
   return d;
 }
 
+auto Cluster::setClusterId(const Cluster &c, int32_t clusterId) -> Cluster {
+  auto d = c;
+  d.clusterId_ = clusterId;
+  return d;
+}
+
 auto Cluster::align(const Cluster &c, int32_t alignment) -> Cluster {
   Cluster d(c.viewIdx_, c.isBasicView(), c.clusterId_, c.entityId_);
 
@@ -100,10 +106,9 @@ auto Cluster::merge(const Cluster &c1, const Cluster &c2) -> Cluster {
 
 auto Cluster::splitLPatchHorizontally(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
                                       int32_t alignment, int32_t minPatchSize,
-                                      const std::array<std::deque<int32_t>, 2> &min_w_agg,
-                                      const std::array<std::deque<int32_t>, 2> &max_w_agg) const
-    -> bool {
+                                      const Extents &rowExtents) const -> bool {
   double splitThresholdL = 0.9;
+  const auto [min_w_agg, max_w_agg] = createAggregatedQueues(rowExtents, true);
 
   const Cluster &c = (*this);
   const auto &clusteringBuffer = clusteringMap.getPlane(0);
@@ -145,8 +150,8 @@ auto Cluster::splitLPatchHorizontally(const ClusteringMap &clusteringMap, std::v
       }
     }
 
-    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
-    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
+    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize, &rowExtents, nullptr);
+    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize, &rowExtents, nullptr);
 
     return true;
   }
@@ -154,7 +159,8 @@ auto Cluster::splitLPatchHorizontally(const ClusteringMap &clusteringMap, std::v
 }
 
 auto Cluster::splitCPatchVertically(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
-                                    int32_t alignment, int32_t minPatchSize) const -> bool {
+                                    int32_t alignment, int32_t minPatchSize,
+                                    const Extents &columnExtents) const -> bool {
   double splitThresholdC = 0.3;
 
   const Cluster &c = (*this);
@@ -213,8 +219,8 @@ auto Cluster::splitCPatchVertically(const ClusteringMap &clusteringMap, std::vec
       }
     }
 
-    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
-    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
+    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize, nullptr, &columnExtents);
+    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize, nullptr, &columnExtents);
 
     return true;
   }
@@ -222,7 +228,8 @@ auto Cluster::splitCPatchVertically(const ClusteringMap &clusteringMap, std::vec
 }
 
 auto Cluster::splitCPatchHorizontally(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
-                                      int32_t alignment, int32_t minPatchSize) const -> bool {
+                                      int32_t alignment, int32_t minPatchSize,
+                                      const Extents &rowExtents) const -> bool {
   double splitThresholdC = 0.3;
 
   const Cluster &c = (*this);
@@ -281,8 +288,8 @@ auto Cluster::splitCPatchHorizontally(const ClusteringMap &clusteringMap, std::v
       }
     }
 
-    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
-    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
+    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize, &rowExtents, nullptr);
+    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize, &rowExtents, nullptr);
 
     return true;
   }
@@ -291,10 +298,9 @@ auto Cluster::splitCPatchHorizontally(const ClusteringMap &clusteringMap, std::v
 
 auto Cluster::splitLPatchVertically(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
                                     int32_t alignment, int32_t minPatchSize,
-                                    const std::array<std::deque<int32_t>, 2> &min_h_agg,
-                                    const std::array<std::deque<int32_t>, 2> &max_h_agg) const
-    -> bool {
+                                    const Extents &columnExtents) const -> bool {
   double splitThresholdL = 0.9;
+  const auto [min_h_agg, max_h_agg] = createAggregatedQueues(columnExtents, false);
 
   const Cluster &c = (*this);
   const auto &clusteringBuffer = clusteringMap.getPlane(0);
@@ -336,8 +342,8 @@ auto Cluster::splitLPatchVertically(const ClusteringMap &clusteringMap, std::vec
       }
     }
 
-    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
-    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize);
+    c1.recursiveSplit(clusteringMap, out, alignment, minPatchSize, nullptr, &columnExtents);
+    c2.recursiveSplit(clusteringMap, out, alignment, minPatchSize, nullptr, &columnExtents);
 
     return true;
   }
@@ -346,25 +352,38 @@ auto Cluster::splitLPatchVertically(const ClusteringMap &clusteringMap, std::vec
 
 void Cluster::recursiveSplit(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
                              int32_t alignment, int32_t minPatchSize) const {
+  recursiveSplit(clusteringMap, out, alignment, minPatchSize, nullptr, nullptr);
+}
+
+void Cluster::recursiveSplit(const ClusteringMap &clusteringMap, std::vector<Cluster> &out,
+                             int32_t alignment, int32_t minPatchSize, const Extents *rowExtents,
+                             const Extents *columnExtents) const {
   bool splitted = false;
   const int32_t maxNonSplitTableSize = 64;
+  auto extents = Extents{};
 
   if (width() > height()) { // split vertically
     if (width() > maxNonSplitTableSize) {
-      const auto [min_h_agg, max_h_agg] = createAggregatedQueues(clusteringMap, false);
-      splitted =
-          splitLPatchVertically(clusteringMap, out, alignment, minPatchSize, min_h_agg, max_h_agg);
+      if (columnExtents == nullptr) {
+        extents = computeExtents(clusteringMap, false);
+        columnExtents = &extents;
+      }
+      splitted = splitLPatchVertically(clusteringMap, out, alignment, minPatchSize, *columnExtents);
       if (!splitted) {
-        splitted = splitCPatchVertically(clusteringMap, out, alignment, minPatchSize);
+        splitted =
+            splitCPatchVertically(clusteringMap, out, alignment, minPatchSize, *columnExtents);
       }
     }
   } else { // split horizontally
     if (height() > maxNonSplitTableSize) {
-      const auto [min_w_agg, max_w_agg] = createAggregatedQueues(clusteringMap, true);
-      splitted = splitLPatchHorizontally(clusteringMap, out, alignment, minPatchSize, min_w_agg,
-                                         max_w_agg);
+      if (rowExtents == nullptr) {
+        extents = computeExtents(clusteringMap, true);
+        rowExtents = &extents;
+      }
+      splitted = splitLPatchHorizontally(clusteringMap, out, alignment, minPatchSize, *rowExtents);
       if (!splitted) {
-        splitted = splitCPatchHorizontally(clusteringMap, out, alignment, minPatchSize);
+        splitted =
+            splitCPatchHorizontally(clusteringMap, out, alignment, minPatchSize, *rowExtents);
       }
     }
   }
@@ -374,66 +393,93 @@ void Cluster::recursiveSplit(const ClusteringMap &clusteringMap, std::vector<Clu
   }
 }
 
-auto Cluster::createAggregatedQueues(const ClusteringMap &clusteringMap,
-                                     const bool aggregateHorizontally) const
-    -> std::tuple<std::array<std::deque<int32_t>, 2>, std::array<std::deque<int32_t>, 2>> {
+auto Cluster::createAggregatedQueues(const Extents &extents, const bool aggregateHorizontally) const
+    -> std::tuple<AggregatedExtents, AggregatedExtents> {
   const auto aggregationDimensionSize = aggregateHorizontally ? height() : width();
 
-  std::array<std::deque<int32_t>, 2> min_agg{};
-  std::array<std::deque<int32_t>, 2> max_agg{};
-  const auto [minima, maxima] = computeMinAndMaxVectors(clusteringMap, aggregateHorizontally);
+  auto min_agg = AggregatedExtents{};
+  auto max_agg = AggregatedExtents{};
+  const auto [minima, maxima] = computeMinAndMaxVectors(extents, aggregateHorizontally);
 
-  min_agg[0].push_back(minima[0]);
-  max_agg[0].push_back(maxima[0]);
+  for (auto &x : min_agg) {
+    x.resize(aggregationDimensionSize);
+  }
+  for (auto &x : max_agg) {
+    x.resize(aggregationDimensionSize);
+  }
+
+  min_agg[0][0] = minima[0];
+  max_agg[0][0] = maxima[0];
   for (int32_t i = 1; i < aggregationDimensionSize; i++) {
-    min_agg[0].push_back(std::min(min_agg[0][i - 1], minima[i]));
-    max_agg[0].push_back(std::max(max_agg[0][i - 1], maxima[i]));
+    min_agg[0][i] = std::min(min_agg[0][i - 1], minima[i]);
+    max_agg[0][i] = std::max(max_agg[0][i - 1], maxima[i]);
   }
-  min_agg[1].push_front(minima[aggregationDimensionSize - 1]);
-  max_agg[1].push_front(maxima[aggregationDimensionSize - 1]);
-  for (int32_t i = aggregationDimensionSize - 2; i >= 0; i--) {
-    min_agg[1].push_front(std::min(min_agg[1][0], minima[i]));
-    max_agg[1].push_front(std::max(max_agg[1][0], maxima[i]));
+  const auto last = aggregationDimensionSize - 1;
+  min_agg[1][last] = minima[last];
+  max_agg[1][last] = maxima[last];
+  for (int32_t i = last - 1; i >= 0; i--) {
+    min_agg[1][i] = std::min(min_agg[1][i + 1], minima[i]);
+    max_agg[1][i] = std::max(max_agg[1][i + 1], maxima[i]);
   }
   return {min_agg, max_agg};
 }
 
-auto Cluster::computeMinAndMaxVectors(const ClusteringMap &clusteringMap,
-                                      bool aggregateHorizontally) const
-    -> std::tuple<std::vector<int32_t>, std::vector<int32_t>> {
+auto Cluster::computeExtents(const ClusteringMap &clusteringMap, bool aggregateHorizontally) const
+    -> Extents {
   const auto dim1 = aggregateHorizontally ? height() : width();
-  const auto dim2 = aggregateHorizontally ? width() : height();
   const auto minDim1 = aggregateHorizontally ? imin() : jmin();
   const auto minDim2 = aggregateHorizontally ? jmin() : imin();
+  const auto maxDim2 = aggregateHorizontally ? jmax() : imax();
 
   const auto &clusteringBuffer = clusteringMap.getPlane(0);
-  std::vector<int32_t> minima(dim1, dim2 - 1);
-  std::vector<int32_t> maxima(dim1, 0);
+  auto extents = Extents{minDim1, std::vector<int32_t>(dim1, -1), std::vector<int32_t>(dim1, -1)};
 
   for (int32_t k = 0; k < dim1; k++) {
     int32_t i = k + minDim1;
 
-    for (int32_t l = 0; l < dim2; l++) {
-      int32_t j = l + minDim2;
+    const auto isInCluster = [&](int32_t j) {
       const auto bufferValue =
           aggregateHorizontally ? clusteringBuffer(i, j) : clusteringBuffer(j, i);
-      if (bufferValue == getClusterId()) {
-        minima[k] = l;
+      return bufferValue == getClusterId();
+    };
+
+    for (int32_t j = minDim2; j <= maxDim2; j++) {
+      if (isInCluster(j)) {
+        extents.first[k] = j;
         break;
       }
     }
 
-    for (int32_t l = dim2 - 1; l >= 0; l--) {
-      int32_t j = l + minDim2;
-      const auto bufferValue =
-          aggregateHorizontally ? clusteringBuffer(i, j) : clusteringBuffer(j, i);
-      if (bufferValue == getClusterId()) {
-        maxima[k] = l;
+    for (int32_t j = maxDim2; 0 <= extents.first[k] && extents.first[k] <= j; j--) {
+      if (isInCluster(j)) {
+        extents.last[k] = j;
         break;
       }
     }
   }
 
+  return extents;
+}
+
+auto Cluster::computeMinAndMaxVectors(const Extents &extents, bool aggregateHorizontally) const
+    -> std::tuple<std::vector<int32_t>, std::vector<int32_t>> {
+  const auto dim1 = aggregateHorizontally ? height() : width();
+  const auto dim2 = aggregateHorizontally ? width() : height();
+  const auto minDim1 = aggregateHorizontally ? imin() : jmin();
+  const auto minDim2 = aggregateHorizontally ? jmin() : imin();
+
+  std::vector<int32_t> minima(dim1, dim2 - 1);
+  std::vector<int32_t> maxima(dim1, 0);
+
+  for (int32_t k = 0; k < dim1; k++) {
+    const auto n = static_cast<size_t>(k + minDim1 - extents.offset);
+
+    if (0 <= extents.first[n]) {
+      minima[k] = extents.first[n] - minDim2;
+      maxima[k] = extents.last[n] - minDim2;
+    }
+  }
+
   return {minima, maxima};
 }
 
@@ -37,6 +37,20 @@
 namespace TMIV::Packer {
 constexpr auto occupied = uint8_t{128};
 
+namespace {
+// Erase the flagged elements while preserving the order of the other elements
+template <typename T> void eraseFlagged(std::vector<T> &v, const std::vector<bool> &flags) {
+  auto out = v.begin();
+
+  for (size_t i = 0; i < v.size(); ++i) {
+    if (!flags[i]) {
+      *out++ = v[i];
+    }
+  }
+  v.erase(out, v.end());
+}
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 auto MaxRectPiP::Rectangle::split(int32_t w, int32_t h) const
     -> std::vector<MaxRectPiP::Rectangle> {
@@ -105,6 +119,11 @@ MaxRectPiP::MaxRectPiP(int32_t w, int32_t h, int32_t a, bool pip) : m_alignment(
   m_occupancyMap.resize({ha, wa});
   std::fill(m_occupancyMap.begin(), m_occupancyMap.end(), uint8_t{});
 
+  m_occupiedSum.resize({ha + 1, wa + 1});
+  std::fill(m_occupiedSum.begin(), m_occupiedSum.end(), 0);
+  m_nextOccupied.resize({ha, wa + 1});
+  std::fill(m_nextOccupied.begin(), m_nextOccupied.end(), static_cast<int32_t>(wa));
+
   // Push full rectangle
   m_F.emplace_back(0, 0, w - 1, h - 1);
 }
@@ -145,6 +164,14 @@ void MaxRectPiP::updateOccupancyMap(const Cluster &c, const ClusteringMap &clust
   int32_t YMin = q0.y() / m_alignment;
   int32_t YLast = (q0.y() + (isRotated ? w : h) - 1) / m_alignment + 1;
 
+  if (m_dirtyRowBegin < m_dirtyRowEnd) {
+    m_dirtyRowBegin = std::min(m_dirtyRowBegin, YMin);
+    m_dirtyRowEnd = std::max(m_dirtyRowEnd, YLast);
+  } else {
+    m_dirtyRowBegin = YMin;
+    m_dirtyRowEnd = YLast;
+  }
+
   for (auto Y = YMin; Y < YLast; Y++) {
     std::fill(m_occupancyMap.row_begin(Y) + XMin, m_occupancyMap.row_begin(Y) + XLast, occupied);
   }
@@ -178,37 +205,64 @@ void MaxRectPiP::updateOccupancyMap(const Cluster &c, const ClusteringMap &clust
   }
 }
 
+void MaxRectPiP::updateOccupiedSum() {
+  // Only the rows of the occupancy map that have changed need to be scanned again, but the
+  // summed-area table changes for all rows below them
+  const auto H = static_cast<int32_t>(m_occupancyMap.height());
+  const auto W = static_cast<int32_t>(m_occupancyMap.width());
+
+  for (auto Y = m_dirtyRowBegin; Y < m_dirtyRowEnd; ++Y) {
+    for (auto X = W; X-- > 0;) {
+      m_nextOccupied(Y, X) = m_occupancyMap(Y, X) == occupied ? X : m_nextOccupied(Y, X + 1);
+    }
+  }
+
+  for (auto Y = m_dirtyRowBegin; Y < H && m_dirtyRowBegin < m_dirtyRowEnd; ++Y) {
+    auto rowSum = 0;
+
+    for (auto X = 0; X < W; ++X) {
+      rowSum += m_occupancyMap(Y, X) == occupied ? 1 : 0;
+      m_occupiedSum(Y + 1, X + 1) = m_occupiedSum(Y, X + 1) + rowSum;
+    }
+  }
+
+  m_dirtyRowBegin = m_dirtyRowEnd = 0;
+}
+
+auto MaxRectPiP::isOccupied(int32_t xmin, int32_t xmax, int32_t ymin, int32_t ymax) const -> bool {
+  if (static_cast<int32_t>(m_occupancyMap.width()) <= xmax ||
+      static_cast<int32_t>(m_occupancyMap.height()) <= ymax) {
+    return false;
+  }
+  const auto count = m_occupiedSum(ymax + 1, xmax + 1) - m_occupiedSum(ymin, xmax + 1) -
+                     m_occupiedSum(ymax + 1, xmin) + m_occupiedSum(ymin, xmin);
+  return count == (xmax - xmin + 1) * (ymax - ymin + 1);
+}
+
 auto MaxRectPiP::pushInUsedSpace(int32_t w, int32_t h, bool isBasicView,
                                  MaxRectPiP::Output &packerOutput) -> bool {
   int32_t W = w / m_alignment;
   int32_t H = h / m_alignment;
 
-  auto isGoodCandidate = [this](int32_t xmin, int32_t xmax, int32_t ymin, int32_t ymax) -> bool {
-    if ((xmax < static_cast<int32_t>(m_occupancyMap.width())) &&
-        (ymax < static_cast<int32_t>(m_occupancyMap.height()))) {
-      for (int32_t y = ymin; y <= ymax; y++) {
-        for (int32_t x = xmin; x <= xmax; x++) {
-          if (m_occupancyMap(y, x) != occupied) {
-            return false;
-          }
-        }
-      }
+  updateOccupiedSum();
 
-      return true;
-    }
-    { return false; }
-  };
+  // Early out when there are not enough occupied blocks in total
+  if (m_occupiedSum(m_occupancyMap.height(), m_occupancyMap.width()) < W * H) {
+    return false;
+  }
 
+  // Both orientations require the top-left block to be occupied, so the others are skipped
   for (auto Y = 0; Y < static_cast<int32_t>(m_occupancyMap.height()); ++Y) {
-    for (auto X = 0; X < static_cast<int32_t>(m_occupancyMap.width()); ++X) {
+    for (auto X = m_nextOccupied(Y, 0); X < static_cast<int32_t>(m_occupancyMap.width());
+         X = m_nextOccupied(Y, X + 1)) {
       // Without Rotation
-      if (isGoodCandidate(X, X + W - 1, Y, Y + H - 1)) {
+      if (isOccupied(X, X + W - 1, Y, Y + H - 1)) {
         packerOutput.set(X * m_alignment, Y * m_alignment, false);
         return true;
       }
 
       // With Rotation
-      if (!isBasicView && isGoodCandidate(X, X + H - 1, Y, Y + W - 1)) {
+      if (!isBasicView && isOccupied(X, X + H - 1, Y, Y + W - 1)) {
         packerOutput.set(X * m_alignment, Y * m_alignment, true);
         return true;
       }
@@ -252,42 +306,30 @@ auto MaxRectPiP::pushInFreeSpace(int32_t w, int32_t h, bool isBasicView,
 
   // Split current free rectangle
   std::vector<Rectangle> splitted = best_iter->split(B.width(), B.height());
-  std::move(splitted.begin(), splitted.end(), back_inserter(m_F));
-
   m_F.erase(best_iter);
 
-  // Intersection with existing free rectangles
-  std::vector<std::list<Rectangle>::const_iterator> intersected;
-  auto last = m_F.cend();
+  // New free rectangles are appended, such that they form a suffix of the list
+  auto firstNew = m_F.size();
+  m_F.insert(m_F.end(), splitted.begin(), splitted.end());
+
+  // Intersection with existing free rectangles (including those that are appended in this loop)
+  std::vector<bool> intersected(m_F.size(), false);
 
-  for (auto iter = m_F.cbegin(); iter != last; iter++) {
-    std::vector<Rectangle> intersecting = iter->remove(B);
+  for (size_t i = 0; i < m_F.size(); ++i) {
+    std::vector<Rectangle> intersecting = m_F[i].remove(B);
 
     if (!intersecting.empty()) {
-      intersected.push_back(iter);
-      std::move(intersecting.begin(), intersecting.end(), back_inserter(m_F));
+      intersected[i] = true;
+      m_F.insert(m_F.end(), intersecting.begin(), intersecting.end());
+      intersected.resize(m_F.size(), false);
     }
   }
 
-  for (const auto &iter : intersected) {
-    m_F.erase(iter);
-  }
-
-  // Degenerated free rectangles
-  std::vector<std::list<Rectangle>::const_iterator> degenerated;
-
-  for (auto iter1 = m_F.cbegin(); iter1 != m_F.cend(); iter1++) {
-    for (auto iter2 = m_F.cbegin(); iter2 != m_F.cend(); iter2++) {
-      if ((iter1 != iter2) && (iter1->isInside(*iter2))) {
-        degenerated.push_back(iter1);
-        break;
-      }
-    }
-  }
+  firstNew -= static_cast<size_t>(std::count(
+      intersected.cbegin(), intersected.cbegin() + static_cast<ptrdiff_t>(firstNew), true));
+  eraseFlagged(m_F, intersected);
 
-  for (const auto &iter : degenerated) {
-    m_F.erase(iter);
-  }
+  removeDegeneratedFreeRectangles(firstNew);
 
   // Update output
   packerOutput.set(B.left(), B.bottom(), best_rotation);
@@ -296,4 +338,21 @@ auto MaxRectPiP::pushInFreeSpace(int32_t w, int32_t h, bool isBasicView,
 
   return true;
 }
+
+void MaxRectPiP::removeDegeneratedFreeRectangles(size_t firstNew) {
+  // The free rectangles before firstNew are not inside each other, so only pairs that involve a new
+  // free rectangle have to be tested.
+  std::vector<bool> degenerated(m_F.size(), false);
+
+  for (size_t i = 0; i < m_F.size(); ++i) {
+    for (size_t j = i < firstNew ? firstNew : 0; j < m_F.size(); ++j) {
+      if (i != j && m_F[i].isInside(m_F[j])) {
+        degenerated[i] = true;
+        break;
+      }
+    }
+  }
+
+  eraseFlagged(m_F, degenerated);
+}
 } // namespace TMIV::Packer
@@ -35,7 +35,8 @@
 #define TMIV_PACKER_MAXRECTPIP_H
 
 #include <TMIV/Packer/Cluster.h>
-#include <list>
+
+#include <vector>
 
 namespace TMIV::Packer {
 class MaxRectPiP {
@@ -84,10 +85,19 @@ private:
   };
 
   int32_t m_alignment = 0;
-  std::list<Rectangle> m_F;
+
+  // The free rectangles in order of creation. No free rectangle is inside another one.
+  std::vector<Rectangle> m_F;
   bool m_pip = true;
   OccupancyMap m_occupancyMap;
 
+  // Summed-area table of occupied blocks with a zero top row and left column, and for each block
+  // the column of the first occupied block at or right of it. Both are updated lazily.
+  Common::Mat<int32_t> m_occupiedSum;
+  Common::Mat<int32_t> m_nextOccupied;
+  int32_t m_dirtyRowBegin{};
+  int32_t m_dirtyRowEnd{};
+
 public:
   MaxRectPiP(int32_t w, int32_t h, int32_t a, bool pip);
   auto push(const Cluster &c, const ClusteringMap &clusteringMap, Output &packerOutput) -> bool;
@@ -102,7 +112,11 @@ public:
 private:
   void updateOccupancyMap(const Cluster &c, const ClusteringMap &clusteringMap,
                           const Output &packerOutput);
+  void updateOccupiedSum();
+  [[nodiscard]] auto isOccupied(int32_t xmin, int32_t xmax, int32_t ymin, int32_t ymax) const
+      -> bool;
   auto pushInUsedSpace(int32_t w, int32_t h, bool isBasicView, Output &packerOutput) -> bool;
+  void removeDegeneratedFreeRectangles(size_t firstNew);
   auto pushInFreeSpace(int32_t w, int32_t h, bool isBasicView, Output &packerOutput) -> bool;
 
   bool m_isPushInFreeSpace{};
@@ -31,6 +31,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+//#define CATCH_CONFIG_ENABLE_BENCHMARKING // Uncomment me to run benchmarks
 #include <catch2/catch.hpp>
 
 #include "MaxRectPiP.h"
@@ -42,6 +43,38 @@ using TMIV::Packer::Cluster;
 using TMIV::Packer::ClusteringMap;
 using TMIV::Packer::MaxRectPiP;
 
+namespace {
+// A clustering map with many small rectangular clusters that are sparsely populated
+auto randomClusters(int32_t count, int32_t maxSize, uint32_t seed) {
+  std::mt19937 rnd{seed};
+  const auto size = 1024;
+  auto map = ClusteringMap::lumaOnly({size, size});
+  auto clusters = std::vector<Cluster>{};
+
+  for (int32_t c = 0; c < count; ++c) {
+    const auto w = 1 + static_cast<int32_t>(rnd() % static_cast<uint32_t>(maxSize));
+    const auto h = 1 + static_cast<int32_t>(rnd() % static_cast<uint32_t>(maxSize));
+    const auto i0 = static_cast<int32_t>(rnd() % static_cast<uint32_t>(size - h));
+    const auto j0 = static_cast<int32_t>(rnd() % static_cast<uint32_t>(size - w));
+
+    auto &cluster = clusters.emplace_back(0, c % 4 == 0, c + 1, 0);
+
+    const auto add = [&](int32_t i, int32_t j) {
+      cluster.push(i, j);
+      map.getPlane(0)(i, j) = static_cast<DefaultElement>(c + 1);
+    };
+    add(i0, j0);
+    add(i0 + h - 1, j0 + w - 1);
+
+    for (int32_t n = 0; n < w * h / 4; ++n) {
+      add(i0 + static_cast<int32_t>(rnd() % static_cast<uint32_t>(h)),
+          j0 + static_cast<int32_t>(rnd() % static_cast<uint32_t>(w)));
+    }
+  }
+  return std::pair{map, clusters};
+}
+} // namespace
+
 TEST_CASE("TMIV::Packer::MaxRectPiP") {
   const auto viewIdx = 100;
   const auto isBasicView = GENERATE(false, true);
@@ -99,3 +132,61 @@ TEST_CASE("TMIV::Packer::MaxRectPiP") {
     CHECK(output2.isRotated() != isBasicView);
   }
 }
+
+TEST_CASE("TMIV::Packer::MaxRectPiP with many clusters") {
+  const auto [map, clusters] = randomClusters(500, 40, 5);
+  const auto atlasSize = 512;
+  const auto alignment = 8;
+
+  auto unit = MaxRectPiP{atlasSize, atlasSize, alignment, false};
+  auto used = TMIV::Common::Mat<uint8_t>({atlasSize, atlasSize});
+  auto packedCount = 0;
+
+  for (const auto &cluster : clusters) {
+    auto output = MaxRectPiP::Output{};
+
+    if (unit.push(cluster, map, output)) {
+      ++packedCount;
+      const auto w = TMIV::Common::align(cluster.width(), alignment);
+      const auto h = TMIV::Common::align(cluster.height(), alignment);
+      const auto W = output.isRotated() ? h : w;
+      const auto H = output.isRotated() ? w : h;
+
+      REQUIRE(0 <= output.x());
+      REQUIRE(0 <= output.y());
+      REQUIRE(output.x() + W <= atlasSize);
+      REQUIRE(output.y() + H <= atlasSize);
+      REQUIRE((!cluster.isBasicView() || !output.isRotated()));
+
+      // Without PiP the patches are not overlapping
+      for (int32_t y = output.y(); y < output.y() + H; ++y) {
+        for (int32_t x = output.x(); x < output.x() + W; ++x) {
+          REQUIRE(used(y, x) == 0);
+          used(y, x) = 1;
+        }
+      }
+    }
+  }
+
+  CHECK(100 < packedCount);
+  CHECK(packedCount < 500);
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Benchmark: MaxRectPiP packing") {
+  const auto [map, clusters] = randomClusters(2000, 40, 7);
+
+  for (const auto pip : {false, true}) {
+    BENCHMARK(pip ? "2000 clusters with PiP" : "2000 clusters without PiP") {
+      auto unit = MaxRectPiP{2048, 2048, 8, pip};
+      auto packedCount = 0;
+
+      for (const auto &cluster : clusters) {
+        auto output = MaxRectPiP::Output{};
+        packedCount += unit.push(cluster, map, output) ? 1 : 0;
+      }
+      return packedCount;
+    };
+  }
+}
+#endif
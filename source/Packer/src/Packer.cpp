@@ -34,6 +34,7 @@
 #include <TMIV/Packer/Packer.h>
 
 #include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/Thread.h>
 #include <TMIV/Packer/Retriever.h>
 
 #include "MaxRectPiP.h"
@@ -343,46 +344,52 @@ auto Packer::computeClusters(const Common::FrameList<uint8_t> &masks,
   ClusterList clusterList{};
   ClusteringMapList clusteringMap{};
   std::vector<int32_t> clusteringMapIndex{};
-  int32_t index = 0;
-  for (auto viewIdx = 0; viewIdx < static_cast<int32_t>(masks.size()); viewIdx++) {
+
+  // Clusters are retrieved concurrently for each view (and entity) with cluster ID's that start at
+  // zero, and then renumbered in order.
+  const auto entityCount =
+      m_maxEntityId > 0 ? static_cast<size_t>(m_entityEncodeRange[1] - m_entityEncodeRange[0])
+                        : size_t{1};
+  auto clusteringOutputs = std::vector<std::pair<ClusterList, ClusteringMap>>(
+      masks.size() * entityCount);
+
+  Common::parallel_for(clusteringOutputs.size(), [&](size_t index) {
+    const auto viewIdx = static_cast<int32_t>(index / entityCount);
+    const auto &mask = m_maxEntityId > 0 ? m_aggregatedEntityMasks[index % entityCount][viewIdx]
+                                         : masks[viewIdx];
+    auto &clusteringOutput = clusteringOutputs[index];
+
+    clusteringOutput = retrieveClusters(viewIdx, mask, 0, viewParamsList[viewIdx].isBasicView,
+                                        m_enableMerging, m_maxEntityId > 0);
+
     if (m_maxEntityId > 0) {
-      for (int32_t entityId = m_entityEncodeRange[0]; entityId < m_entityEncodeRange[1];
-           entityId++) {
-        // Entity clustering
-        Common::Frame<uint8_t> mask =
-            m_aggregatedEntityMasks[entityId - m_entityEncodeRange[0]][viewIdx];
-
-        auto clusteringOutput = retrieveClusters(
-            viewIdx, mask, static_cast<int32_t>(clusterList.size()),
-            viewParamsList[viewIdx].isBasicView, m_enableMerging, m_maxEntityId > 0);
-
-        for (auto &cluster : clusteringOutput.first) {
-          cluster = Cluster::setEntityId(cluster, entityId);
-        }
+      const auto entityId = m_entityEncodeRange[0] + static_cast<int32_t>(index % entityCount);
 
-        std::move(clusteringOutput.first.begin(), clusteringOutput.first.end(),
-                  back_inserter(clusterList));
-        clusteringMap.push_back(std::move(clusteringOutput.second));
+      for (auto &cluster : clusteringOutput.first) {
+        cluster = Cluster::setEntityId(cluster, entityId);
+      }
+    }
+  });
 
-        for (size_t i = 0; i < clusteringOutput.first.size(); i++) {
-          clusteringMapIndex.push_back(index);
-        }
+  for (size_t index = 0; index < clusteringOutputs.size(); ++index) {
+    auto &clusteringOutput = clusteringOutputs[index];
+    offsetClusterIds(clusteringOutput, static_cast<int32_t>(clusterList.size()));
 
-        if (!clusteringOutput.first.empty()) {
-          Common::logVerbose("entity {} from view {} results in {} patches", entityId, viewIdx,
-                             clusteringOutput.first.size());
-        }
-        ++index;
+    if (m_maxEntityId > 0) {
+      for (size_t i = 0; i < clusteringOutput.first.size(); i++) {
+        clusteringMapIndex.push_back(static_cast<int32_t>(index));
       }
-    } else {
-      auto clusteringOutput =
-          retrieveClusters(viewIdx, masks[viewIdx], static_cast<int32_t>(clusterList.size()),
-                           viewParamsList[viewIdx].isBasicView, m_enableMerging, m_maxEntityId > 0);
 
-      std::move(clusteringOutput.first.begin(), clusteringOutput.first.end(),
-                back_inserter(clusterList));
-      clusteringMap.push_back(std::move(clusteringOutput.second));
+      if (!clusteringOutput.first.empty()) {
+        Common::logVerbose("entity {} from view {} results in {} patches",
+                           m_entityEncodeRange[0] + static_cast<int32_t>(index % entityCount),
+                           index / entityCount, clusteringOutput.first.size());
+      }
     }
+
+    std::move(clusteringOutput.first.begin(), clusteringOutput.first.end(),
+              back_inserter(clusterList));
+    clusteringMap.push_back(std::move(clusteringOutput.second));
   }
   if (m_maxEntityId > 0) {
     Common::logInfo("clusteringMap size = {} with total # clusters = {}", clusteringMap.size(),
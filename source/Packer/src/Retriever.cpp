@@ -40,78 +40,67 @@ static const uint16_t INVALID = 65535;
 using Common::Vec2i;
 
 namespace {
-template <typename ClusterBufferType> class SubRegionGrower {
-public:
-  SubRegionGrower(ClusterList &clusterList, int32_t A, int32_t B, const Cluster &cluster,
-                  std::queue<Vec2i> &candidates, ClusterBufferType &clusteringBuffer)
-      : m_clusterList{clusterList}
-      , m_A{A}
-      , m_B{B}
-      , m_cluster{cluster}
-      , m_candidates{candidates}
-      , m_clusteringBuffer{clusteringBuffer} {}
-
-  auto operator()(int32_t ID) {
-    Cluster subCluster(m_cluster.getViewIdx(), m_cluster.isBasicView(), ID,
-                       m_cluster.getEntityId());
-    while (!m_candidates.empty()) {
-      const auto a = m_candidates.front().x();
-      const auto b = m_candidates.front().y();
-
-      subCluster.push(a, b);
-      m_clusteringBuffer(a, b) = static_cast<uint16_t>(ID);
-
-      if (0 < a) {
-        addCandidate(a - 1, b, ID, subCluster);
-        if (0 < b) {
-          addCandidate(a - 1, b - 1, ID, subCluster);
-        }
-        if (b < m_B - 1) {
-          addCandidate(a - 1, b + 1, ID, subCluster);
-        }
+// Label the 8-connected region of active pixels that contains the seed with the specified ID, and
+// add its pixels to the cluster. Each horizontal run of active pixels is labeled at once, and only
+// the start of each run in the neighboring rows is pushed on the stack.
+template <typename ClusterBufferType>
+void fillRegion(ClusterBufferType &clusteringBuffer, int32_t A, int32_t B, Vec2i seed, int32_t ID,
+                Cluster &cluster, std::vector<Vec2i> &stack) {
+  stack.push_back(seed);
+
+  while (!stack.empty()) {
+    const auto a = stack.back().x();
+    const auto b = stack.back().y();
+    stack.pop_back();
+
+    if (clusteringBuffer(a, b) != ACTIVE) {
+      continue;
+    }
+
+    auto b0 = b;
+    while (0 < b0 && clusteringBuffer(a, b0 - 1) == ACTIVE) {
+      --b0;
+    }
+    auto b1 = b;
+    while (b1 < B - 1 && clusteringBuffer(a, b1 + 1) == ACTIVE) {
+      ++b1;
+    }
+
+    for (auto j = b0; j <= b1; ++j) {
+      cluster.push(a, j);
+      clusteringBuffer(a, j) = static_cast<uint16_t>(ID);
+    }
+
+    for (const auto i : {a - 1, a + 1}) {
+      if (i < 0 || A <= i) {
+        continue;
       }
-      if (a < m_A - 1) {
-        addCandidate(a + 1, b, ID, subCluster);
-        if (0 < b) {
-          addCandidate(a + 1, b - 1, ID, subCluster);
-        }
-        if (b < m_B - 1) {
-          addCandidate(a + 1, b + 1, ID, subCluster);
+      auto inRun = false;
+
+      for (auto j = std::max(0, b0 - 1); j <= std::min(B - 1, b1 + 1); ++j) {
+        const auto active = clusteringBuffer(i, j) == ACTIVE;
+
+        if (active && !inRun) {
+          stack.push_back({i, j});
         }
+        inRun = active;
       }
-      if (0 < b) {
-        addCandidate(a, b - 1, ID, subCluster);
-      }
-      if (b < m_B - 1) {
-        addCandidate(a, b + 1, ID, subCluster);
-      }
-      m_candidates.pop();
-    }
-    m_clusterList.push_back(subCluster);
-  }
-
-private:
-  void addCandidate(int32_t a, int32_t b, int32_t ID, Cluster &subCluster) {
-    if (m_clusteringBuffer(a, b) == ACTIVE) {
-      m_candidates.push({a, b});
-      subCluster.push(a, b);
-      m_clusteringBuffer(a, b) = static_cast<uint16_t>(ID);
     }
   }
-
-  ClusterList &m_clusterList;
-  int32_t m_A;
-  int32_t m_B;
-  const Cluster &m_cluster;
-  std::queue<Vec2i> &m_candidates;
-  ClusterBufferType &m_clusteringBuffer;
-};
+}
 
 template <typename ClusterBufferType>
 auto mergePatches(ClusterList &clusterList, int32_t A, int32_t B, const Cluster &cluster,
-                  std::queue<Vec2i> candidates, ClusterBufferType &clusteringBuffer) -> int32_t {
-  SubRegionGrower<ClusterBufferType> growSubRegion{clusterList, A,          B,
-                                                   cluster,     candidates, clusteringBuffer};
+                  ClusterBufferType &clusteringBuffer, std::vector<Vec2i> &stack) -> int32_t {
+  const auto growSubRegion = [&](Vec2i seed, int32_t ID) {
+    Cluster subCluster(cluster.getViewIdx(), cluster.isBasicView(), ID, cluster.getEntityId());
+    fillRegion(clusteringBuffer, A, B, seed, ID, subCluster, stack);
+
+    // NOTE: The original region grower counted all pixels of a sub-region but the first one twice.
+    // This count is kept because it affects the order in which the clusters are packed.
+    subCluster.numActivePixels() = 2 * subCluster.numActivePixels() - 1;
+    clusterList.push_back(subCluster);
+  };
 
   const auto i_top = cluster.imin();
   const auto i_bottom = cluster.imax();
@@ -123,8 +112,7 @@ auto mergePatches(ClusterList &clusterList, int32_t A, int32_t B, const Cluster
   if (j_left != 0) {
     for (int32_t i_unit = i_top; i_unit <= i_bottom; i_unit++) {
       if (clusteringBuffer(i_unit, j_left - 1) == ACTIVE) {
-        candidates.push({i_unit, j_left - 1});
-        growSubRegion(++subClusterId);
+        growSubRegion({i_unit, j_left - 1}, ++subClusterId);
       }
     }
   }
@@ -132,8 +120,7 @@ auto mergePatches(ClusterList &clusterList, int32_t A, int32_t B, const Cluster
   if (j_right != B - 1) {
     for (int32_t i_unit = i_top; i_unit <= i_bottom; i_unit++) {
       if (clusteringBuffer(i_unit, j_right + 1) == ACTIVE) {
-        candidates.push({i_unit, j_right + 1});
-        growSubRegion(++subClusterId);
+        growSubRegion({i_unit, j_right + 1}, ++subClusterId);
       }
     }
   }
@@ -141,8 +128,7 @@ auto mergePatches(ClusterList &clusterList, int32_t A, int32_t B, const Cluster
   if (i_bottom != A - 1) {
     for (int32_t j_unit = j_left; j_unit <= j_right; j_unit++) {
       if (clusteringBuffer(i_bottom + 1, j_unit) == ACTIVE) {
-        candidates.push({i_bottom + 1, j_unit});
-        growSubRegion(++subClusterId);
+        growSubRegion({i_bottom + 1, j_unit}, ++subClusterId);
       }
     }
   }
@@ -160,61 +146,6 @@ auto mergePatches(ClusterList &clusterList, int32_t A, int32_t B, const Cluster
   return subClusterId;
 }
 
-template <typename ClusterBufferType>
-auto getInitialCandidates(ClusterBufferType &clusteringBuffer, const int32_t A, const int32_t B,
-                          int32_t clusterId, Cluster &cluster, const div_t &dv)
-    -> std::queue<Vec2i> {
-  std::queue<Vec2i> candidates;
-  candidates.push({dv.quot, dv.rem});
-  auto tryAddCandidate = [&clusteringBuffer, &cluster, clusterId, &candidates](const Vec2i &p) {
-    uint16_t &visitedId = clusteringBuffer(p.x(), p.y());
-
-    if (visitedId == ACTIVE) {
-      cluster.push(p.x(), p.y());
-      visitedId = static_cast<uint16_t>(clusterId);
-      candidates.push({p.x(), p.y()});
-    }
-  };
-
-  while (!candidates.empty()) {
-    const auto a = candidates.front().x();
-    const auto b = candidates.front().y();
-
-    if (0 < a) {
-      tryAddCandidate({a - 1, b});
-
-      if (0 < b) {
-        tryAddCandidate({a - 1, b - 1});
-      }
-      if (b < B - 1) {
-        tryAddCandidate({a - 1, b + 1});
-      }
-    }
-
-    if (a < A - 1) {
-      tryAddCandidate({a + 1, b});
-
-      if (0 < b) {
-        tryAddCandidate({a + 1, b - 1});
-      }
-      if (b < B - 1) {
-        tryAddCandidate({a + 1, b + 1});
-      }
-    }
-
-    if (0 < b) {
-      tryAddCandidate({a, b - 1});
-    }
-    if (b < B - 1) {
-      tryAddCandidate({a, b + 1});
-    }
-
-    candidates.pop();
-  }
-
-  return candidates;
-}
-
 template <typename ClusterBufferType, typename MaskBufferType>
 auto buildActiveList(const MaskBufferType &maskBuffer, ClusterBufferType &clusteringBuffer)
     -> std::vector<int32_t> {
@@ -291,18 +222,17 @@ auto retrieveClusters(const int32_t viewIdx, const Common::Frame<uint8_t> &maskM
     clusterList.push_back(cluster);
 
   } else {
+    auto stack = std::vector<Vec2i>{};
+
     while (iter_seed != activeList.end()) {
       div_t dv = div(*iter_seed, B);
       Cluster cluster(viewIdx, isBasicView, clusterId, 0);
 
-      cluster.push(dv.quot, dv.rem);
-      clusteringBuffer(dv.quot, dv.rem) = static_cast<uint16_t>(clusterId);
-
-      auto candidates = getInitialCandidates(clusteringBuffer, A, B, clusterId, cluster, dv);
+      fillRegion(clusteringBuffer, A, B, {dv.quot, dv.rem}, clusterId, cluster, stack);
 
       const auto subClusterId = [&]() {
         if (enableMerging) {
-          return mergePatches(clusterList, A, B, cluster, std::move(candidates), clusteringBuffer);
+          return mergePatches(clusterList, A, B, cluster, clusteringBuffer, stack);
         }
         return clusterId;
       }();
@@ -315,4 +245,17 @@ auto retrieveClusters(const int32_t viewIdx, const Common::Frame<uint8_t> &maskM
   return out;
 }
 
+void offsetClusterIds(std::pair<ClusterList, ClusteringMap> &clusters, int32_t offset) {
+  if (offset == 0) {
+    return;
+  }
+  for (auto &cluster : clusters.first) {
+    cluster = Cluster::setClusterId(cluster, cluster.getClusterId() + offset);
+  }
+  for (auto &x : clusters.second.getPlane(0)) {
+    if (x != INVALID) {
+      x = static_cast<uint16_t>(x + offset);
+    }
+  }
+}
 } // namespace TMIV::Packer
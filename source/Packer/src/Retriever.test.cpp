@@ -35,6 +35,11 @@
 
 #include <TMIV/Packer/Retriever.h>
 
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <tuple>
+
 namespace TMIV::Packer {
 namespace {
 const uint16_t INVALID = (1 << 16) - 1;
@@ -46,6 +51,146 @@ void addRectangle(Common::Frame<uint8_t> &mask, Common::Vec2i topLeft, Common::V
     }
   }
 }
+
+// A C-shape, an L-shape with a diagonal band, and speckles, such that there are many clusters of
+// which some are large enough to be split
+auto nonTrivialMask() {
+  auto mask = Common::Frame<uint8_t>::lumaOnly({256, 160});
+  auto rnd = std::mt19937{7};
+
+  for (int32_t i = 0; i < 160; ++i) {
+    for (int32_t j = 0; j < 256; ++j) {
+      const auto r2 = (i - 75) * (i - 75) + (j - 75) * (j - 75);
+      const auto shapeC = 45 * 45 <= r2 && r2 <= 70 * 70 && !(j > 100 && std::abs(i - 75) < 25);
+      const auto shapeL = (20 <= i && i <= 150 && 170 <= j && j <= 185) ||
+                          (135 <= i && i <= 150 && 120 <= j && j <= 250);
+      const auto band = std::abs(i - (j - 150)) < 6 && j < 240;
+      const auto speckle = rnd() % 200 == 0;
+      mask.getPlane(0)(i, j) = shapeC || shapeL || band || speckle ? 1 : 0;
+    }
+  }
+  return mask;
+}
+
+// The cluster retrieval as it was before retrieveClusters() labeled runs of pixels: a
+// breadth-first flood fill of 8-connected pixels, for a non-basic view without entities.
+//
+// The original sub-region grower added all pixels of a sub-region but the first one twice to the
+// cluster. This is reproduced, because retrieveClusters() sets the number of active pixels of a
+// sub-region to 2 * n - 1 for the only reason of keeping the resulting count.
+auto referenceRetrieveClusters(int32_t viewIdx, const Common::Frame<uint8_t> &maskMap,
+                               int32_t firstClusterId, bool enableMerging)
+    -> std::pair<ClusterList, ClusteringMap> {
+  static constexpr auto active = uint16_t{65534};
+
+  auto clusterList = ClusterList{};
+  auto clusteringMap = ClusteringMap::lumaOnly({maskMap.getWidth(), maskMap.getHeight()});
+  auto &buffer = clusteringMap.getPlane(0);
+  const auto A = maskMap.getHeight();
+  const auto B = maskMap.getWidth();
+
+  auto activeList = std::vector<int32_t>{};
+
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    if (0 < maskMap.getPlane(0)[i]) {
+      activeList.push_back(static_cast<int32_t>(i));
+      buffer[i] = active;
+    } else {
+      buffer[i] = INVALID;
+    }
+  }
+
+  // Flood fill from the queued candidates. Each newly labeled pixel is added to the cluster, and
+  // the sub-region grower also added each pixel that it took from the queue.
+  const auto grow = [&](std::queue<Common::Vec2i> &candidates, Cluster &cluster, int32_t id,
+                        bool pushDequeued) {
+    while (!candidates.empty()) {
+      const auto a = candidates.front().x();
+      const auto b = candidates.front().y();
+      candidates.pop();
+
+      if (pushDequeued) {
+        cluster.push(a, b);
+      }
+      for (const auto &[da, db] : {std::pair{-1, 0}, {-1, -1}, {-1, 1}, {1, 0}, {1, -1}, {1, 1},
+                                   {0, -1}, {0, 1}}) {
+        const auto i = a + da;
+        const auto j = b + db;
+
+        if (0 <= i && i < A && 0 <= j && j < B && buffer(i, j) == active) {
+          cluster.push(i, j);
+          buffer(i, j) = static_cast<uint16_t>(id);
+          candidates.push({i, j});
+        }
+      }
+    }
+  };
+
+  auto clusterId = firstClusterId;
+  auto iterSeed = activeList.cbegin();
+
+  while (iterSeed != activeList.cend()) {
+    const auto dv = std::div(*iterSeed, B);
+    auto cluster = Cluster{viewIdx, false, clusterId, 0};
+    auto candidates = std::queue<Common::Vec2i>{};
+
+    cluster.push(dv.quot, dv.rem);
+    buffer(dv.quot, dv.rem) = static_cast<uint16_t>(clusterId);
+    candidates.push({dv.quot, dv.rem});
+    grow(candidates, cluster, clusterId, false);
+
+    auto subClusterId = clusterId;
+
+    if (enableMerging) {
+      const auto growSubRegion = [&](int32_t i, int32_t j) {
+        auto subCluster = Cluster{viewIdx, false, ++subClusterId, 0};
+        buffer(i, j) = static_cast<uint16_t>(subClusterId);
+        candidates.push({i, j});
+        grow(candidates, subCluster, subClusterId, true);
+        clusterList.push_back(subCluster);
+      };
+
+      for (int32_t i = cluster.imin(); 0 < cluster.jmin() && i <= cluster.imax(); ++i) {
+        if (buffer(i, cluster.jmin() - 1) == active) {
+          growSubRegion(i, cluster.jmin() - 1);
+        }
+      }
+      for (int32_t i = cluster.imin(); cluster.jmax() < B - 1 && i <= cluster.imax(); ++i) {
+        if (buffer(i, cluster.jmax() + 1) == active) {
+          growSubRegion(i, cluster.jmax() + 1);
+        }
+      }
+      for (int32_t j = cluster.jmin(); cluster.imax() < A - 1 && j <= cluster.jmax(); ++j) {
+        if (buffer(cluster.imax() + 1, j) == active) {
+          growSubRegion(cluster.imax() + 1, j);
+        }
+      }
+      for (int32_t i = cluster.imin(); i <= cluster.imax(); ++i) {
+        for (int32_t j = cluster.jmin(); j <= cluster.jmax(); ++j) {
+          if (buffer(i, j) == active) {
+            buffer(i, j) = static_cast<uint16_t>(clusterId);
+          }
+        }
+      }
+    }
+
+    const auto prevSeed = iterSeed;
+    iterSeed = std::find_if(iterSeed + 1, activeList.cend(),
+                            [&buffer](int32_t i) { return buffer[i] == active; });
+    cluster.numActivePixels() = static_cast<int32_t>(std::distance(prevSeed, iterSeed));
+
+    clusterList.push_back(cluster);
+    clusterId = subClusterId + 1;
+  }
+  return {clusterList, clusteringMap};
+}
+
+auto sameCluster(const Cluster &a, const Cluster &b) {
+  return a.getViewIdx() == b.getViewIdx() && a.getClusterId() == b.getClusterId() &&
+         a.getEntityId() == b.getEntityId() && a.imin() == b.imin() && a.jmin() == b.jmin() &&
+         a.imax() == b.imax() && a.jmax() == b.jmax() &&
+         a.getNumActivePixels() == b.getNumActivePixels();
+}
 } // namespace
 
 SCENARIO("Cluster retrieving") {
@@ -171,6 +316,72 @@ SCENARIO("Cluster retrieving") {
   }
 }
 
+SCENARIO("Cluster retrieving and splitting of a non-trivial mask") {
+  GIVEN("a mask with many clusters of various shapes") {
+    const auto mask = nonTrivialMask();
+    const auto enableMerging = GENERATE(false, true);
+    CAPTURE(enableMerging);
+
+    WHEN("retrieving clusters") {
+      const auto [clusterList, clusteringMap] =
+          retrieveClusters(2, mask, 5, false, enableMerging, false);
+
+      THEN("the clusters and the map are those of the original region grower") {
+        const auto [refClusterList, refClusteringMap] =
+            referenceRetrieveClusters(2, mask, 5, enableMerging);
+
+        REQUIRE(clusterList.size() == refClusterList.size());
+        REQUIRE(clusterList.size() == (enableMerging ? 80 : 145));
+
+        for (size_t i = 0; i < clusterList.size(); ++i) {
+          CAPTURE(i);
+          REQUIRE(sameCluster(clusterList[i], refClusterList[i]));
+        }
+        REQUIRE(clusteringMap.getPlane(0) == refClusteringMap.getPlane(0));
+      }
+
+      AND_WHEN("splitting the clusters") {
+        auto splitClusters = std::vector<Cluster>{};
+
+        for (const auto &cluster : clusterList) {
+          cluster.recursiveSplit(clusteringMap, splitClusters, 2, 16);
+        }
+
+        THEN("only the L-shape with the band is split, and as before") {
+          // Obtained with the implementation of recursiveSplit() that recomputed the extents of
+          // each part
+          using Part = std::tuple<int32_t, int32_t, int32_t, int32_t, int32_t>;
+          const auto expected = enableMerging ? std::vector<Part>{{0, 129, 17, 189, 203},
+                                                                  {16, 129, 76, 189, 1027},
+                                                                  {1, 188, 39, 249, 42},
+                                                                  {38, 188, 76, 244, 428},
+                                                                  {135, 120, 150, 139, 320},
+                                                                  {75, 138, 151, 251, 2964}}
+                                              : std::vector<Part>{{0, 145, 29, 185, 395},
+                                                                  {28, 170, 65, 209, 872},
+                                                                  {64, 170, 95, 209, 514},
+                                                                  {53, 208, 94, 239, 353},
+                                                                  {94, 170, 133, 185, 640},
+                                                                  {94, 239, 94, 239, 1},
+                                                                  {132, 120, 151, 251, 2147}};
+          const auto splitClusterId = 8;
+
+          REQUIRE(splitClusters.size() == clusterList.size() - 1 + expected.size());
+
+          auto actual = std::vector<Part>{};
+
+          for (const auto &c : splitClusters) {
+            if (c.getClusterId() == splitClusterId) {
+              actual.emplace_back(c.imin(), c.jmin(), c.imax(), c.jmax(), c.getNumActivePixels());
+            }
+          }
+          REQUIRE(actual == expected);
+        }
+      }
+    }
+  }
+}
+
 SCENARIO("Cluster retrieving for basic view") {
   const int32_t viewIdx = 0;
   const int32_t firstClusterId = 0;
@@ -194,4 +405,33 @@ SCENARIO("Cluster retrieving for basic view") {
   }
 }
 
+SCENARIO("Cluster ID offsetting") {
+  GIVEN("a 20x20 mask with three clusters and merging enabled") {
+    Common::Frame<uint8_t> mask{};
+    mask.createY({20, 20});
+    addRectangle(mask, {1, 1}, {10, 3});
+    addRectangle(mask, {12, 5}, {13, 18});
+    addRectangle(mask, {1, 12}, {3, 15});
+
+    WHEN("retrieving clusters with a first cluster ID of zero and offsetting the ID's") {
+      const auto firstClusterId = 7;
+      auto offsetted = retrieveClusters(0, mask, 0, false, true, false);
+      offsetClusterIds(offsetted, firstClusterId);
+
+      THEN("the result is as if the first cluster ID was offset") {
+        const auto [clusterList, clusteringMap] =
+            retrieveClusters(0, mask, firstClusterId, false, true, false);
+
+        REQUIRE(offsetted.first.size() == clusterList.size());
+        for (size_t i = 0; i < clusterList.size(); ++i) {
+          CHECK(offsetted.first[i].getClusterId() == clusterList[i].getClusterId());
+          CHECK(offsetted.first[i].getNumActivePixels() == clusterList[i].getNumActivePixels());
+        }
+        CHECK(offsetted.second.getPlane(0) == clusteringMap.getPlane(0));
+        CHECK(offsetted.second.getPlane(0)(0, 0) == INVALID);
+      }
+    }
+  }
+}
+
 } // namespace TMIV::Packer
@@ -0,0 +1,102 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_PARSER_BITRATEREPORT_H
+#define TMIV_PARSER_BITRATEREPORT_H
+
+#include <TMIV/MivBitstream/NalUnit.h>
+#include <TMIV/MivBitstream/V3cUnit.h>
+
+#include <iosfwd>
+#include <map>
+
+namespace TMIV::Parser {
+class StatisticalVariable {
+public:
+  auto operator<<(size_t value) -> StatisticalVariable &;
+
+  [[nodiscard]] auto count() const noexcept { return m_count; }
+  [[nodiscard]] auto sum() const noexcept { return m_sum; }
+
+  friend auto operator<<(std::ostream &stream, const StatisticalVariable &x) -> std::ostream &;
+
+private:
+  size_t m_count{};
+  size_t m_sum{};
+};
+
+struct CompareVuh {
+  auto operator()(const MivBitstream::V3cUnitHeader &vuh1,
+                  const MivBitstream::V3cUnitHeader &vuh2) const -> bool;
+};
+
+struct CompareNuh {
+  auto operator()(const MivBitstream::NalUnitHeader &nuh1,
+                  const MivBitstream::NalUnitHeader &nuh2) const -> bool;
+};
+
+class BitrateReport {
+public:
+  using VuhStats = std::map<MivBitstream::V3cUnitHeader, StatisticalVariable, CompareVuh>;
+  using NuhStats = std::map<MivBitstream::NalUnitHeader, StatisticalVariable, CompareNuh>;
+
+  void printTo(std::ostream &stream) const;
+
+  void add(const MivBitstream::V3cUnitHeader &vuh, size_t size) { m_vuhStats[vuh] << size; }
+  void add(const MivBitstream::NalUnitHeader &nuh, size_t size) { m_nuhStats[nuh] << size; }
+
+  [[nodiscard]] auto vuhStats() const noexcept -> auto & { return m_vuhStats; }
+  [[nodiscard]] auto nuhStats() const noexcept -> auto & { return m_nuhStats; }
+
+private:
+  VuhStats m_vuhStats;
+  NuhStats m_nuhStats;
+};
+
+// Only the sample stream, V3C unit and NAL unit headers are decoded. Payloads are skipped without
+// being parsed or copied. Units that do not fit in their enclosing unit or in the stream are
+// reported as a V3C bitstream error.
+class HeaderScanner {
+public:
+  void scanV3cSampleStream(std::istream &stream);
+  void scanV3cUnit(std::istream &stream, size_t numBytesInV3CUnit, std::streampos endPosition);
+  void scanAtlasSubBitstream(std::istream &stream, std::streampos endPosition);
+
+  [[nodiscard]] auto report() const noexcept -> auto & { return m_report; }
+
+private:
+  BitrateReport m_report;
+};
+} // namespace TMIV::Parser
+
+#endif
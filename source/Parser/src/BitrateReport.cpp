@@ -0,0 +1,201 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TMIV/Parser/BitrateReport.h>
+
+#include <TMIV/Common/Bytestream.h>
+#include <TMIV/Common/verify.h>
+#include <TMIV/MivBitstream/NalSampleStreamFormat.h>
+#include <TMIV/MivBitstream/V3cSampleStreamFormat.h>
+
+#include <limits>
+#include <ostream>
+
+namespace TMIV::Parser {
+namespace {
+// Size of the V3C unit header in bytes
+constexpr auto v3cUnitHeaderSize = size_t{4};
+
+// Size of the NAL unit header in bytes
+constexpr auto nalUnitHeaderSize = size_t{2};
+
+auto streamEnd(std::istream &stream) -> std::streampos {
+  const auto position = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  const auto result = stream.tellg();
+  stream.seekg(position);
+  VERIFY_V3CBITSTREAM(stream.good());
+  return result;
+}
+
+auto fitsWithin(std::istream &stream, uint64_t size, std::streampos endPosition) -> bool {
+  const auto position = stream.tellg();
+  return position <= endPosition && size <= static_cast<uint64_t>(endPosition - position);
+}
+} // namespace
+
+auto StatisticalVariable::operator<<(size_t value) -> StatisticalVariable & {
+  ++m_count;
+  m_sum += value;
+  return *this;
+}
+
+auto operator<<(std::ostream &stream, const StatisticalVariable &x) -> std::ostream & {
+  auto average = x.m_count > 0 ? static_cast<double>(x.m_sum) / static_cast<double>(x.m_count)
+                               : std::numeric_limits<double>::quiet_NaN();
+  return stream << x.m_count << ',' << x.m_sum << ',' << average;
+}
+
+auto CompareVuh::operator()(const MivBitstream::V3cUnitHeader &vuh1,
+                            const MivBitstream::V3cUnitHeader &vuh2) const -> bool {
+  if (vuh1.vuh_unit_type() != vuh2.vuh_unit_type()) {
+    return vuh1.vuh_unit_type() < vuh2.vuh_unit_type();
+  }
+  if (vuh1.vuh_unit_type() == MivBitstream::VuhUnitType::V3C_VPS ||
+      vuh1.vuh_unit_type() == MivBitstream::VuhUnitType::V3C_CAD) {
+    return false;
+  }
+  if (vuh1.vuh_atlas_id() != vuh2.vuh_atlas_id()) {
+    return vuh1.vuh_atlas_id() < vuh2.vuh_atlas_id();
+  }
+  if (vuh1.vuh_unit_type() != MivBitstream::VuhUnitType::V3C_GVD &&
+      vuh1.vuh_unit_type() != MivBitstream::VuhUnitType::V3C_AVD) {
+    return false;
+  }
+  if (vuh1.vuh_map_index() != vuh2.vuh_map_index()) {
+    return vuh1.vuh_map_index() < vuh2.vuh_map_index();
+  }
+  if (vuh1.vuh_unit_type() != MivBitstream::VuhUnitType::V3C_AVD) {
+    return false;
+  }
+  return vuh1.vuh_attribute_index() < vuh2.vuh_attribute_index();
+}
+
+auto CompareNuh::operator()(const MivBitstream::NalUnitHeader &nuh1,
+                            const MivBitstream::NalUnitHeader &nuh2) const -> bool {
+  if (nuh1.nal_unit_type() != nuh2.nal_unit_type()) {
+    return nuh1.nal_unit_type() < nuh2.nal_unit_type();
+  }
+  if (nuh1.nal_layer_id() != nuh2.nal_layer_id()) {
+    return nuh1.nal_layer_id() < nuh2.nal_layer_id();
+  }
+  return nuh1.nal_temporal_id_plus1() < nuh2.nal_temporal_id_plus1();
+}
+
+void BitrateReport::printTo(std::ostream &stream) const {
+  stream << "vuh_unit_type,vuh_atlas_id,vuh_map_index,vuh_attribute_index,count,sum,average\n";
+  for (const auto &[vuh, stats] : m_vuhStats) {
+    stream << vuh.vuh_unit_type() << ',';
+    switch (vuh.vuh_unit_type()) {
+    case MivBitstream::VuhUnitType::V3C_VPS:
+    case MivBitstream::VuhUnitType::V3C_CAD:
+      stream << ",,";
+      break;
+    case MivBitstream::VuhUnitType::V3C_AD:
+    case MivBitstream::VuhUnitType::V3C_OVD:
+      stream << vuh.vuh_atlas_id() << ",,";
+      break;
+    case MivBitstream::VuhUnitType::V3C_GVD:
+      stream << vuh.vuh_atlas_id() << ',' << int32_t{vuh.vuh_map_index()} << ',';
+      break;
+    case MivBitstream::VuhUnitType::V3C_AVD:
+      stream << vuh.vuh_atlas_id() << ',' << int32_t{vuh.vuh_map_index()} << ','
+             << int32_t{vuh.vuh_attribute_index()};
+      break;
+    default:
+      UNREACHABLE;
+    }
+    stream << ',' << stats << '\n';
+  }
+
+  stream << ",,,,,,\n";
+  stream << "nal_unit_type,nal_layer_id,nal_temporal_id,,count,sum,average\n";
+
+  for (const auto &[nuh, stats] : m_nuhStats) {
+    stream << nuh.nal_unit_type() << ',' << int32_t{nuh.nal_layer_id()} << ','
+           << (nuh.nal_temporal_id_plus1() - 1) << ",," << stats << '\n';
+  }
+}
+
+void HeaderScanner::scanV3cSampleStream(std::istream &stream) {
+  const auto ssvh = MivBitstream::SampleStreamV3cHeader::decodeFrom(stream);
+  const auto precisionBytes = ssvh.ssvh_unit_size_precision_bytes_minus1() + size_t{1};
+
+  // Seeking past the end of a file does not fail, so a truncated stream has to be detected here
+  const auto endOfStream = streamEnd(stream);
+
+  while (stream.peek(), !stream.eof()) {
+    const auto ssvu_v3c_unit_size = Common::readBytes(stream, precisionBytes);
+    VERIFY_V3CBITSTREAM(fitsWithin(stream, ssvu_v3c_unit_size, endOfStream));
+
+    const auto endPosition = stream.tellg() + static_cast<std::streamoff>(ssvu_v3c_unit_size);
+    scanV3cUnit(stream, ssvu_v3c_unit_size, endPosition);
+
+    // Skip the (remainder of the) payload
+    stream.seekg(endPosition);
+    VERIFY_V3CBITSTREAM(stream.good());
+  }
+}
+
+void HeaderScanner::scanV3cUnit(std::istream &stream, size_t numBytesInV3CUnit,
+                                std::streampos endPosition) {
+  VERIFY_V3CBITSTREAM(v3cUnitHeaderSize <= numBytesInV3CUnit);
+
+  const auto vuh = MivBitstream::V3cUnitHeader::decodeFrom(stream);
+  m_report.add(vuh, numBytesInV3CUnit);
+
+  if (vuh.vuh_unit_type() == MivBitstream::VuhUnitType::V3C_AD ||
+      vuh.vuh_unit_type() == MivBitstream::VuhUnitType::V3C_CAD) {
+    scanAtlasSubBitstream(stream, endPosition);
+  }
+}
+
+void HeaderScanner::scanAtlasSubBitstream(std::istream &stream, std::streampos endPosition) {
+  const auto ssnh = MivBitstream::SampleStreamNalHeader::decodeFrom(stream);
+  const auto precisionBytes =
+      static_cast<size_t>(ssnh.ssnh_unit_size_precision_bytes_minus1()) + size_t{1};
+
+  while (stream.tellg() < endPosition) {
+    VERIFY_V3CBITSTREAM(fitsWithin(stream, precisionBytes, endPosition));
+    const auto ssnu_nal_unit_size = Common::readBytes(stream, precisionBytes);
+    VERIFY_V3CBITSTREAM(nalUnitHeaderSize <= ssnu_nal_unit_size);
+    VERIFY_V3CBITSTREAM(fitsWithin(stream, ssnu_nal_unit_size, endPosition));
+
+    m_report.add(MivBitstream::NalUnitHeader::decodeFrom(stream), ssnu_nal_unit_size);
+
+    // NAL units are small enough to read past within the stream buffer
+    stream.ignore(static_cast<std::streamsize>(ssnu_nal_unit_size - nalUnitHeaderSize));
+    VERIFY_V3CBITSTREAM(stream.good());
+  }
+}
+} // namespace TMIV::Parser
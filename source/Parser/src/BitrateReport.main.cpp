@@ -31,192 +31,71 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <TMIV/Parser/BitrateReport.h>
+
 #include <TMIV/Common/LoggingStrategyFmt.h>
-#include <TMIV/MivBitstream/NalUnit.h>
-#include <TMIV/MivBitstream/V3cSampleStreamFormat.h>
-#include <TMIV/MivBitstream/V3cUnit.h>
+#include <TMIV/Common/Thread.h>
 
-#include <cstring>
+#include <algorithm>
 #include <fstream>
-#include <map>
-#include <sstream>
-#include <stdexcept>
-#include <variant>
 #include <vector>
 
-class StatisticalVariable {
-public:
-  auto operator<<(size_t value) -> auto & {
-    ++m_count;
-    m_sum += value;
-    return *this;
-  }
-
-  friend auto operator<<(std::ostream &stream, const StatisticalVariable &x) -> std::ostream & {
-    auto average = x.m_count > 0 ? static_cast<double>(x.m_sum) / static_cast<double>(x.m_count)
-                                 : std::numeric_limits<double>::quiet_NaN();
-    return stream << x.m_count << ',' << x.m_sum << ',' << average;
-  }
-
-private:
-  size_t m_count{};
-  size_t m_sum{};
-};
-
-struct CompareVuh {
-  auto operator()(const TMIV::MivBitstream::V3cUnitHeader &vuh1,
-                  const TMIV::MivBitstream::V3cUnitHeader &vuh2) const -> bool {
-    if (vuh1.vuh_unit_type() != vuh2.vuh_unit_type()) {
-      return vuh1.vuh_unit_type() < vuh2.vuh_unit_type();
-    }
-    if (vuh1.vuh_unit_type() == TMIV::MivBitstream::VuhUnitType::V3C_VPS ||
-        vuh1.vuh_unit_type() == TMIV::MivBitstream::VuhUnitType::V3C_CAD) {
-      return false;
-    }
-    if (vuh1.vuh_atlas_id() != vuh2.vuh_atlas_id()) {
-      return vuh1.vuh_atlas_id() < vuh2.vuh_atlas_id();
-    }
-    if (vuh1.vuh_unit_type() != TMIV::MivBitstream::VuhUnitType::V3C_GVD &&
-        vuh1.vuh_unit_type() != TMIV::MivBitstream::VuhUnitType::V3C_AVD) {
-      return false;
-    }
-    if (vuh1.vuh_map_index() != vuh2.vuh_map_index()) {
-      return vuh1.vuh_map_index() < vuh2.vuh_map_index();
-    }
-    if (vuh1.vuh_unit_type() != TMIV::MivBitstream::VuhUnitType::V3C_AVD) {
-      return false;
-    }
-    return vuh1.vuh_attribute_index() < vuh2.vuh_attribute_index();
-  }
-};
+using namespace std::string_view_literals;
 
-struct CompareNuh {
-  auto operator()(const TMIV::MivBitstream::NalUnitHeader &nuh1,
-                  const TMIV::MivBitstream::NalUnitHeader &nuh2) const -> bool {
-    if (nuh1.nal_unit_type() != nuh2.nal_unit_type()) {
-      return nuh1.nal_unit_type() < nuh2.nal_unit_type();
-    }
-    if (nuh1.nal_layer_id() != nuh2.nal_layer_id()) {
-      return nuh1.nal_layer_id() < nuh2.nal_layer_id();
-    }
-    return nuh1.nal_temporal_id_plus1() < nuh2.nal_temporal_id_plus1();
-  }
-};
-
-class BitrateReport {
-public:
-  void printTo(std::ostream &stream) const {
-    stream << "vuh_unit_type,vuh_atlas_id,vuh_map_index,vuh_attribute_index,count,sum,average\n";
-    for (const auto &[vuh, stats] : m_vuhStats) {
-      stream << vuh.vuh_unit_type() << ',';
-      switch (vuh.vuh_unit_type()) {
-      case TMIV::MivBitstream::VuhUnitType::V3C_VPS:
-      case TMIV::MivBitstream::VuhUnitType::V3C_CAD:
-        stream << ",,";
-        break;
-      case TMIV::MivBitstream::VuhUnitType::V3C_AD:
-      case TMIV::MivBitstream::VuhUnitType::V3C_OVD:
-        stream << vuh.vuh_atlas_id() << ",,";
-        break;
-      case TMIV::MivBitstream::VuhUnitType::V3C_GVD:
-        stream << vuh.vuh_atlas_id() << ',' << int32_t{vuh.vuh_map_index()} << ',';
-        break;
-      case TMIV::MivBitstream::VuhUnitType::V3C_AVD:
-        stream << vuh.vuh_atlas_id() << ',' << int32_t{vuh.vuh_map_index()} << ','
-               << int32_t{vuh.vuh_attribute_index()};
-        break;
-      default:
-        UNREACHABLE;
-      }
-      stream << ',' << stats << '\n';
-    }
+using TMIV::Common::logError;
+using TMIV::Common::logInfo;
 
-    stream << ",,,,,,\n";
-    stream << "nal_unit_type,nal_layer_id,nal_temporal_id,,count,sum,average\n";
+namespace {
+auto reportBitrate(const char *bitstreamPath, const char *reportPath) -> int32_t {
+  try {
+    std::ifstream inStream{bitstreamPath, std::ios::binary};
 
-    for (const auto &[nuh, stats] : m_nuhStats) {
-      stream << nuh.nal_unit_type() << ',' << int32_t{nuh.nal_layer_id()} << ','
-             << (nuh.nal_temporal_id_plus1() - 1) << ",," << stats << '\n';
+    if (!inStream.good()) {
+      logError("Failed to open {} for reading.", bitstreamPath);
+      return 1;
     }
-  }
 
-  void add(const TMIV::MivBitstream::V3cUnitHeader &vuh, size_t size) { m_vuhStats[vuh] << size; }
-  auto add(const TMIV::MivBitstream::NalUnitHeader &nuh, size_t size) { m_nuhStats[nuh] << size; }
+    std::ofstream outStream{reportPath, std::ios::binary};
 
-private:
-  std::map<TMIV::MivBitstream::V3cUnitHeader, StatisticalVariable, CompareVuh> m_vuhStats;
-  std::map<TMIV::MivBitstream::NalUnitHeader, StatisticalVariable, CompareNuh> m_nuhStats;
-};
-
-class PartialParser {
-public:
-  void parseV3cSampleStream(std::istream &stream) {
-    const auto ssvh = TMIV::MivBitstream::SampleStreamV3cHeader::decodeFrom(stream);
-
-    while (stream.peek(), !stream.eof()) {
-      const auto ssvu = TMIV::MivBitstream::SampleStreamV3cUnit::decodeFrom(stream, ssvh);
-      std::istringstream substream{ssvu.ssvu_v3c_unit()};
-      parseV3cUnit(substream, ssvu.ssvu_v3c_unit_size());
+    if (!outStream.good()) {
+      logError("Failed to open {} for writing.", reportPath);
+      return 1;
     }
-  }
-
-  void parseV3cUnit(std::istream &stream, size_t numBytesInV3CUnit) {
-    auto vu = TMIV::MivBitstream::V3cUnit::decodeFrom(stream, numBytesInV3CUnit);
-    m_report.add(vu.v3c_unit_header(), numBytesInV3CUnit);
-    std::visit([this](const auto &x) { parseV3cUnitPayload(x); }, vu.v3c_unit_payload().payload());
-  }
 
-  void parseV3cUnitPayload(const std::monostate & /* unused */) {}
-
-  void parseV3cUnitPayload(const TMIV::MivBitstream::V3cParameterSet & /* vps */) {}
-
-  void parseV3cUnitPayload(const TMIV::MivBitstream::AtlasSubBitstream &asb) {
-    for (const auto &nu : asb.nal_units()) {
-      m_report.add(nu.nal_unit_header(), nu.size());
-    }
+    TMIV::Parser::HeaderScanner scanner;
+    scanner.scanV3cSampleStream(inStream);
+    scanner.report().printTo(outStream);
+    return 0;
+  } catch (...) {
+    return TMIV::Common::handleException();
   }
-
-  void parseV3cUnitPayload(const TMIV::MivBitstream::VideoSubBitstream & /* unused */) {}
-
-  [[nodiscard]] auto report() const -> auto & { return m_report; }
-
-private:
-  BitrateReport m_report;
-};
-
-using namespace std::string_view_literals;
-
-using TMIV::Common::logError;
-using TMIV::Common::logInfo;
+}
+} // namespace
 
 auto main(int argc, const char *argv[]) -> int32_t {
   try {
     const auto args = std::vector(argv, argv + argc);
+    const auto jobCount = (args.size() - 1) / 4;
+    auto validArgs = 0 < jobCount && args.size() == 4 * jobCount + 1;
 
-    if (args.size() != 5 || args[1] != "-b"sv || args[3] != "-o"sv) {
-      logInfo("Usage: TmivBitrateReport -b BITSTREAM -o REPORT_FILE");
-      return 1;
+    for (size_t i = 0; validArgs && i < jobCount; ++i) {
+      validArgs = args[4 * i + 1] == "-b"sv && args[4 * i + 3] == "-o"sv;
     }
 
-    std::ifstream inStream{args[2], std::ios::binary};
-
-    if (!inStream.good()) {
-      logError("Failed to open {} for reading.", args[2]);
+    if (!validArgs) {
+      logInfo("Usage: TmivBitrateReport -b BITSTREAM -o REPORT_FILE [-b BITSTREAM -o REPORT_FILE "
+              "...]");
       return 1;
     }
 
-    std::ofstream outStream{args[4], std::ios::binary};
-
-    if (!outStream.good()) {
-      logError("Failed to open {} for writing.", args[4]);
-      return 1;
-    }
+    // Independent bitstreams are scanned concurrently and each report is written when ready
+    auto results = std::vector<int32_t>(jobCount);
 
-    PartialParser parser;
-    parser.parseV3cSampleStream(inStream);
-    parser.report().printTo(outStream);
+    TMIV::Common::parallel_for(jobCount, [&](size_t i) {
+      results[i] = reportBitrate(args[4 * i + 2], args[4 * i + 4]);
+    });
 
-    return 0;
+    return std::all_of(results.cbegin(), results.cend(), [](int32_t x) { return x == 0; }) ? 0 : 1;
   } catch (...) {
     return TMIV::Common::handleException();
   }
@@ -0,0 +1,136 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Parser/BitrateReport.h>
+
+#include <TMIV/Common/verify.h>
+#include <TMIV/MivBitstream/NalSampleStreamFormat.h>
+#include <TMIV/MivBitstream/V3cParameterSet.h>
+#include <TMIV/MivBitstream/V3cSampleStreamFormat.h>
+
+#include <sstream>
+
+namespace test {
+namespace {
+using TMIV::MivBitstream::AtlasSubBitstream;
+using TMIV::MivBitstream::NalUnit;
+using TMIV::MivBitstream::NalUnitType;
+using TMIV::MivBitstream::SampleStreamNalHeader;
+using TMIV::MivBitstream::SampleStreamV3cHeader;
+using TMIV::MivBitstream::SampleStreamV3cUnit;
+using TMIV::MivBitstream::V3cParameterSet;
+using TMIV::MivBitstream::V3cUnit;
+using TMIV::MivBitstream::V3cUnitHeader;
+using TMIV::MivBitstream::VuhUnitType;
+
+template <typename Payload> auto createV3cUnit(const V3cUnitHeader &vuh, Payload &&payload) {
+  const auto vu = V3cUnit{vuh, payload};
+
+  std::ostringstream stream;
+  vu.encodeTo(stream);
+  return stream.str();
+}
+
+auto createVpsUnit() { return createV3cUnit(V3cUnitHeader::vps(), V3cParameterSet{}); }
+
+auto createAdUnit() {
+  auto ad = AtlasSubBitstream{SampleStreamNalHeader{0}};
+  ad.nal_units().push_back(NalUnit{{NalUnitType::NAL_EOS, 0, 1}, {}});
+  ad.nal_units().push_back(NalUnit{{NalUnitType::NAL_FD, 0, 1}, "filler"});
+  return createV3cUnit(V3cUnitHeader::ad(0, {}), ad);
+}
+
+auto createSampleStream(const std::vector<std::string> &v3cUnits) {
+  std::ostringstream stream;
+
+  const auto ssvh = SampleStreamV3cHeader{1};
+  ssvh.encodeTo(stream);
+
+  for (const auto &v3cUnit : v3cUnits) {
+    SampleStreamV3cUnit{v3cUnit}.encodeTo(stream, ssvh);
+  }
+  return stream.str();
+}
+} // namespace
+} // namespace test
+
+TEST_CASE("HeaderScanner") {
+  using TMIV::Common::V3cBitstreamError;
+
+  auto scanner = TMIV::Parser::HeaderScanner{};
+
+  SECTION("The headers of all V3C units and NAL units are reported") {
+    const auto vps = test::createVpsUnit();
+    const auto ad = test::createAdUnit();
+    std::istringstream stream{test::createSampleStream({vps, ad, ad})};
+
+    scanner.scanV3cSampleStream(stream);
+
+    const auto &vuhStats = scanner.report().vuhStats();
+    REQUIRE(vuhStats.size() == 2);
+    CHECK(vuhStats.at(TMIV::MivBitstream::V3cUnitHeader::vps()).count() == 1);
+    CHECK(vuhStats.at(TMIV::MivBitstream::V3cUnitHeader::vps()).sum() == vps.size());
+    CHECK(vuhStats.at(TMIV::MivBitstream::V3cUnitHeader::ad(0, {})).count() == 2);
+    CHECK(vuhStats.at(TMIV::MivBitstream::V3cUnitHeader::ad(0, {})).sum() == 2 * ad.size());
+
+    const auto &nuhStats = scanner.report().nuhStats();
+    REQUIRE(nuhStats.size() == 2);
+    CHECK(nuhStats.at({TMIV::MivBitstream::NalUnitType::NAL_EOS, 0, 1}).sum() == 2 * 2);
+    CHECK(nuhStats.at({TMIV::MivBitstream::NalUnitType::NAL_FD, 0, 1}).sum() == 2 * 8);
+  }
+
+  SECTION("A sample stream that is truncated within a V3C unit is a bitstream error") {
+    auto bitstream = test::createSampleStream({test::createVpsUnit(), test::createAdUnit()});
+    bitstream.pop_back();
+    std::istringstream stream{bitstream};
+
+    REQUIRE_THROWS_AS(scanner.scanV3cSampleStream(stream), V3cBitstreamError);
+  }
+
+  SECTION("A NAL unit that does not fit in its V3C unit is a bitstream error") {
+    // The last NAL unit would otherwise extend into the V3C unit that follows
+    auto ad = test::createAdUnit();
+    ad.pop_back();
+    std::istringstream stream{test::createSampleStream({ad, test::createVpsUnit()})};
+
+    REQUIRE_THROWS_AS(scanner.scanV3cSampleStream(stream), V3cBitstreamError);
+  }
+
+  SECTION("A V3C unit that is smaller than its header is a bitstream error") {
+    std::istringstream stream{test::createSampleStream({std::string(2, '\0')})};
+
+    REQUIRE_THROWS_AS(scanner.scanV3cSampleStream(stream), V3cBitstreamError);
+  }
+}
@@ -34,9 +34,12 @@
 #include "LumaStdDev.h"
 #include "PrunedMesh.h"
 
+#include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/Thread.h>
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iterator>
 #include <numeric>
@@ -91,21 +94,19 @@ auto findCentralBasicView(const MivBitstream::ViewParamsList &viewParamsList) ->
       std::abs(std::distance(std::cbegin(viewParamsList), viewClosestToCenter)));
 }
 
-auto initSynthesizersForFrameAnalysis(const Common::DeepFrameList &views,
-                                      const MivBitstream::ViewParamsList &viewParamsList,
-                                      Renderer::AccumulatingPixel<Common::Vec3f> config)
-    -> std::vector<std::unique_ptr<IncrementalSynthesizer>> {
-  std::vector<std::unique_ptr<IncrementalSynthesizer>> synthesizers{};
-  for (size_t i = 0; i < viewParamsList.size(); ++i) {
-    const auto geoBitDepth = views[i].geometry.getBitDepth();
-    const auto depthTransform = MivBitstream::DepthTransform{viewParamsList[i].dq, geoBitDepth};
-
-    synthesizers.emplace_back(std::make_unique<IncrementalSynthesizer>(
-        config, viewParamsList[i].ci.projectionPlaneSize(), i,
-        depthTransform.expandDepth(views[i].geometry), expandLuma(views[i].texture),
-        expandTexture(yuv444(views[i].texture))));
-  }
-  return synthesizers;
+// Synthesizers are created per target view, such that the memory use is bounded by the number of
+// concurrent tasks instead of by the number of views
+auto createSynthesizerForFrameAnalysis(const Common::DeepFrameList &views,
+                                       const MivBitstream::ViewParamsList &viewParamsList,
+                                       const Renderer::AccumulatingPixel<Common::Vec3f> &config,
+                                       size_t i) -> std::unique_ptr<IncrementalSynthesizer> {
+  const auto geoBitDepth = views[i].geometry.getBitDepth();
+  const auto depthTransform = MivBitstream::DepthTransform{viewParamsList[i].dq, geoBitDepth};
+
+  return std::make_unique<IncrementalSynthesizer>(
+      config, viewParamsList[i].ci.projectionPlaneSize(), i,
+      depthTransform.expandDepth(views[i].geometry), expandLuma(views[i].texture),
+      expandTexture(yuv444(views[i].texture)));
 }
 
 auto initMasksForFrameAnalysis(const Common::DeepFrameList &views,
@@ -183,28 +184,35 @@ auto calculateLumaStdDev(const Common::DeepFrameList &views,
                          const MivBitstream::ViewParamsList &viewParamsList,
                          const Renderer::AccumulatingPixel<Common::Vec3f> &config,
                          float maxDepthError) -> std::optional<float> {
+  const auto startTime = std::chrono::steady_clock::now();
   const int32_t numBins = 512;
-  std::vector<int32_t> differenceHistogram(numBins, 0);
   const int32_t numBins2 = numBins / 2U;
 
-  const auto synthesizers = initSynthesizersForFrameAnalysis(views, viewParamsList, config);
-
   const size_t refViewId = findCentralBasicView(viewParamsList);
   const auto &refView = views[refViewId];
 
   const auto masks = initMasksForFrameAnalysis(views, viewParamsList);
-  auto [ivertices, triangles, attributes] =
+  const auto [ivertices, triangles, attributes] =
       unprojectPrunedView(refView, viewParamsList[refViewId], masks[refViewId].getPlane(0));
 
-  // compare reprojected points
-  for (const auto &s : synthesizers) {
-    if (s->index == refViewId) {
-      continue;
+  // compare reprojected points, one histogram per target view to avoid synchronization
+  auto histograms = std::vector<std::vector<int32_t>>(viewParamsList.size());
+
+  Common::parallel_for(viewParamsList.size(), [&, &ivertices = ivertices, &triangles = triangles,
+                                               &attributes = attributes](size_t index) {
+    if (index == refViewId) {
+      return;
     }
 
+    auto &differenceHistogram = histograms[index];
+    differenceHistogram.assign(numBins, 0);
+
+    const auto s = createSynthesizerForFrameAnalysis(views, viewParamsList, config, index);
+
     auto overtices = project(ivertices, viewParamsList[refViewId], viewParamsList[s->index]);
-    weightedSphere(viewParamsList[s->index].ci, overtices, triangles);
-    s->rasterizer.submit(overtices, attributes, triangles);
+    auto targetTriangles = triangles; // the triangle weights depend on the target view
+    weightedSphere(viewParamsList[s->index].ci, overtices, targetTriangles);
+    s->rasterizer.submit(overtices, attributes, targetTriangles);
     s->rasterizer.run();
 
     const auto W = static_cast<int32_t>(s->reference.width());
@@ -240,8 +248,19 @@ auto calculateLumaStdDev(const Common::DeepFrameList &views,
       pixelIdx++;
       return true;
     });
+  });
+
+  std::vector<int32_t> differenceHistogram(numBins, 0);
+
+  for (const auto &histogram : histograms) {
+    std::transform(histogram.cbegin(), histogram.cend(), differenceHistogram.cbegin(),
+                   differenceHistogram.begin(), std::plus<>{});
   }
 
+  Common::logVerbose(
+      "calculateLumaStdDev: {} target views in {:.3f} s", viewParamsList.size() - 1,
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
   return calculateStdDev(differenceHistogram);
 }
 } // namespace TMIV::Pruner
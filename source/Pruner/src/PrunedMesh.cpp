@@ -120,15 +120,34 @@ auto project(const Renderer::SceneVertexDescriptorList &vertices,
              const MivBitstream::ViewParams &source, const MivBitstream::ViewParams &target)
     -> Renderer::ImageVertexDescriptorList {
   return target.ci.dispatch([&](auto camType) {
-    Renderer::ImageVertexDescriptorList result;
     Renderer::Engine<camType.value> engine{target.ci};
     const auto R_t = Renderer::AffineTransform{source.pose, target.pose};
-    result.reserve(result.size());
-    std::transform(std::begin(vertices), std::end(vertices), back_inserter(result),
-                   [&](Renderer::SceneVertexDescriptor v) {
-                     const auto p = R_t(v.position);
-                     return engine.projectVertex({p, Common::angle(p, p - R_t.translation())});
-                   });
+
+    auto scenePoints = Renderer::ScenePointBatch{};
+    scenePoints.resize(vertices.size());
+    auto rayAngles = std::vector<float>(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      const auto p = R_t(vertices[i].position);
+      scenePoints.x[i] = p.x();
+      scenePoints.y[i] = p.y();
+      scenePoints.z[i] = p.z();
+      rayAngles[i] = Common::angle(p, p - R_t.translation());
+    }
+
+    auto imagePoints = Renderer::ImagePointBatch{};
+    engine.projectBatch(scenePoints, imagePoints);
+
+    // The engines only invalidate the ray angle when the depth is invalid, and the ray angle is NaN
+    // already when the depth is NaN because of a NaN position.
+    Renderer::ImageVertexDescriptorList result;
+    result.reserve(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      result.push_back({{imagePoints.u[i], imagePoints.v[i]},
+                        imagePoints.depth[i],
+                        std::isnan(imagePoints.depth[i]) ? NAN : rayAngles[i]});
+    }
     return result;
   });
 }
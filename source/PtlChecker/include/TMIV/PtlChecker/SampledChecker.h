@@ -0,0 +1,75 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_PTLCHECKER_SAMPLEDCHECKER_H
+#define TMIV_PTLCHECKER_SAMPLEDCHECKER_H
+
+#include "AbstractChecker.h"
+
+namespace TMIV::PtlChecker {
+// A checker that forwards all header and parameter set checks, but the frame checks only for every
+// N-th V3C frame of a sequence, starting with the first. This reduces the per-frame cost of
+// conformance checking during playback. The rate-based level limits are then evaluated over a
+// window of sampled frames, which is representative but not exact.
+class SampledChecker : public AbstractChecker {
+public:
+  SampledChecker(SharedChecker checker, int32_t framePeriod);
+
+  void replaceLogger(Logger value) override;
+
+  void checkVuh(const MivBitstream::V3cUnitHeader &vuh) override;
+  void checkNuh(const MivBitstream::NalUnitHeader &nuh) override;
+  void checkAndActivateVps(const MivBitstream::V3cParameterSet &vps) override;
+  void activateCasps(const MivBitstream::CommonAtlasSequenceParameterSetRBSP &casps) override;
+  void checkAsps(MivBitstream::AtlasId atlasId,
+                 const MivBitstream::AtlasSequenceParameterSetRBSP &asps) override;
+  void checkAfps(const MivBitstream::AtlasFrameParameterSetRBSP &afps) override;
+  void checkAtl(const MivBitstream::NalUnitHeader &nuh,
+                const MivBitstream::AtlasTileLayerRBSP &atl) override;
+  void checkCaf(const MivBitstream::NalUnitHeader &nuh,
+                const MivBitstream::CommonAtlasFrameRBSP &caf) override;
+  void checkVideoFrame(MivBitstream::VuhUnitType vut,
+                       const MivBitstream::AtlasSequenceParameterSetRBSP &asps,
+                       const Common::Frame<> &frame) override;
+  void checkV3cFrame(const MivBitstream::AccessUnit &frame) override;
+
+private:
+  [[nodiscard]] auto sampled() const noexcept { return m_frameCount % m_framePeriod == 0; }
+
+  SharedChecker m_checker;
+  int64_t m_framePeriod;
+  int64_t m_frameCount{};
+};
+} // namespace TMIV::PtlChecker
+
+#endif
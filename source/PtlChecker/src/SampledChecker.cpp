@@ -0,0 +1,99 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TMIV/PtlChecker/SampledChecker.h>
+
+#include <TMIV/Common/verify.h>
+
+namespace TMIV::PtlChecker {
+SampledChecker::SampledChecker(SharedChecker checker, int32_t framePeriod)
+    : m_checker{std::move(checker)}, m_framePeriod{framePeriod} {
+  PRECONDITION(m_checker);
+  PRECONDITION(0 < framePeriod);
+}
+
+void SampledChecker::replaceLogger(Logger value) { m_checker->replaceLogger(std::move(value)); }
+
+void SampledChecker::checkVuh(const MivBitstream::V3cUnitHeader &vuh) {
+  m_checker->checkVuh(vuh);
+}
+
+void SampledChecker::checkNuh(const MivBitstream::NalUnitHeader &nuh) {
+  m_checker->checkNuh(nuh);
+}
+
+void SampledChecker::checkAndActivateVps(const MivBitstream::V3cParameterSet &vps) {
+  // Always check the first frame of a sequence
+  m_frameCount = 0;
+  m_checker->checkAndActivateVps(vps);
+}
+
+void SampledChecker::activateCasps(const MivBitstream::CommonAtlasSequenceParameterSetRBSP &casps) {
+  m_checker->activateCasps(casps);
+}
+
+void SampledChecker::checkAsps(MivBitstream::AtlasId atlasId,
+                               const MivBitstream::AtlasSequenceParameterSetRBSP &asps) {
+  m_checker->checkAsps(atlasId, asps);
+}
+
+void SampledChecker::checkAfps(const MivBitstream::AtlasFrameParameterSetRBSP &afps) {
+  m_checker->checkAfps(afps);
+}
+
+void SampledChecker::checkAtl(const MivBitstream::NalUnitHeader &nuh,
+                              const MivBitstream::AtlasTileLayerRBSP &atl) {
+  m_checker->checkAtl(nuh, atl);
+}
+
+void SampledChecker::checkCaf(const MivBitstream::NalUnitHeader &nuh,
+                              const MivBitstream::CommonAtlasFrameRBSP &caf) {
+  m_checker->checkCaf(nuh, caf);
+}
+
+// The video frames of a V3C frame are checked before the V3C frame itself
+void SampledChecker::checkVideoFrame(MivBitstream::VuhUnitType vut,
+                                     const MivBitstream::AtlasSequenceParameterSetRBSP &asps,
+                                     const Common::Frame<> &frame) {
+  if (sampled()) {
+    m_checker->checkVideoFrame(vut, asps, frame);
+  }
+}
+
+void SampledChecker::checkV3cFrame(const MivBitstream::AccessUnit &frame) {
+  if (sampled()) {
+    m_checker->checkV3cFrame(frame);
+  }
+  ++m_frameCount;
+}
+} // namespace TMIV::PtlChecker
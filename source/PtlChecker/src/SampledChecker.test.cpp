@@ -0,0 +1,109 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/PtlChecker/SampledChecker.h>
+
+namespace test {
+class CountingChecker : public TMIV::PtlChecker::AbstractChecker {
+public:
+  void replaceLogger(Logger /* value */) override {}
+  void checkVuh(const TMIV::MivBitstream::V3cUnitHeader & /* vuh */) override { ++headerChecks; }
+  void checkNuh(const TMIV::MivBitstream::NalUnitHeader & /* nuh */) override { ++headerChecks; }
+  void checkAndActivateVps(const TMIV::MivBitstream::V3cParameterSet & /* vps */) override {}
+  void activateCasps(
+      const TMIV::MivBitstream::CommonAtlasSequenceParameterSetRBSP & /* casps */) override {}
+  void checkAsps(TMIV::MivBitstream::AtlasId /* atlasId */,
+                 const TMIV::MivBitstream::AtlasSequenceParameterSetRBSP & /* asps */) override {}
+  void checkAfps(const TMIV::MivBitstream::AtlasFrameParameterSetRBSP & /* afps */) override {}
+  void checkAtl(const TMIV::MivBitstream::NalUnitHeader & /* nuh */,
+                const TMIV::MivBitstream::AtlasTileLayerRBSP & /* atl */) override {}
+  void checkCaf(const TMIV::MivBitstream::NalUnitHeader & /* nuh */,
+                const TMIV::MivBitstream::CommonAtlasFrameRBSP & /* caf */) override {}
+  void checkVideoFrame(TMIV::MivBitstream::VuhUnitType /* vut */,
+                       const TMIV::MivBitstream::AtlasSequenceParameterSetRBSP & /* asps */,
+                       const TMIV::Common::Frame<> & /* frame */) override {
+    ++videoFrameChecks;
+  }
+  void checkV3cFrame(const TMIV::MivBitstream::AccessUnit &frame) override {
+    v3cFrameChecks.push_back(frame.foc);
+  }
+
+  int32_t headerChecks{};
+  int32_t videoFrameChecks{};
+  std::vector<int32_t> v3cFrameChecks;
+};
+} // namespace test
+
+TEST_CASE("PtlChecker::SampledChecker") {
+  using TMIV::PtlChecker::SampledChecker;
+
+  const auto checker = std::make_shared<test::CountingChecker>();
+  auto unitUnderTest = SampledChecker{checker, 3};
+
+  const auto vps = TMIV::MivBitstream::V3cParameterSet{};
+  const auto asps = TMIV::MivBitstream::AtlasSequenceParameterSetRBSP{};
+  const auto videoFrame = TMIV::Common::Frame<>::lumaOnly({4, 2});
+
+  const auto decodeFrames = [&](int32_t count) {
+    for (int32_t foc = 0; foc < count; ++foc) {
+      unitUnderTest.checkVuh(TMIV::MivBitstream::V3cUnitHeader::ad(0, {}));
+      unitUnderTest.checkNuh({TMIV::MivBitstream::NalUnitType::NAL_IDR_N_LP, 0, 1});
+      unitUnderTest.checkVideoFrame(TMIV::MivBitstream::VuhUnitType::V3C_GVD, asps, videoFrame);
+      unitUnderTest.checkVideoFrame(TMIV::MivBitstream::VuhUnitType::V3C_AVD, asps, videoFrame);
+
+      auto frame = TMIV::MivBitstream::AccessUnit{};
+      frame.foc = foc;
+      unitUnderTest.checkV3cFrame(frame);
+    }
+  };
+
+  SECTION("Headers are always checked, frames are sampled") {
+    unitUnderTest.checkAndActivateVps(vps);
+    decodeFrames(7);
+
+    CHECK(checker->headerChecks == 14);
+    CHECK(checker->videoFrameChecks == 6);
+    CHECK(checker->v3cFrameChecks == std::vector{0, 3, 6});
+  }
+
+  SECTION("The first frame of each sequence is checked") {
+    unitUnderTest.checkAndActivateVps(vps);
+    decodeFrames(2);
+    unitUnderTest.checkAndActivateVps(vps);
+    decodeFrames(2);
+
+    CHECK(checker->v3cFrameChecks == std::vector{0, 0});
+  }
+}
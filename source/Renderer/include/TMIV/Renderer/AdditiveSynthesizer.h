@@ -50,7 +50,7 @@ public:
 
   // Render from a texture atlas to a viewport
   [[nodiscard]] auto renderFrame(const MivBitstream::AccessUnit &frame,
-                                 const MivBitstream::CameraConfig &cameraConfig) const
+                                 const MivBitstream::CameraConfig &cameraConfig)
       -> Common::RendererFrame override;
 
 private:
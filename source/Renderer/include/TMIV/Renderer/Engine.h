@@ -60,6 +60,36 @@ struct ImageVertexDescriptor {
 
 using ImageVertexDescriptorList = std::vector<ImageVertexDescriptor>;
 
+// A batch of scene points (structure of arrays) in the reference frame of a camera [m]
+struct ScenePointBatch {
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> z;
+
+  [[nodiscard]] auto size() const noexcept { return x.size(); }
+
+  void resize(size_t n) {
+    x.resize(n);
+    y.resize(n);
+    z.resize(n);
+  }
+};
+
+// A batch of image points (structure of arrays)
+struct ImagePointBatch {
+  std::vector<float> u;     // px, position in image (x right)
+  std::vector<float> v;     // px, position in image (y down)
+  std::vector<float> depth; // m, depth as defined in the projection
+
+  [[nodiscard]] auto size() const noexcept { return u.size(); }
+
+  void resize(size_t n) {
+    u.resize(n);
+    v.resize(n);
+    depth.resize(n);
+  }
+};
+
 // The rendering engine is the part that is specalized per projection type
 template <MivBitstream::CiCamType camType> struct Engine {};
 struct ViewportPosition2D {
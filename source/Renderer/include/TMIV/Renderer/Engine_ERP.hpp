@@ -87,6 +87,12 @@ template <> struct Engine<MivBitstream::CiCamType::equirectangular> {
     return {position, radius, v.rayAngle};
   }
 
+  // Batched unprojection equation
+  void unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const;
+
+  // Batched projection equation
+  void projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const;
+
   // Project mesh to target view
   template <typename... T>
   auto project(const SceneVertexDescriptorList &sceneVertices, TriangleDescriptorList triangles,
@@ -68,6 +68,12 @@ template <> struct Engine<MivBitstream::CiCamType::perspective> {
     return {{NAN, NAN}, NAN, NAN};
   }
 
+  // Batched unprojection equation
+  void unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const;
+
+  // Batched projection equation
+  void projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const;
+
   // Project mesh to target view
   template <typename... T>
   auto project(const SceneVertexDescriptorList &sceneVertices,
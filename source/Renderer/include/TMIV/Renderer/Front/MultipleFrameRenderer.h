@@ -56,7 +56,7 @@ public:
 
   void renderMultipleFrames(const MivBitstream::AccessUnit &frame,
                             const FrameMapping::const_iterator &first,
-                            const FrameMapping::const_iterator &last) const;
+                            const FrameMapping::const_iterator &last);
 
   [[nodiscard]] auto isOptimizedForRestrictedGeometry() const -> bool;
 
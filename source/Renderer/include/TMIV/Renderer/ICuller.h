@@ -38,6 +38,8 @@
 #include <TMIV/MivBitstream/AccessUnit.h>
 #include <TMIV/MivBitstream/ViewParamsList.h>
 
+#include <algorithm>
+
 namespace TMIV::Renderer {
 class ICuller {
 public:
@@ -54,11 +56,62 @@ public:
       const MivBitstream::ViewParams &viewportParams) const -> Common::Frame<Common::PatchIdx> = 0;
 
   // Do culling and update the block to patch maps for all atlases
+  //
+  // When an atlas has a pixel to patch map, the culled blocks are also removed from that map,
+  // because the synthesizers look up patches through it. Returns the number of culled samples.
   auto inplaceFilterBlockToPatchMaps(MivBitstream::AccessUnit &frame,
                                      const MivBitstream::ViewParams &viewportParams) const {
+    auto culledSamples = size_t{};
+
     for (auto &atlas : frame.atlas) {
-      atlas.blockToPatchMap = filterBlockToPatchMap(frame, atlas, viewportParams);
+      auto blockToPatchMap = filterBlockToPatchMap(frame, atlas, viewportParams);
+      culledSamples += inplaceApplyBlockToPatchMap(atlas, std::move(blockToPatchMap));
+    }
+    return culledSamples;
+  }
+
+private:
+  static auto inplaceApplyBlockToPatchMap(MivBitstream::AtlasAccessUnit &atlas,
+                                          Common::Frame<Common::PatchIdx> blockToPatchMap)
+      -> size_t {
+    const auto &before = atlas.blockToPatchMap.getPlane(0);
+    const auto &after = blockToPatchMap.getPlane(0);
+    const auto k = atlas.asps.asps_log2_patch_packing_block_size();
+    const auto frameHeight = static_cast<size_t>(atlas.asps.asps_frame_height());
+    const auto frameWidth = static_cast<size_t>(atlas.asps.asps_frame_width());
+    auto &pixelToPatchMap = atlas.pixelToPatchMap;
+    auto culledSamples = size_t{};
+
+    for (size_t i = 0; i < after.height(); ++i) {
+      for (size_t j = 0; j < after.width(); ++j) {
+        const auto patchIdx = before(i, j);
+
+        if (patchIdx == Common::unusedPatchIdx || after(i, j) != Common::unusedPatchIdx) {
+          continue;
+        }
+
+        const auto y1 = i << k;
+        const auto x1 = j << k;
+        const auto y2 = std::min((i + 1) << k, frameHeight);
+        const auto x2 = std::min((j + 1) << k, frameWidth);
+
+        if (pixelToPatchMap.empty()) {
+          culledSamples += (y2 - y1) * (x2 - x1);
+          continue;
+        }
+        for (auto y = y1; y < y2; ++y) {
+          for (auto x = x1; x < x2; ++x) {
+            if (auto &entry = pixelToPatchMap.getPlane(0)(y, x); entry == patchIdx) {
+              entry = Common::unusedPatchIdx;
+              ++culledSamples;
+            }
+          }
+        }
+      }
     }
+
+    atlas.blockToPatchMap = std::move(blockToPatchMap);
+    return culledSamples;
   }
 };
 } // namespace TMIV::Renderer
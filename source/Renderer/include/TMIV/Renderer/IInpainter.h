@@ -47,9 +47,10 @@ public:
   auto operator=(IInpainter &&) -> IInpainter & = default;
   virtual ~IInpainter() = default;
 
-  // Inpainting after encoder-side synthesis
+  // Inpainting after encoder-side synthesis. Implementations may keep scratch buffers across
+  // frames, so an instance must not be used by multiple threads at the same time.
   virtual void inplaceInpaint(Common::RendererFrame &viewport,
-                              const MivBitstream::ViewParams &metadata) const = 0;
+                              const MivBitstream::ViewParams &metadata) = 0;
 };
 } // namespace TMIV::Renderer
 
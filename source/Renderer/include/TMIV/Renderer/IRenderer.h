@@ -49,7 +49,7 @@ public:
 
   // Render from a texture atlas to a viewport
   [[nodiscard]] virtual auto renderFrame(const MivBitstream::AccessUnit &frame,
-                                         const MivBitstream::CameraConfig &cameraConfig) const
+                                         const MivBitstream::CameraConfig &cameraConfig)
       -> Common::RendererFrame = 0;
 
   [[nodiscard]] virtual auto isOptimizedForRestrictedGeometry() const -> bool { return false; }
@@ -48,10 +48,11 @@ public:
   auto operator=(IViewingSpaceController &&) -> IViewingSpaceController & = default;
   virtual ~IViewingSpaceController() = default;
 
-  // Viewing space fading
+  // Viewing space fading. Implementations may keep state across frames, so an instance must not
+  // be used by multiple threads at the same time.
   virtual void inplaceFading(Common::RendererFrame &viewport,
                              const MivBitstream::ViewParams &viewportParams,
-                             const MivBitstream::ViewingSpace &viewingSpace) const = 0;
+                             const MivBitstream::ViewingSpace &viewingSpace) = 0;
 };
 } // namespace TMIV::Renderer
 
@@ -38,6 +38,8 @@
 
 #include <TMIV/Common/Json.h>
 
+#include <memory>
+
 namespace TMIV::Renderer {
 class Inpainter : public IInpainter {
 public:
@@ -46,10 +48,16 @@ public:
   Inpainter(Inpainter &&) = default;
   auto operator=(const Inpainter &) -> Inpainter & = delete;
   auto operator=(Inpainter &&) -> Inpainter & = default;
-  ~Inpainter() override = default;
+  ~Inpainter() override;
 
   void inplaceInpaint(Common::RendererFrame &viewport,
-                      const MivBitstream::ViewParams &metadata) const override;
+                      const MivBitstream::ViewParams &metadata) override;
+
+private:
+  // Holds the scratch buffers and the ERP-to-Cassini mapping that are reused across frames
+  class Impl;
+
+  std::unique_ptr<Impl> m_impl;
 };
 } // namespace TMIV::Renderer
 
@@ -45,6 +45,9 @@ template <typename... T> class MpiRasterizer {
 public:
   using Exception = std::logic_error;
   using AttributeMaps = std::tuple<std::vector<T>...>;
+
+  // Type-erased fragment shader. Any callable with this signature can be passed to run(). Passing
+  // a lambda directly allows the shader to be inlined into the raster loop.
   using FragmentShader =
       std::function<void(const ViewportPosition2D &, const std::array<float, 3> &,
                          const std::array<PixelAttributes<T...>, 3> &)>;
@@ -66,7 +69,10 @@ public:
               const TriangleDescriptorList &triangles);
 
   // Raster all submitted batches
-  void run(const FragmentShader &fragmentShader);
+  //
+  // The fragment shader is called for each covered pixel of each triangle. Calls for the same strip
+  // are sequential but different strips are processed concurrently.
+  template <typename Shader> void run(const Shader &fragmentShader);
 
 private:
   struct Strip {
@@ -92,8 +98,9 @@ private:
   using Size = Common::Mat<float>::tuple_type;
 
   void submitTriangle(TriangleDescriptor descriptor, const Batch &batch);
-  void rasterTriangle(TriangleDescriptor descriptor, const Batch &batch, Strip &strip,
-                      const FragmentShader &fragmentShader);
+  template <typename Shader>
+  void rasterTriangle(TriangleDescriptor descriptor, const Batch &batch, const Strip &strip,
+                      const Shader &fragmentShader);
   void clearBatches();
 
   const Size m_size{};
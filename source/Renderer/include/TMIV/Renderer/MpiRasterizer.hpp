@@ -112,12 +112,14 @@ void MpiRasterizer<T...>::submit(const ImageVertexDescriptorList &vertices,
   }
 }
 
-template <typename... T> void MpiRasterizer<T...>::run(const FragmentShader &fragmentShader) {
+template <typename... T>
+template <typename Shader>
+void MpiRasterizer<T...>::run(const Shader &fragmentShader) {
   std::vector<std::future<void>> work;
   work.reserve(m_strips.size());
 
   // Launch all work
-  for (auto &strip : m_strips) {
+  for (const auto &strip : m_strips) {
     work.push_back(std::async( // Strips in parallel
         [this, &strip, &fragmentShader]() {
           for (size_t i = 0; i < m_batches.size(); ++i) { // Batches in sequence
@@ -172,6 +174,9 @@ constexpr const auto eps = intfp{1};
 constexpr const auto one = eps << bits;
 constexpr const auto half = one / intfp{2};
 
+// Side of the square pixel blocks that are tested against the triangle as a whole
+constexpr const auto blockSize = int32_t{8};
+
 inline auto fixed(float x) -> intfp {
   using std::ldexp;
   return static_cast<intfp>(static_cast<int32_t>(std::floor(0.5F + ldexp(x, bits))));
@@ -188,8 +193,9 @@ inline void swap_vec2fp(Vec2fp &p1, Vec2fp &p2) {
 } // namespace mpi_fixed_point
 
 template <typename... T>
+template <typename Shader>
 void MpiRasterizer<T...>::rasterTriangle(TriangleDescriptor descriptor, const Batch &batch,
-                                         Strip &strip, const FragmentShader &fragmentShader) {
+                                         const Strip &strip, const Shader &fragmentShader) {
   using std::ldexp;
   using std::max;
   using std::min;
@@ -241,34 +247,68 @@ void MpiRasterizer<T...>::rasterTriangle(TriangleDescriptor descriptor, const Ba
 
   const auto inv_area = 1.F / static_cast<float>(area);
 
-  // For each pixel in the bounding box
-  for (int32_t v = v1; v < v2; ++v) {
-    for (int32_t u = u1; u < u2; ++u) {
-      // Calculate the Barycentric coordinate of the pixel center (x +
-      // 1/2, y + 1/2)
-      using mpi_fixed_point::half;
-      const auto X0 = (uv1.y() - uv2.y()) * (fixed(u) - uv2.x() + half) +
-                      (uv2.x() - uv1.x()) * (fixed(v) - uv2.y() + half);
-      if (X0 < 0) {
-        continue;
-      }
-      const auto X1 = (uv2.y() - uv0.y()) * (fixed(u) - uv2.x() + half) +
-                      (uv0.x() - uv2.x()) * (fixed(v) - uv2.y() + half);
-      if (X1 < 0) {
-        continue;
+  // The Barycentric coordinates of the pixel center (u + 1/2, v + 1/2) are affine in (u, v)
+  using mpi_fixed_point::half;
+  using mpi_fixed_point::intfp;
+  using mpi_fixed_point::one;
+  const auto dX0_du = (uv1.y() - uv2.y()) * one;
+  const auto dX0_dv = (uv2.x() - uv1.x()) * one;
+  const auto dX1_du = (uv2.y() - uv0.y()) * one;
+  const auto dX1_dv = (uv0.x() - uv2.x()) * one;
+
+  const auto barycentric = [&](int32_t u, int32_t v) {
+    const auto X0 = (uv1.y() - uv2.y()) * (fixed(u) - uv2.x() + half) +
+                    (uv2.x() - uv1.x()) * (fixed(v) - uv2.y() + half);
+    const auto X1 = (uv2.y() - uv0.y()) * (fixed(u) - uv2.x() + half) +
+                    (uv0.x() - uv2.x()) * (fixed(v) - uv2.y() + half);
+    return std::array<intfp, 3>{X0, X1, area - X0 - X1};
+  };
+
+  // For each block in the bounding box
+  using mpi_fixed_point::blockSize;
+  for (int32_t bv1 = v1; bv1 < v2; bv1 += blockSize) {
+    const auto bv2 = min(v2, bv1 + blockSize);
+
+    for (int32_t bu1 = u1; bu1 < u2; bu1 += blockSize) {
+      const auto bu2 = min(u2, bu1 + blockSize);
+
+      // Classify the block using its corner pixels: the block is culled when it is entirely outside
+      // of one of the edges, and the per-pixel test is skipped when it is entirely inside.
+      const auto X_11 = barycentric(bu1, bv1);
+      const auto X_12 = barycentric(bu2 - 1, bv1);
+      const auto X_21 = barycentric(bu1, bv2 - 1);
+      const auto X_22 = barycentric(bu2 - 1, bv2 - 1);
+      auto outside = false;
+      auto inside = true;
+
+      for (size_t e = 0; e < 3; ++e) {
+        outside = outside || max({X_11[e], X_12[e], X_21[e], X_22[e]}) < 0;
+        inside = inside && 0 <= min({X_11[e], X_12[e], X_21[e], X_22[e]});
       }
-      const auto X2 = area - X0 - X1;
-      if (X2 < 0) {
-        continue;
+      if (outside) {
+        continue; // Cull
       }
 
-      const std::array<float, 3> weights{inv_area * static_cast<float>(X0),
-                                         inv_area * static_cast<float>(X1),
-                                         inv_area * static_cast<float>(X2)};
+      // For each pixel in the block
+      auto X0_row = X_11[0];
+      auto X1_row = X_11[1];
 
-      const ViewportPosition2D viewport{u, strip.i1 + v};
+      for (int32_t v = bv1; v < bv2; ++v, X0_row += dX0_dv, X1_row += dX1_dv) {
+        auto X0 = X0_row;
+        auto X1 = X1_row;
 
-      fragmentShader(viewport, weights, pixelAttributes);
+        for (int32_t u = bu1; u < bu2; ++u, X0 += dX0_du, X1 += dX1_du) {
+          const auto X2 = area - X0 - X1;
+
+          if (inside || (0 <= X0 && 0 <= X1 && 0 <= X2)) {
+            const std::array<float, 3> weights{inv_area * static_cast<float>(X0),
+                                               inv_area * static_cast<float>(X1),
+                                               inv_area * static_cast<float>(X2)};
+
+            fragmentShader(ViewportPosition2D{u, strip.i1 + v}, weights, pixelAttributes);
+          }
+        }
+      }
     }
   }
 }
@@ -49,7 +49,7 @@ public:
   ~NoInpainter() override = default;
 
   void inplaceInpaint(Common::RendererFrame & /* viewport */,
-                      const MivBitstream::ViewParams & /* metadata */) const override {}
+                      const MivBitstream::ViewParams & /* metadata */) override {}
 };
 } // namespace TMIV::Renderer
 
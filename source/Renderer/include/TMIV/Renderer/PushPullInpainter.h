@@ -42,7 +42,7 @@ public:
   PushPullInpainter(const Common::Json & /* rootNode */, const Common::Json & /* componentNode */);
 
   void inplaceInpaint(Common::RendererFrame & /* viewport */,
-                      const MivBitstream::ViewParams & /* metadata */) const override;
+                      const MivBitstream::ViewParams & /* metadata */) override;
 };
 } // namespace TMIV::Renderer
 
@@ -56,7 +56,7 @@ public:
   ~Renderer() override = default;
 
   [[nodiscard]] auto renderFrame(const MivBitstream::AccessUnit &frame,
-                                 const MivBitstream::CameraConfig &cameraConfig) const
+                                 const MivBitstream::CameraConfig &cameraConfig)
       -> Common::RendererFrame override;
 
   [[nodiscard]] auto isOptimizedForRestrictedGeometry() const -> bool override {
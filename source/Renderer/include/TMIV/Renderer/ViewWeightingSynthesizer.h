@@ -52,7 +52,7 @@ public:
 
   // Render from a texture atlas to a viewport
   auto renderFrame(const MivBitstream::AccessUnit &frame,
-                   const MivBitstream::CameraConfig &cameraConfig) const
+                   const MivBitstream::CameraConfig &cameraConfig)
       -> Common::RendererFrame override;
 };
 } // namespace TMIV::Renderer
@@ -38,6 +38,8 @@
 
 #include <TMIV/Common/Json.h>
 
+#include <memory>
+
 namespace TMIV::Renderer {
 class ViewingSpaceController : public IViewingSpaceController {
 public:
@@ -46,11 +48,17 @@ public:
   ViewingSpaceController(ViewingSpaceController &&) = default;
   auto operator=(const ViewingSpaceController &) -> ViewingSpaceController & = delete;
   auto operator=(ViewingSpaceController &&) -> ViewingSpaceController & = default;
-  ~ViewingSpaceController() override = default;
+  ~ViewingSpaceController() override;
 
   void inplaceFading(Common::RendererFrame &viewport,
                      const MivBitstream::ViewParams &viewportParams,
-                     const MivBitstream::ViewingSpace &viewingSpace) const override;
+                     const MivBitstream::ViewingSpace &viewingSpace) override;
+
+private:
+  // Caches the inclusion index of the last evaluated pose
+  class Impl;
+
+  std::unique_ptr<Impl> m_impl;
 };
 } // namespace TMIV::Renderer
 
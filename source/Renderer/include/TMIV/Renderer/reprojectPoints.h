@@ -87,6 +87,8 @@ public:
       -> Common::Vec3f = 0;
   [[nodiscard]] virtual auto projectVertex(const SceneVertexDescriptor &v) const
       -> ImageVertexDescriptor = 0;
+  virtual void unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const = 0;
+  virtual void projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const = 0;
 };
 
 template <MivBitstream::CiCamType camType> class Variant : public Base, public Engine<camType> {
@@ -103,6 +105,12 @@ public:
       -> ImageVertexDescriptor override {
     return engine_type::projectVertex(v);
   }
+  void unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const override {
+    engine_type::unprojectBatch(in, out);
+  }
+  void projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const override {
+    engine_type::projectBatch(in, out);
+  }
 };
 
 using Perspective = Variant<MivBitstream::CiCamType::perspective>;
@@ -142,6 +150,14 @@ public:
   [[nodiscard]] auto changeFrame(const Common::Vec3f &P) const -> Common::Vec3f;
   [[nodiscard]] auto doProjection(const Common::Vec3f &P) const -> std::pair<Common::Vec2f, float>;
   [[nodiscard]] auto doUnprojection(const Common::Vec2f &p, float d) const -> Common::Vec3f;
+
+  // Batched versions of doProjection and doUnprojection
+  //
+  // The projection type is dispatched once per batch instead of once per point. The results are
+  // identical to those of the per-point methods.
+  void doProjection(const PointCloud &P, ImagePointBatch &p) const;
+  void doUnprojection(const ImagePointBatch &p, PointCloud &P) const;
+
   [[nodiscard]] auto isStrictlyInsideViewport(const Common::Vec2f &p) const -> bool;
   [[nodiscard]] auto isInsideViewport(const Common::Vec2f &p) const -> bool;
   [[nodiscard]] auto isValidDepth(float d) const -> bool;
@@ -35,6 +35,7 @@
 
 #include <TMIV/Common/LinAlg.h>
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
+#include <TMIV/MivBitstream/PatchRenderTable.h>
 #include <TMIV/Renderer/Engine.h>
 #include <TMIV/Renderer/Rasterizer.h>
 #include <TMIV/Renderer/reprojectPoints.h>
@@ -77,14 +78,16 @@ public:
     result.reserve(rows * cols);
 
     const auto transformList = affineTransformList(frame.viewParamsList, viewportParams.pose);
+    const auto patches =
+        MivBitstream::PatchRenderTable{atlas.patchParamsList, frame.viewParamsList};
 
     std::vector<MivBitstream::DepthTransform> depthTransform;
     depthTransform.reserve(atlas.patchParamsList.size());
 
-    for (const auto &patch : atlas.patchParamsList) {
+    for (size_t patchIdx = 0; patchIdx < atlas.patchParamsList.size(); ++patchIdx) {
       const auto geoBitDepth = atlas.geoFrame.getBitDepth();
-      depthTransform.emplace_back(frame.viewParamsList[patch.atlasPatchProjectionId()].dq, patch,
-                                  geoBitDepth);
+      depthTransform.emplace_back(frame.viewParamsList[patches.viewIdx[patchIdx]].dq,
+                                  atlas.patchParamsList[patchIdx], geoBitDepth);
     }
 
     // For each used pixel in the atlas...
@@ -105,12 +108,12 @@ public:
         }
 
         // Look up metadata
-        const auto &patch = atlas.patchParamsList[patchIdx];
-        const auto viewIdx = frame.viewParamsList.indexOf(patch.atlasPatchProjectionId());
+        const auto viewIdx = patches.viewIdx[patchIdx];
         const auto &viewParams = frame.viewParamsList[viewIdx];
 
         // Look up depth value and affine parameters
-        const auto uv = Common::Vec2f{Common::floatCast, patch.atlasToView({j_atlas, i_atlas})};
+        const auto uv =
+            Common::Vec2f{Common::floatCast, patches.atlasToView(patchIdx, {j_atlas, i_atlas})};
         auto level = atlas.geoFrame.getPlane(0)(i_atlas, j_atlas);
         const auto d = depthTransform[patchIdx].expandDepth(level);
 
@@ -289,7 +292,7 @@ AdditiveSynthesizer::AdditiveSynthesizer(float rayAngleParam, float depthParam,
 AdditiveSynthesizer::~AdditiveSynthesizer() = default;
 
 auto AdditiveSynthesizer::renderFrame(const MivBitstream::AccessUnit &frame,
-                                      const MivBitstream::CameraConfig &cameraConfig) const
+                                      const MivBitstream::CameraConfig &cameraConfig)
     -> Common::RendererFrame {
   return m_impl->renderFrame(frame, cameraConfig);
 }
@@ -0,0 +1,171 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <TMIV/Renderer/Engine.h>
+
+// The batched kernels are written as loops without branches over plain arrays such that the
+// compiler can vectorize them. Each loop writes a single output array to keep the number of
+// run-time aliasing checks low. See CMakeLists.txt for the compiler flags of this file.
+
+namespace TMIV::Renderer {
+using Perspective = Engine<MivBitstream::CiCamType::perspective>;
+using Equirectangular = Engine<MivBitstream::CiCamType::equirectangular>;
+using Orthographic = Engine<MivBitstream::CiCamType::orthographic>;
+
+void Perspective::unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const {
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const u = in.u.data();
+  const auto *const v = in.v.data();
+  const auto *const depth = in.depth.data();
+  auto *const x = out.x.data();
+  auto *const y = out.y.data();
+  auto *const z = out.z.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    x[i] = depth[i] > 0.F ? depth[i] : NAN;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    const auto value = -(depth[i] / f_x) * (u[i] - c_x);
+    y[i] = depth[i] > 0.F ? value : NAN;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    const auto value = -(depth[i] / f_y) * (v[i] - c_y);
+    z[i] = depth[i] > 0.F ? value : NAN;
+  }
+}
+
+void Perspective::projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const {
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const x = in.x.data();
+  const auto *const y = in.y.data();
+  const auto *const z = in.z.data();
+  auto *const u = out.u.data();
+  auto *const v = out.v.data();
+  auto *const depth = out.depth.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto value = -f_x * y[i] / x[i] + c_x;
+    u[i] = x[i] > 0.F ? value : NAN;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    const auto value = -f_y * z[i] / x[i] + c_y;
+    v[i] = x[i] > 0.F ? value : NAN;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    depth[i] = x[i] > 0.F ? x[i] : NAN;
+  }
+}
+
+void Equirectangular::unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const {
+  using std::cos;
+  using std::sin;
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const u = in.u.data();
+  const auto *const v = in.v.data();
+  const auto *const depth = in.depth.data();
+  auto *const x = out.x.data();
+  auto *const y = out.y.data();
+  auto *const z = out.z.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    const float phi = phi0 + dphi_du * u[i];
+    const float theta = theta0 + dtheta_dv * v[i];
+    x[i] = depth[i] * (cos(theta) * cos(phi));
+    y[i] = depth[i] * (cos(theta) * sin(phi));
+    z[i] = depth[i] * sin(theta);
+  }
+}
+
+void Equirectangular::projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const {
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const x = in.x.data();
+  const auto *const y = in.y.data();
+  const auto *const z = in.z.data();
+  auto *const u = out.u.data();
+  auto *const v = out.v.data();
+  auto *const depth = out.depth.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    const auto p = projectVertex({{x[i], y[i], z[i]}, 0.F});
+    u[i] = p.position.x();
+    v[i] = p.position.y();
+    depth[i] = p.depth;
+  }
+}
+
+void Orthographic::unprojectBatch(const ImagePointBatch &in, ScenePointBatch &out) const {
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const u = in.u.data();
+  const auto *const v = in.v.data();
+  auto *const y = out.y.data();
+  auto *const z = out.z.data();
+
+  out.x = in.depth;
+
+  for (size_t i = 0; i < n; ++i) {
+    y[i] = ow * (u[i] / ppw - 0.5F);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    z[i] = oh * (v[i] / pph - 0.5F);
+  }
+}
+
+void Orthographic::projectBatch(const ScenePointBatch &in, ImagePointBatch &out) const {
+  const auto n = in.size();
+  out.resize(n);
+
+  const auto *const y = in.y.data();
+  const auto *const z = in.z.data();
+  auto *const u = out.u.data();
+  auto *const v = out.v.data();
+
+  for (size_t i = 0; i < n; ++i) {
+    u[i] = ppw * (0.5F + y[i] / ow);
+  }
+  for (size_t i = 0; i < n; ++i) {
+    v[i] = pph * (0.5F + z[i] / oh);
+  }
+
+  out.depth = in.x;
+}
+} // namespace TMIV::Renderer
@@ -31,6 +31,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+//#define CATCH_CONFIG_ENABLE_BENCHMARKING // Uncomment me to run benchmarks
 #include <catch2/catch.hpp>
 
 #include <TMIV/Renderer/Engine.h>
@@ -40,8 +41,27 @@ using TMIV::Common::Vec2f;
 using TMIV::Common::Vec3f;
 using TMIV::MivBitstream::CameraIntrinsics;
 using TMIV::MivBitstream::CiCamType;
+using TMIV::Renderer::ImagePointBatch;
+using TMIV::Renderer::ScenePointBatch;
 using TMIV::Renderer::SceneVertexDescriptor;
 
+namespace {
+auto same(float a, float b) -> bool { return (std::isnan(a) && std::isnan(b)) || a == b; }
+
+auto imagePointGrid() -> ImagePointBatch {
+  auto imagePoints = ImagePointBatch{};
+
+  for (int32_t i = 0; i < 500; i += 7) {
+    for (int32_t j = 0; j < 1000; j += 11) {
+      imagePoints.u.push_back(0.5F + static_cast<float>(j));
+      imagePoints.v.push_back(0.5F + static_cast<float>(i));
+      imagePoints.depth.push_back(static_cast<float>((i + j) % 13) - 2.F);
+    }
+  }
+  return imagePoints;
+}
+} // namespace
+
 TEST_CASE("Engine<equirectangular>") {
   const auto unit = []() {
     auto ci = CameraIntrinsics{};
@@ -82,4 +102,64 @@ TEST_CASE("Engine<equirectangular>") {
 
     REQUIRE(count == 3103);
   }
+
+  SECTION("Batched (un)projection is identical to the per-point equations") {
+    const auto imagePoints = imagePointGrid();
+
+    auto scenePoints = ScenePointBatch{};
+    unit.unprojectBatch(imagePoints, scenePoints);
+    REQUIRE(scenePoints.size() == imagePoints.size());
+
+    auto reprojected = ImagePointBatch{};
+    unit.projectBatch(scenePoints, reprojected);
+    REQUIRE(reprojected.size() == imagePoints.size());
+
+    for (size_t k = 0; k < imagePoints.size(); ++k) {
+      const auto p =
+          unit.unprojectVertex({imagePoints.u[k], imagePoints.v[k]}, imagePoints.depth[k]);
+      REQUIRE(same(scenePoints.x[k], p.x()));
+      REQUIRE(same(scenePoints.y[k], p.y()));
+      REQUIRE(same(scenePoints.z[k], p.z()));
+
+      const auto q = unit.projectVertex(SceneVertexDescriptor{p, 0.F});
+      REQUIRE(same(reprojected.u[k], q.position.x()));
+      REQUIRE(same(reprojected.v[k], q.position.y()));
+      REQUIRE(same(reprojected.depth[k], q.depth));
+    }
+  }
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Benchmark: Engine<equirectangular> projection") {
+  auto ci = CameraIntrinsics{};
+  ci.ci_cam_type(CiCamType::equirectangular)
+      .ci_projection_plane_width_minus1(1919)
+      .ci_projection_plane_height_minus1(1079);
+  const auto unit = TMIV::Renderer::Engine<CiCamType::equirectangular>{ci};
+
+  auto imagePoints = ImagePointBatch{};
+  for (int32_t i = 0; i < 1080; ++i) {
+    for (int32_t j = 0; j < 1920; ++j) {
+      imagePoints.u.push_back(0.5F + static_cast<float>(j));
+      imagePoints.v.push_back(0.5F + static_cast<float>(i));
+      imagePoints.depth.push_back(1.F + static_cast<float>((i + j) % 13));
+    }
+  }
+  auto scenePoints = ScenePointBatch{};
+  unit.unprojectBatch(imagePoints, scenePoints);
+
+  BENCHMARK("1920x1080 points, per point") {
+    auto sum = 0.F;
+    for (size_t k = 0; k < scenePoints.size(); ++k) {
+      const auto p = Vec3f{scenePoints.x[k], scenePoints.y[k], scenePoints.z[k]};
+      sum += unit.projectVertex(SceneVertexDescriptor{p, 0.F}).position.x();
+    }
+    return sum;
+  };
+
+  BENCHMARK("1920x1080 points, batched") {
+    unit.projectBatch(scenePoints, imagePoints);
+    return imagePoints.u.front();
+  };
 }
+#endif
@@ -40,8 +40,27 @@ using TMIV::Common::Vec2f;
 using TMIV::Common::Vec3f;
 using TMIV::MivBitstream::CameraIntrinsics;
 using TMIV::MivBitstream::CiCamType;
+using TMIV::Renderer::ImagePointBatch;
+using TMIV::Renderer::ScenePointBatch;
 using TMIV::Renderer::SceneVertexDescriptor;
 
+namespace {
+auto same(float a, float b) -> bool { return (std::isnan(a) && std::isnan(b)) || a == b; }
+
+auto imagePointGrid() -> ImagePointBatch {
+  auto imagePoints = ImagePointBatch{};
+
+  for (int32_t i = 0; i < 500; i += 7) {
+    for (int32_t j = 0; j < 1000; j += 11) {
+      imagePoints.u.push_back(0.5F + static_cast<float>(j));
+      imagePoints.v.push_back(0.5F + static_cast<float>(i));
+      imagePoints.depth.push_back(static_cast<float>((i + j) % 13) - 2.F);
+    }
+  }
+  return imagePoints;
+}
+} // namespace
+
 TEST_CASE("Engine<perspective>") {
   const auto unit = []() {
     auto ci = CameraIntrinsics{};
@@ -81,4 +100,29 @@ TEST_CASE("Engine<perspective>") {
 
     REQUIRE(count == 3103);
   }
+
+  SECTION("Batched (un)projection is identical to the per-point equations") {
+    const auto imagePoints = imagePointGrid();
+
+    auto scenePoints = ScenePointBatch{};
+    unit.unprojectBatch(imagePoints, scenePoints);
+    REQUIRE(scenePoints.size() == imagePoints.size());
+
+    auto reprojected = ImagePointBatch{};
+    unit.projectBatch(scenePoints, reprojected);
+    REQUIRE(reprojected.size() == imagePoints.size());
+
+    for (size_t k = 0; k < imagePoints.size(); ++k) {
+      const auto p =
+          unit.unprojectVertex({imagePoints.u[k], imagePoints.v[k]}, imagePoints.depth[k]);
+      REQUIRE(same(scenePoints.x[k], p.x()));
+      REQUIRE(same(scenePoints.y[k], p.y()));
+      REQUIRE(same(scenePoints.z[k], p.z()));
+
+      const auto q = unit.projectVertex(SceneVertexDescriptor{p, 0.F});
+      REQUIRE(same(reprojected.u[k], q.position.x()));
+      REQUIRE(same(reprojected.v[k], q.position.y()));
+      REQUIRE(same(reprojected.depth[k], q.depth));
+    }
+  }
 }
\ No newline at end of file
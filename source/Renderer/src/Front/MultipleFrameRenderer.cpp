@@ -38,6 +38,8 @@
 #include <TMIV/Renderer/ICuller.h>
 #include <TMIV/Renderer/IRenderer.h>
 
+#include <numeric>
+
 using namespace std::string_literals;
 
 namespace TMIV::Renderer::Front {
@@ -48,7 +50,7 @@ public:
 
   void renderMultipleFrames(const MivBitstream::AccessUnit &frame,
                             const FrameMapping::const_iterator &first,
-                            const FrameMapping::const_iterator &last) const;
+                            const FrameMapping::const_iterator &last);
 
   [[nodiscard]] auto isOptimizedForRestrictedGeometry() const -> bool {
     // NOTe(FT): added to handle the absence of renderer in the G3 anchor type
@@ -60,7 +62,7 @@ public:
 
 private:
   void renderFrame(MivBitstream::AccessUnit frame, int32_t outputFrameIndex,
-                   const std::string &cameraName, bool isPoseTrace) const;
+                   const std::string &cameraName, bool isPoseTrace);
 
   const Common::Json &m_config;
   const std::vector<std::string> &m_outputCameraNames;
@@ -81,7 +83,7 @@ MultipleFrameRenderer::~MultipleFrameRenderer() = default;
 
 void MultipleFrameRenderer::renderMultipleFrames(const MivBitstream::AccessUnit &frame,
                                                  const FrameMapping::const_iterator &first,
-                                                 const FrameMapping::const_iterator &last) const {
+                                                 const FrameMapping::const_iterator &last) {
   m_impl->renderMultipleFrames(frame, first, last);
 }
 
@@ -106,9 +108,9 @@ MultipleFrameRenderer::Impl::Impl(const Common::Json &rootNode,
   }
 }
 
-void MultipleFrameRenderer::Impl::renderMultipleFrames(
-    const MivBitstream::AccessUnit &frame, const FrameMapping::const_iterator &first,
-    const FrameMapping::const_iterator &last) const {
+void MultipleFrameRenderer::Impl::renderMultipleFrames(const MivBitstream::AccessUnit &frame,
+                                                       const FrameMapping::const_iterator &first,
+                                                       const FrameMapping::const_iterator &last) {
   for (auto i = first; i != last; ++i) {
     if (i->first == i->second) {
       for (const auto &name : m_outputCameraNames) {
@@ -124,14 +126,23 @@ void MultipleFrameRenderer::Impl::renderMultipleFrames(
 void MultipleFrameRenderer::Impl::renderFrame(MivBitstream::AccessUnit frame,
                                               int32_t outputFrameIndex,
                                               const std::string &cameraName,
-                                              bool isPoseTrace) const {
+                                              bool isPoseTrace) {
   Common::logInfo("Rendering input frame {} to output frame {} for target {} {}.", frame.frameIdx,
                   outputFrameIndex, isPoseTrace ? "pose trace" : "view", cameraName);
 
   const auto viewportParams =
       IO::loadViewportMetadata(m_config, m_placeholders, outputFrameIndex, cameraName, isPoseTrace);
 
-  m_culler->inplaceFilterBlockToPatchMaps(frame, viewportParams.viewParams);
+  const auto culledSamples =
+      m_culler->inplaceFilterBlockToPatchMaps(frame, viewportParams.viewParams);
+  const auto totalSamples = std::accumulate(
+      frame.atlas.cbegin(), frame.atlas.cend(), size_t{}, [](size_t n, const auto &atlas) {
+        return n + static_cast<size_t>(atlas.asps.asps_frame_width()) *
+                       static_cast<size_t>(atlas.asps.asps_frame_height());
+      });
+  Common::logVerbose("Culled {} of {} atlas samples ({:.1f}%).", culledSamples, totalSamples,
+                     totalSamples == 0 ? 0. : 100. * static_cast<double>(culledSamples) /
+                                                  static_cast<double>(totalSamples));
 
   const auto viewport = m_renderer->renderFrame(frame, viewportParams);
   IO::saveViewport(m_config, m_placeholders, outputFrameIndex, cameraName,
@@ -63,7 +63,7 @@ struct FakeRenderer : public TMIV::Renderer::IRenderer {
 
   [[nodiscard]] auto
   renderFrame(const TMIV::MivBitstream::AccessUnit & /* frame */,
-              const TMIV::MivBitstream::CameraConfig & /* viewportParams */) const
+              const TMIV::MivBitstream::CameraConfig & /* viewportParams */)
       -> TMIV::Common::RendererFrame override {
     throw std::logic_error("Unexpected call to renderFrame");
   }
@@ -91,7 +91,7 @@ TEST_CASE("Render multiple frames") {
     const auto outputCameraNames = std::vector<std::string>{};
     const auto outputPoseTraceNames = std::vector<std::string>{};
     const auto placeholders = TMIV::IO::Placeholders{};
-    const auto unit =
+    auto unit =
         MultipleFrameRenderer{rootNode, outputCameraNames, outputPoseTraceNames, placeholders};
 
     SECTION("Rendering no frames") {
@@ -34,357 +34,345 @@
 #include <TMIV/Renderer/Inpainter.h>
 
 #include <TMIV/Common/Common.h>
+#include <TMIV/Common/Thread.h>
 #include <TMIV/Common/verify.h>
 
+#include <algorithm>
 #include <cmath>
 
 namespace TMIV::Renderer {
 namespace {
 constexpr auto depthBlendingThreshold = 655.36; // 1% of bit depth
 
-enum class InpaintingType { horizontal, vertical, omnidirectional };
-
-// NOLINTNEXTLINE(readability-function-cognitive-complexity)
-void perform2WayInpainting(Common::RendererFrame &yuvd, InpaintingType inpaintingType,
-                           const Common::Mat<int32_t> &nonEmptyNeighbor1,
-                           const Common::Mat<int32_t> &nonEmptyNeighbor2,
-                           const Common::Mat<int32_t> &mapERP2Cassini = Common::Mat<int32_t>()) {
-  auto &Y = yuvd.texture.getPlane(0);
-  auto &U = yuvd.texture.getPlane(1);
-  auto &V = yuvd.texture.getPlane(2);
-  auto &D = yuvd.geometry.getPlane(0);
-
-  const auto width = static_cast<int32_t>(Y.width());
-  const auto height = static_cast<int32_t>(Y.height());
-
-  for (int32_t h = 0, pp = 0; h < height; h++) {
-    for (int32_t w = 0; w < width; w++, pp++) {
-      if (D(h, w) != 0) {
-        continue;
-      }
-
-      bool use1 = false;
-      bool use2 = false;
-
-      int32_t w0 = 0;
-      int32_t h0 = 0;
-      int32_t w1 = 0;
-      int32_t h1 = 0;
-      int32_t w2 = 0;
-      int32_t h2 = 0;
-
-      if (inpaintingType == InpaintingType::omnidirectional) {
-        bool pointExistsInCassini = mapERP2Cassini(h, w) != -1;
-        if (!pointExistsInCassini) {
-          continue;
-        }
-
-        h0 = mapERP2Cassini(h, w) / width; // current pixel in Cassini
-                                           // projection
-        w0 = mapERP2Cassini(h, w) % width;
+// Column scans are parallelized over vertical strips of this width to keep row-major access
+constexpr auto columnStripWidth = 64;
+
+struct YuvdPlanes {
+  explicit YuvdPlanes(Common::RendererFrame &yuvd)
+      : Y{yuvd.texture.getPlane(0)}
+      , U{yuvd.texture.getPlane(1)}
+      , V{yuvd.texture.getPlane(2)}
+      , D{yuvd.geometry.getPlane(0)} {}
+
+  Common::Mat<> &Y;
+  Common::Mat<> &U;
+  Common::Mat<> &V;
+  Common::Mat<> &D;
+};
+
+struct Neighbor {
+  bool valid{};
+  int32_t h{};
+  int32_t w{};
+};
+
+// Fill the hole at (h, w) from its two nearest non-empty neighbors on opposite sides. The
+// neighbors are non-empty samples in the input, thus holes can be filled in any order.
+template <typename DistanceFunction>
+void fillHole(YuvdPlanes &p, int32_t h, int32_t w, const Neighbor &n1, const Neighbor &n2,
+              DistanceFunction distance) {
+  bool use1 = false;
+  bool use2 = false;
+
+  if (n1.valid) {
+    if (n2.valid) {
+      const auto farthestDepth = std::min(p.D(n1.h, n1.w), p.D(n2.h, n2.w));
+      use1 = p.D(n1.h, n1.w) - farthestDepth <= depthBlendingThreshold;
+      use2 = p.D(n2.h, n2.w) - farthestDepth <= depthBlendingThreshold;
+    } else {
+      use1 = true;
+    }
+  } else if (n2.valid) {
+    use2 = true;
+  } else {
+    return;
+  }
 
-        h1 = nonEmptyNeighbor1(h0, w0) / width; // left neighbor in Cassini projection
-        w1 = nonEmptyNeighbor1(h0, w0) % width;
+  if (use1 && use2) {
+    const auto dist1 = distance(n1);
+    const auto dist2 = distance(n2);
+    const auto sumdist = dist1 + dist2;
+    const auto weight1 = dist2 / sumdist;
+    const auto weight2 = dist1 / sumdist;
+
+    const auto blend = [&](Common::Mat<> &X) {
+      X(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(X(n1.h, n1.w)) * weight1);
+      X(h, w) += Common::assertDownCast<uint16_t>(static_cast<float>(X(n2.h, n2.w)) * weight2);
+    };
+    blend(p.Y);
+    blend(p.U);
+    blend(p.V);
+    blend(p.D);
+
+    if (p.D(h, w) == 0) {
+      p.D(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(p.D(n1.h, n1.w)) * weight1 +
+                                                   static_cast<float>(p.D(n2.h, n2.w)) * weight2);
+    }
+  } else {
+    const auto &n = use1 ? n1 : n2;
 
-        h2 = nonEmptyNeighbor2(h0, w0) / width; // right neighbor in Cassini projection
-        w2 = nonEmptyNeighbor2(h0, w0) % width;
-      } else {  // perspective
-        h0 = h; // current pixel
-        w0 = w;
+    p.Y(h, w) = p.Y(n.h, n.w);
+    p.U(h, w) = p.U(n.h, n.w);
+    p.V(h, w) = p.V(n.h, n.w);
+    p.D(h, w) = p.D(n.h, n.w);
+  }
+}
 
-        h1 = inpaintingType == InpaintingType::vertical
-                 ? h0
-                 : nonEmptyNeighbor1(h0, w0); // left or top neighbor
-        w1 = inpaintingType == InpaintingType::vertical ? nonEmptyNeighbor1(h0, w0) : w0;
+// Inpaint along rows (horizontal) or columns (vertical) using per-sample neighbor coordinates
+// along that direction. Each row is independent because only holes are written.
+void perform2WayInpainting(Common::RendererFrame &yuvd, bool alongRows,
+                           const Common::Mat<int32_t> &nonEmptyNeighbor1,
+                           const Common::Mat<int32_t> &nonEmptyNeighbor2) {
+  auto p = YuvdPlanes{yuvd};
+  const auto width = static_cast<int32_t>(p.D.width());
 
-        h2 = inpaintingType == InpaintingType::vertical
-                 ? h0
-                 : nonEmptyNeighbor2(h0, w0); // right or bottom neighbor
-        w2 = inpaintingType == InpaintingType::vertical ? nonEmptyNeighbor2(h0, w0) : w0;
-      }
+  Common::parallel_for(p.D.height(), [&](size_t row) {
+    const auto h = static_cast<int32_t>(row);
 
-      if (nonEmptyNeighbor1(h0, w0) != -1) {
-        if (nonEmptyNeighbor2(h0, w0) != -1) {
-          const auto farthestDepth = D(h1, w1) < D(h2, w2) ? D(h1, w1) : D(h2, w2);
-          if (D(h1, w1) - farthestDepth <= depthBlendingThreshold) {
-            use1 = true;
-          }
-          if (D(h2, w2) - farthestDepth <= depthBlendingThreshold) {
-            use2 = true;
-          }
-        } else {
-          use1 = true;
-        }
-      } else {
-        if (nonEmptyNeighbor2(h0, w0) != -1) {
-          use2 = true;
-        } else {
-          continue;
-        }
+    for (int32_t w = 0; w < width; ++w) {
+      if (p.D(h, w) != 0) {
+        continue;
       }
 
-      if (use1) {
-        if (use2) {
-          auto dist1 = std::sqrt(static_cast<float>((h - h1) * (h - h1) + (w - w1) * (w - w1)));
-          auto dist2 = std::sqrt(static_cast<float>((h - h2) * (h - h2) + (w - w2) * (w - w2)));
-          const auto sumdist = dist1 + dist2;
-          const auto weight1 = dist2 / sumdist;
-          const auto weight2 = dist1 / sumdist;
-
-          Y(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(Y(h1, w1)) * weight1);
-          U(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(U(h1, w1)) * weight1);
-          V(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(V(h1, w1)) * weight1);
-          D(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(D(h1, w1)) * weight1);
-
-          Y(h, w) += Common::assertDownCast<uint16_t>(static_cast<float>(Y(h2, w2)) * weight2);
-          U(h, w) += Common::assertDownCast<uint16_t>(static_cast<float>(U(h2, w2)) * weight2);
-          V(h, w) += Common::assertDownCast<uint16_t>(static_cast<float>(V(h2, w2)) * weight2);
-          D(h, w) += Common::assertDownCast<uint16_t>(static_cast<float>(D(h2, w2)) * weight2);
-
-          if (D(h, w) == 0) {
-            D(h, w) = Common::assertDownCast<uint16_t>(static_cast<float>(D(h1, w1)) * weight1 +
-                                                       static_cast<float>(D(h2, w2)) * weight2);
-          }
-        } else {
-          Y(h, w) = Y(h1, w1);
-          U(h, w) = U(h1, w1);
-          V(h, w) = V(h1, w1);
-          D(h, w) = D(h1, w1);
-        }
-      } else {
-        if (use2) {
-          Y(h, w) = Y(h2, w2);
-          U(h, w) = U(h2, w2);
-          V(h, w) = V(h2, w2);
-          D(h, w) = D(h2, w2);
-        } else {
-          continue;
-        }
-      }
+      const auto i1 = nonEmptyNeighbor1(h, w);
+      const auto i2 = nonEmptyNeighbor2(h, w);
+      const auto n1 = alongRows ? Neighbor{i1 != -1, h, i1} : Neighbor{i1 != -1, i1, w};
+      const auto n2 = alongRows ? Neighbor{i2 != -1, h, i2} : Neighbor{i2 != -1, i2, w};
 
-    } // w
-  }   // h
+      // The distance is one-dimensional, which is what sqrt(d * d) evaluated to
+      fillHole(p, h, w, n1, n2, [=](const Neighbor &n) {
+        return static_cast<float>(alongRows ? std::abs(w - n.w) : std::abs(h - n.h));
+      });
+    }
+  });
 }
 
 void fillVerticalCracks(Common::RendererFrame &yuvd) {
-  auto &Y = yuvd.texture.getPlane(0);
-  auto &U = yuvd.texture.getPlane(1);
-  auto &V = yuvd.texture.getPlane(2);
-  auto &D = yuvd.geometry.getPlane(0);
+  auto p = YuvdPlanes{yuvd};
+  const auto width = static_cast<int32_t>(p.D.width());
 
-  const auto width = static_cast<int32_t>(Y.width());
-  const auto height = static_cast<int32_t>(Y.height());
+  // Within a row a filled crack is visible to the next sample, so only rows are parallelized
+  Common::parallel_for(p.D.height(), [&](size_t row) {
+    const auto h = static_cast<int32_t>(row);
 
-  // fill vertical cracks
-  for (int32_t h = 0; h < height; h++) {
     for (int32_t w = 1; w < width - 1; w++) {
-      if (D(h, w) == 0 && D(h, w - 1) != 0 && D(h, w + 1) != 0) {
-        Y(h, w) = (Y(h, w - 1) + Y(h, w + 1)) / 2;
-        U(h, w) = (U(h, w - 1) + U(h, w + 1)) / 2;
-        V(h, w) = (V(h, w - 1) + V(h, w + 1)) / 2;
-        D(h, w) = (D(h, w - 1) + D(h, w + 1)) / 2;
+      if (p.D(h, w) == 0 && p.D(h, w - 1) != 0 && p.D(h, w + 1) != 0) {
+        p.Y(h, w) = (p.Y(h, w - 1) + p.Y(h, w + 1)) / 2;
+        p.U(h, w) = (p.U(h, w - 1) + p.U(h, w + 1)) / 2;
+        p.V(h, w) = (p.V(h, w - 1) + p.V(h, w + 1)) / 2;
+        p.D(h, w) = (p.D(h, w - 1) + p.D(h, w + 1)) / 2;
       }
     }
-  }
+  });
 }
 
-void inpaintOmnidirectionalView(Common::RendererFrame &yuvd, double fullOmniRangePercentage) {
-  auto &Y = yuvd.texture.getPlane(0);
-  auto &D = yuvd.geometry.getPlane(0);
-
-  auto isHole = Common::Mat<uint8_t>{Y.sizes(), 1};
-  auto nonEmptyNeighborL = Common::Mat<int32_t>{Y.sizes(), -1};
-  auto nonEmptyNeighborR = Common::Mat<int32_t>{Y.sizes(), -1};
-  auto mapERP2Cassini = Common::Mat<int32_t>{Y.sizes(), -1};
-  auto mapCassini2ERP = Common::Mat<int32_t>{Y.sizes(), -1};
-
-  const auto width = static_cast<int32_t>(Y.width());
-  const auto height = static_cast<int32_t>(Y.height());
-
-  const auto width2 = width / 2;
-  const auto height2 = height / 2;
-  for (int32_t h = 0; h < height; h++) {
-    auto oldH = h - height2;
-    for (int32_t w = 0; w < width; w++) {
-      auto oldPP = h * width + w;
-
-      auto oldW = w - width2;
-      auto tmpH = std::sqrt(height * h - h * h);
-      if (tmpH / height2 > fullOmniRangePercentage) {
-        tmpH = height2 * fullOmniRangePercentage;
-      }
-      auto newW = oldW * tmpH / height2;
-      newW += width2;
+// For each sample the index of the nearest non-empty sample to the left and to the right in the
+// same row, or -1. The index of a non-empty sample is taken from indexOf.
+template <typename IsEmpty, typename IndexOf>
+void scanRows(Common::Mat<int32_t> &left, Common::Mat<int32_t> &right, IsEmpty isEmpty,
+              IndexOf indexOf) {
+  const auto width = static_cast<int32_t>(left.width());
 
-      auto tmpW = std::sqrt(width * newW - newW * newW);
-      auto newH = oldH * width2 / tmpW;
-      newH += height2;
+  Common::parallel_for(left.height(), [&](size_t row) {
+    const auto h = static_cast<int32_t>(row);
 
-      auto iNewH = std::lround(newH);
-      auto iNewW = std::lround(newW);
+    auto last = int32_t{-1};
+    for (int32_t w = 0; w < width; ++w) {
+      last = isEmpty(h, w) ? last : indexOf(h, w);
+      left(h, w) = last;
+    }
 
-      if (iNewH < 0 || iNewH >= height) {
-        continue;
-      }
+    last = -1;
+    for (int32_t w = width - 1; w >= 0; --w) {
+      last = isEmpty(h, w) ? last : indexOf(h, w);
+      right(h, w) = last;
+    }
+  });
+}
 
-      auto newPP = iNewH * width + iNewW;
+// For each sample the row index of the nearest non-empty sample above and below in the same
+// column, or -1
+void scanColumns(Common::Mat<int32_t> &top, Common::Mat<int32_t> &bottom,
+                 const Common::Mat<> &D) {
+  const auto width = static_cast<int32_t>(D.width());
+  const auto height = static_cast<int32_t>(D.height());
+  const auto strips = (width + columnStripWidth - 1) / columnStripWidth;
 
-      mapERP2Cassini(h, w) = Common::assertDownCast<int32_t>(newPP);
-      if (isHole(iNewH, iNewW) == 1) {
-        mapCassini2ERP(iNewH, iNewW) = oldPP;
+  Common::parallel_for(static_cast<size_t>(strips), [&](size_t strip) {
+    const auto w0 = static_cast<int32_t>(strip) * columnStripWidth;
+    const auto w1 = std::min(width, w0 + columnStripWidth);
+
+    for (int32_t h = 0; h < height; ++h) {
+      for (int32_t w = w0; w < w1; ++w) {
+        top(h, w) = D(h, w) != 0 ? h : (h > 0 ? top(h - 1, w) : -1);
       }
-      if (D(h, w) != 0) {
-        isHole(iNewH, iNewW) = 0; // 1 if hole
+    }
+    for (int32_t h = height - 1; h >= 0; --h) {
+      for (int32_t w = w0; w < w1; ++w) {
+        bottom(h, w) = D(h, w) != 0 ? h : (h < height - 1 ? bottom(h + 1, w) : -1);
       }
     }
+  });
+}
+} // namespace
+
+class Inpainter::Impl {
+public:
+  void inplaceInpaint(Common::RendererFrame &yuvd, const MivBitstream::ViewParams &meta) {
+    fillVerticalCracks(yuvd);
+
+    if (meta.ci.ci_cam_type() == MivBitstream::CiCamType::equirectangular) {
+      const auto fullOmniRangePercentage =
+          (meta.ci.ci_erp_phi_max() - meta.ci.ci_erp_phi_min()) / 360.;
+      inpaintOmnidirectionalView(yuvd, fullOmniRangePercentage);
+    }
+
+    inpaintPerspectiveView(yuvd);
   }
 
-  // analysis from top-left
+private:
+  void inpaintOmnidirectionalView(Common::RendererFrame &yuvd, double fullOmniRangePercentage) {
+    auto p = YuvdPlanes{yuvd};
+    const auto width = static_cast<int32_t>(p.D.width());
+    const auto height = static_cast<int32_t>(p.D.height());
 
-  for (int32_t h = 0; h < height; h++) {
-    for (int32_t w = 0; w < width; w++) {
-      nonEmptyNeighborL(h, w) = mapCassini2ERP(h, w);
-      if (isHole(h, w) != 0) {
-        if (w > 0) {
-          nonEmptyNeighborL(h, w) = nonEmptyNeighborL(h, w - 1);
-        } else {
-          nonEmptyNeighborL(h, w) = -1;
-        }
-      }
+    updateCassiniMapping(width, height, fullOmniRangePercentage);
+
+    // The first non-empty ERP sample that maps onto a Cassini sample, or otherwise the last one
+    m_isHole.resize(p.D.sizes());
+    m_mapCassini2ERP.resize(p.D.sizes());
+    std::fill(m_isHole.begin(), m_isHole.end(), uint8_t{1});
+    std::fill(m_mapCassini2ERP.begin(), m_mapCassini2ERP.end(), -1);
 
-    } // w
-  }   // h
+    const auto *const mapERP2Cassini = m_mapERP2Cassini.data();
+    const auto *const depth = p.D.data();
+    auto *const isHole = m_isHole.data();
+    auto *const mapCassini2ERP = m_mapCassini2ERP.data();
 
-  // analysis from bottom-right
+    for (int32_t i = 0; i < width * height; ++i) {
+      const auto j = mapERP2Cassini[i];
 
-  for (int32_t h = height - 1; h >= 0; h--) {
-    for (int32_t w = width - 1; w >= 0; w--) {
-      nonEmptyNeighborR(h, w) = mapCassini2ERP(h, w);
-      if (isHole(h, w) != 0) {
-        if (w < width - 1) {
-          nonEmptyNeighborR(h, w) = nonEmptyNeighborR(h, w + 1);
-        } else {
-          nonEmptyNeighborR(h, w) = -1;
+      if (j != -1) {
+        if (isHole[j] != 0) {
+          mapCassini2ERP[j] = i;
+        }
+        if (depth[i] != 0) {
+          isHole[j] = 0;
         }
       }
+    }
 
-    } // w
-  }   // h
+    resizeNeighbors(p.D.sizes());
+    scanRows(
+        m_nonEmptyNeighbor1, m_nonEmptyNeighbor2,
+        [this](int32_t h, int32_t w) { return m_isHole(h, w) != 0; },
+        [this](int32_t h, int32_t w) { return m_mapCassini2ERP(h, w); });
 
-  // inpainting
+    Common::parallel_for(p.D.height(), [&](size_t row) {
+      const auto h = static_cast<int32_t>(row);
 
-  perform2WayInpainting(yuvd, InpaintingType::omnidirectional, nonEmptyNeighborL, nonEmptyNeighborR,
-                        mapERP2Cassini);
-}
+      for (int32_t w = 0; w < width; ++w) {
+        const auto pp0 = m_mapERP2Cassini(h, w);
 
-void inpaintPerspectiveView(Common::RendererFrame &yuvd) {
-  auto &D = yuvd.geometry.getPlane(0);
+        if (p.D(h, w) != 0 || pp0 == -1) {
+          continue;
+        }
 
-  const auto width = static_cast<int32_t>(D.width());
-  const auto height = static_cast<int32_t>(D.height());
+        const auto i1 = m_nonEmptyNeighbor1(pp0 / width, pp0 % width);
+        const auto i2 = m_nonEmptyNeighbor2(pp0 / width, pp0 % width);
+        const auto n1 = Neighbor{i1 != -1, i1 / width, i1 % width};
+        const auto n2 = Neighbor{i2 != -1, i2 / width, i2 % width};
 
-  Common::Mat<int32_t> nonEmptyNeighborL;
-  nonEmptyNeighborL.resize(height, width);
+        fillHole(p, h, w, n1, n2, [=](const Neighbor &n) {
+          return std::sqrt(static_cast<float>((h - n.h) * (h - n.h) + (w - n.w) * (w - n.w)));
+        });
+      }
+    });
+  }
 
-  Common::Mat<int32_t> nonEmptyNeighborR;
-  nonEmptyNeighborR.resize(height, width);
+  void inpaintPerspectiveView(Common::RendererFrame &yuvd) {
+    const auto &D = yuvd.geometry.getPlane(0);
 
-  Common::Mat<int32_t> nonEmptyNeighborT;
-  nonEmptyNeighborT.resize(height, width);
+    resizeNeighbors(D.sizes());
 
-  Common::Mat<int32_t> nonEmptyNeighborB;
-  nonEmptyNeighborB.resize(height, width);
+    // horizontal inpainting
 
-  // analysis from top-left
+    scanRows(
+        m_nonEmptyNeighbor1, m_nonEmptyNeighbor2,
+        [&D](int32_t h, int32_t w) { return D(h, w) == 0; },
+        [](int32_t /* h */, int32_t w) { return w; });
+    perform2WayInpainting(yuvd, true, m_nonEmptyNeighbor1, m_nonEmptyNeighbor2);
 
-  for (int32_t h = 0; h < height; h++) {
-    for (int32_t w = 0; w < width; w++) {
-      nonEmptyNeighborL(h, w) = w;
+    // vertical inpainting
 
-      if (D(h, w) == 0) {
-        if (w > 0) {
-          nonEmptyNeighborL(h, w) = nonEmptyNeighborL(h, w - 1);
-        } else {
-          nonEmptyNeighborL(h, w) = -1;
-        }
-      }
-    }
+    scanColumns(m_nonEmptyNeighbor1, m_nonEmptyNeighbor2, D);
+    perform2WayInpainting(yuvd, false, m_nonEmptyNeighbor1, m_nonEmptyNeighbor2);
   }
 
-  // analysis from bottom-right
-
-  for (int32_t h = height - 1; h >= 0; h--) {
-    for (int32_t w = width - 1; w >= 0; w--) {
-      nonEmptyNeighborR(h, w) = w;
-
-      if (D(h, w) == 0) {
-        if (w < width - 1) {
-          nonEmptyNeighborR(h, w) = nonEmptyNeighborR(h, w + 1);
-        } else {
-          nonEmptyNeighborR(h, w) = -1;
-        }
-      }
+  // The ERP-to-Cassini mapping only depends on the viewport size and the ERP range
+  void updateCassiniMapping(int32_t width, int32_t height, double fullOmniRangePercentage) {
+    if (m_mapERP2Cassini.width() == static_cast<size_t>(width) &&
+        m_mapERP2Cassini.height() == static_cast<size_t>(height) &&
+        m_fullOmniRangePercentage == fullOmniRangePercentage) {
+      return;
     }
-  }
+    m_fullOmniRangePercentage = fullOmniRangePercentage;
+    m_mapERP2Cassini.resize(height, width);
 
-  // horizontal inpainting
+    const auto width2 = width / 2;
+    const auto height2 = height / 2;
 
-  perform2WayInpainting(yuvd, InpaintingType::vertical, nonEmptyNeighborL, nonEmptyNeighborR);
+    Common::parallel_for(static_cast<size_t>(height), [&](size_t row) {
+      const auto h = static_cast<int32_t>(row);
+      const auto oldH = h - height2;
 
-  // analysis from top-left
+      for (int32_t w = 0; w < width; w++) {
+        m_mapERP2Cassini(h, w) = -1;
 
-  for (int32_t h = 0; h < height; h++) {
-    for (int32_t w = 0; w < width; w++) {
-      nonEmptyNeighborT(h, w) = h;
-
-      if (D(h, w) == 0) {
-        if (h > 0) {
-          nonEmptyNeighborT(h, w) = nonEmptyNeighborT(h - 1, w);
-        } else {
-          nonEmptyNeighborT(h, w) = -1;
+        auto oldW = w - width2;
+        auto tmpH = std::sqrt(height * h - h * h);
+        if (tmpH / height2 > fullOmniRangePercentage) {
+          tmpH = height2 * fullOmniRangePercentage;
         }
-      }
-    }
-  }
+        auto newW = oldW * tmpH / height2;
+        newW += width2;
 
-  // analysis from bottom-right
+        auto tmpW = std::sqrt(width * newW - newW * newW);
+        auto newH = oldH * width2 / tmpW;
+        newH += height2;
 
-  for (int32_t h = height - 1; h >= 0; h--) {
-    for (int32_t w = width - 1; w >= 0; w--) {
-      nonEmptyNeighborB(h, w) = h;
+        auto iNewH = std::lround(newH);
+        auto iNewW = std::lround(newW);
 
-      if (D(h, w) == 0) {
-        if (h < height - 1) {
-          nonEmptyNeighborB(h, w) = nonEmptyNeighborB(h, w + 1);
-        } else {
-          nonEmptyNeighborB(h, w) = -1;
+        if (iNewH < 0 || iNewH >= height) {
+          continue;
         }
+
+        m_mapERP2Cassini(h, w) = Common::assertDownCast<int32_t>(iNewH * width + iNewW);
       }
-    }
+    });
   }
 
-  // vertical inpainting
-
-  perform2WayInpainting(yuvd, InpaintingType::horizontal, nonEmptyNeighborT, nonEmptyNeighborB);
-}
-
-void inplaceInpaint_impl(Common::RendererFrame &yuvd, const MivBitstream::ViewParams &meta) {
-  fillVerticalCracks(yuvd);
-
-  if (meta.ci.ci_cam_type() == MivBitstream::CiCamType::equirectangular) {
-    const auto fullOmniRangePercentage =
-        (meta.ci.ci_erp_phi_max() - meta.ci.ci_erp_phi_min()) / 360.;
-    inpaintOmnidirectionalView(yuvd, fullOmniRangePercentage);
+  void resizeNeighbors(const Common::Mat<int32_t>::tuple_type &sizes) {
+    m_nonEmptyNeighbor1.resize(sizes);
+    m_nonEmptyNeighbor2.resize(sizes);
   }
 
-  inpaintPerspectiveView(yuvd);
-}
-} // namespace
+  double m_fullOmniRangePercentage{};
+  Common::Mat<int32_t> m_mapERP2Cassini;
+  Common::Mat<int32_t> m_mapCassini2ERP;
+  Common::Mat<uint8_t> m_isHole;
+  Common::Mat<int32_t> m_nonEmptyNeighbor1;
+  Common::Mat<int32_t> m_nonEmptyNeighbor2;
+};
+
+Inpainter::Inpainter(const Common::Json & /*rootNode*/, const Common::Json & /*componentNode*/)
+    : m_impl{std::make_unique<Impl>()} {}
 
-Inpainter::Inpainter(const Common::Json & /*rootNode*/, const Common::Json & /*componentNode*/) {}
+Inpainter::~Inpainter() = default;
 
 void Inpainter::inplaceInpaint(Common::RendererFrame &viewport,
-                               const MivBitstream::ViewParams &metadata) const {
-  inplaceInpaint_impl(viewport, metadata);
+                               const MivBitstream::ViewParams &metadata) {
+  m_impl->inplaceInpaint(viewport, metadata);
 }
 } // namespace TMIV::Renderer
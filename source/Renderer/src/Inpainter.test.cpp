@@ -0,0 +1,135 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Renderer/Inpainter.h>
+
+#include <random>
+
+namespace test {
+namespace {
+using TMIV::Common::Frame;
+using TMIV::Common::RendererFrame;
+using TMIV::MivBitstream::CiCamType;
+using TMIV::MivBitstream::ViewParams;
+
+auto perspectiveViewport() {
+  auto viewParams = ViewParams{};
+  viewParams.ci.ci_cam_type(CiCamType::perspective);
+  return viewParams;
+}
+
+auto equirectangularViewport(float phiRange) {
+  auto viewParams = ViewParams{};
+  viewParams.ci.ci_cam_type(CiCamType::equirectangular)
+      .ci_erp_phi_min(-phiRange / 2)
+      .ci_erp_phi_max(phiRange / 2)
+      .ci_erp_theta_min(-90.F)
+      .ci_erp_theta_max(90.F);
+  return viewParams;
+}
+
+// A frame with random samples of which about half are holes (zero depth). Some rows and columns
+// are empty as a whole, such that both inpainting directions have work to do.
+auto frameWithHoles(int32_t width, int32_t height, uint32_t seed) {
+  auto frame =
+      RendererFrame{Frame<>::yuv444({width, height}, 10), Frame<>::lumaOnly({width, height}, 16)};
+  auto rnd = std::mt19937{seed};
+
+  for (int32_t i = 0; i < height; ++i) {
+    for (int32_t j = 0; j < width; ++j) {
+      if (i % 7 == 3 || j % 11 == 5 || rnd() % 2 == 0) {
+        continue;
+      }
+      frame.texture.getPlane(0)(i, j) = static_cast<uint16_t>(rnd() % 1024);
+      frame.texture.getPlane(1)(i, j) = static_cast<uint16_t>(rnd() % 1024);
+      frame.texture.getPlane(2)(i, j) = static_cast<uint16_t>(rnd() % 1024);
+      frame.geometry.getPlane(0)(i, j) = static_cast<uint16_t>(1 + rnd() % 0xFFFF);
+    }
+  }
+  return frame;
+}
+
+auto inpaintedByNewInstance(RendererFrame frame, const ViewParams &viewParams) {
+  auto inpainter = TMIV::Renderer::Inpainter{{}, {}};
+  inpainter.inplaceInpaint(frame, viewParams);
+  return frame;
+}
+} // namespace
+} // namespace test
+
+TEST_CASE("Inpainter") {
+  SECTION("Inpainting fills all holes of a perspective viewport") {
+    auto frame = test::frameWithHoles(40, 24, 1);
+    auto inpainter = TMIV::Renderer::Inpainter{{}, {}};
+    inpainter.inplaceInpaint(frame, test::perspectiveViewport());
+
+    const auto &depth = frame.geometry.getPlane(0);
+    REQUIRE(std::none_of(depth.cbegin(), depth.cend(), [](auto x) { return x == 0; }));
+  }
+
+  SECTION("Buffers and mappings that are reused across frames give the same output") {
+    struct Step {
+      int32_t width;
+      int32_t height;
+      TMIV::MivBitstream::ViewParams viewParams;
+    };
+
+    // Switch between camera types, viewport sizes and ERP ranges, and repeat steps such that
+    // both the cached and the recomputed ERP-to-Cassini mapping are used
+    const auto steps = std::vector<Step>{
+        {64, 32, test::equirectangularViewport(360.F)},
+        {64, 32, test::equirectangularViewport(360.F)},
+        {64, 32, test::equirectangularViewport(180.F)},
+        {40, 24, test::perspectiveViewport()},
+        {48, 24, test::equirectangularViewport(180.F)},
+        {64, 32, test::equirectangularViewport(180.F)},
+        {40, 24, test::perspectiveViewport()},
+    };
+
+    auto inpainter = TMIV::Renderer::Inpainter{{}, {}};
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+      const auto &step = steps[i];
+      CAPTURE(i);
+
+      auto actual = test::frameWithHoles(step.width, step.height, static_cast<uint32_t>(i));
+      const auto reference = test::inpaintedByNewInstance(actual, step.viewParams);
+      inpainter.inplaceInpaint(actual, step.viewParams);
+
+      REQUIRE(actual.texture.getPlanes() == reference.texture.getPlanes());
+      REQUIRE(actual.geometry.getPlanes() == reference.geometry.getPlanes());
+    }
+  }
+}
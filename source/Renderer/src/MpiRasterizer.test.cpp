@@ -31,6 +31,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+//#define CATCH_CONFIG_ENABLE_BENCHMARKING // Uncomment me to run benchmarks
 #include <catch2/catch.hpp>
 
 #include <TMIV/Renderer/MpiRasterizer.h>
@@ -124,3 +125,64 @@ SCENARIO("MPI rastering meshes with Common::Vec2f as attribute", "[Rasterizer]")
     }
   }
 }
+
+namespace {
+// Square layer of the given size with an atlas position attribute, split in two triangles
+auto submitLayer(MpiRasterizer<Vec2f> &rasterizer, Vec2f offset, float size) {
+  const auto x1 = offset.x();
+  const auto y1 = offset.y();
+  const auto x2 = x1 + size;
+  const auto y2 = y1 + size;
+  ImageVertexDescriptorList vs{
+      {{x1, y1}, 0.F, 0.F}, {{x2, y1}, 0.F, 0.F}, {{x2, y2}, 0.F, 0.F}, {{x1, y2}, 0.F, 0.F}};
+  TriangleDescriptorList ts{{{0, 1, 2}, 0.F}, {{0, 2, 3}, 0.F}};
+  std::vector<Vec2f> as0{{0.F, 0.F}, {1.F, 0.F}, {1.F, 1.F}, {0.F, 1.F}};
+  rasterizer.submit(vs, std::tuple{as0}, ts);
+}
+} // namespace
+
+SCENARIO("MPI rastering layers that span multiple blocks", "[Rasterizer]") {
+  GIVEN("A new MPI rasterizer with a single strip") {
+    MpiRasterizer<Vec2f> rasterizer(Vec2i{40, 30}, 1);
+    Mat<int32_t> coverage({30, 40}, 0);
+
+    WHEN("Rastering an unaligned square layer") {
+      submitLayer(rasterizer, {3.5F, 2.25F}, 21.F);
+      rasterizer.run([&](const ViewportPosition2D &viewport, const std::array<float, 3> &weights,
+                         const std::array<PixelAttributes<Vec2f>, 3> & /* attributes */) {
+        REQUIRE(weights[0] + weights[1] + weights[2] == Approx(1.F));
+        ++coverage(viewport.y, viewport.x);
+      });
+
+      THEN("Each pixel center within the layer is covered exactly once") {
+        for (int32_t i = 0; i < 30; ++i) {
+          for (int32_t j = 0; j < 40; ++j) {
+            const auto inside = 3 <= j && j < 25 && 2 <= i && i < 23;
+            REQUIRE(coverage(i, j) == (inside ? 1 : 0));
+          }
+        }
+      }
+    }
+  }
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Benchmark: MPI layer throughput") {
+  const auto size = Vec2i{1920, 1080};
+  MpiRasterizer<Vec2f> rasterizer(size);
+  Mat<float> blended({1080, 1920}, 0.F);
+
+  BENCHMARK("100 layers of 1920x1080") {
+    for (int32_t layer = 0; layer < 100; ++layer) {
+      submitLayer(rasterizer, {0.F, 0.F}, 1920.F);
+    }
+    rasterizer.run([&](const ViewportPosition2D &viewport, const std::array<float, 3> &weights,
+                       const std::array<PixelAttributes<Vec2f>, 3> &attributes) {
+      blended(viewport.y, viewport.x) += weights[0] * std::get<0>(attributes[0]).x() +
+                                         weights[1] * std::get<0>(attributes[1]).x() +
+                                         weights[2] * std::get<0>(attributes[2]).x();
+    });
+    return blended(540, 960);
+  };
+}
+#endif
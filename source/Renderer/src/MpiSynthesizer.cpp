@@ -34,6 +34,7 @@
 #include <TMIV/Renderer/MpiSynthesizer.h>
 
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
+#include <TMIV/MivBitstream/PatchRenderTable.h>
 #include <TMIV/Renderer/MpiRasterizer.h>
 #include <TMIV/Renderer/reprojectPoints.h>
 
@@ -65,9 +66,9 @@ auto textureGather(const MAT &m, const std::array<Common::Vec2i, 4> &gc)
           m(gc[3].x(), gc[3].y())};
 }
 
-template <typename T>
-auto textureGather(const std::function<T(uint32_t, uint32_t)> &fun,
-                   const std::array<Common::Vec2i, 4> &gc) -> Common::stack::Vec4<T> {
+template <typename T, typename Fetch>
+auto textureGather(const Fetch &fun, const std::array<Common::Vec2i, 4> &gc)
+    -> Common::stack::Vec4<T> {
   return {fun(gc[0].x(), gc[0].y()), fun(gc[1].x(), gc[1].y()), fun(gc[2].x(), gc[2].y()),
           fun(gc[3].x(), gc[3].y())};
 }
@@ -329,22 +330,28 @@ private:
     const auto sourceHelperList = ProjectionHelperList{frame.viewParamsList};
     const auto targetHelper = ProjectionHelper{viewportParams};
 
+    std::vector<MivBitstream::PatchRenderTable> patchRenderTables;
+    patchRenderTables.reserve(frame.atlas.size());
+
+    for (const auto &atlas : frame.atlas) {
+      patchRenderTables.emplace_back(atlas.patchParamsList, frame.viewParamsList);
+    }
+
     for (const auto &block : m_blockBuffer) {
       // Initialization
       const auto &[atlas_id, patch_id, block_id, d] = block;
 
       const MivBitstream::AtlasAccessUnit &atlas = frame.atlas[atlas_id];
       const MivBitstream::PatchParams &patch = atlas.patchParamsList[patch_id];
-      const auto viewIdx = frame.viewParamsList.indexOf(patch.atlasPatchProjectionId());
-      const auto viewParams = frame.viewParamsList[viewIdx];
+      const auto &patches = patchRenderTables[atlas_id];
+      const auto viewIdx = patches.viewIdx[patch_id];
+      const auto &viewParams = frame.viewParamsList[viewIdx];
 
       // Block corners
       auto blockPerRow = getPatchPackingWidth(patch) / m_blockSize;
 
-      auto x_atlas_0 =
-          static_cast<int32_t>(patch.atlasPatch2dPosX()) + (block_id % blockPerRow) * m_blockSize;
-      auto y_atlas_0 =
-          static_cast<int32_t>(patch.atlasPatch2dPosY()) + (block_id / blockPerRow) * m_blockSize;
+      auto x_atlas_0 = patches.pos2dX[patch_id] + (block_id % blockPerRow) * m_blockSize;
+      auto y_atlas_0 = patches.pos2dY[patch_id] + (block_id / blockPerRow) * m_blockSize;
 
       const auto tl = Common::Vec2i{x_atlas_0, y_atlas_0};
       const auto tr = Common::Vec2i{x_atlas_0, y_atlas_0 + m_blockSize};
@@ -353,7 +360,7 @@ private:
 
       // Populate the vertices/attributes
       for (auto p : {tl, tr, br, bl}) {
-        auto uv = Common::Vec2f{Common::floatCast, patch.atlasToView(p)};
+        auto uv = Common::Vec2f{Common::floatCast, patches.atlasToView(patch_id, p)};
 
         // Handling correctly the seam for 360 degrees scenes
         if (shouldRepeat(viewParams)) {
@@ -478,7 +485,7 @@ MpiSynthesizer::MpiSynthesizer(float minAlpha) : m_impl(new Impl(minAlpha)) {}
 MpiSynthesizer::~MpiSynthesizer() = default;
 
 auto MpiSynthesizer::renderFrame(const MivBitstream::AccessUnit &frame,
-                                 const MivBitstream::CameraConfig &cameraConfig) const
+                                 const MivBitstream::CameraConfig &cameraConfig)
     -> Common::RendererFrame {
   return m_impl->renderFrame(frame, cameraConfig);
 }
@@ -84,7 +84,7 @@ auto pullFilter(const std::array<YUVD, 4> &v, const YUVD &x) -> YUVD {
 } // namespace
 
 void PushPullInpainter::inplaceInpaint(Common::RendererFrame &viewport,
-                                       const MivBitstream::ViewParams & /* metadata */) const {
+                                       const MivBitstream::ViewParams & /* metadata */) {
   auto pushPull = PushPull{};
   viewport = pushPull.filter(viewport, pushFilter, pullFilter);
 }
@@ -34,6 +34,7 @@
 #include <TMIV/Renderer/RecoverPrunedViews.h>
 
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
+#include <TMIV/MivBitstream/PatchRenderTable.h>
 
 #include <algorithm>
 
@@ -91,8 +92,8 @@ void initializePrunedViewComponent(const MivBitstream::AccessUnit &inFrame,
   }
 }
 
-auto blitPixel(const MivBitstream::AccessUnit &inFrame, Common::V3cFrameList &outFrame,
-               const MivBitstream::AtlasAccessUnit &atlas, int32_t i, int32_t j) {
+auto blitPixel(Common::V3cFrameList &outFrame, const MivBitstream::AtlasAccessUnit &atlas,
+               const MivBitstream::PatchRenderTable &patches, int32_t i, int32_t j) {
   // Fetch patch index
   const auto patchIdx = atlas.filteredPatchIdx(i, j);
   if (patchIdx == Common::unusedPatchIdx) {
@@ -100,13 +101,12 @@ auto blitPixel(const MivBitstream::AccessUnit &inFrame, Common::V3cFrameList &ou
   }
 
   // Index patch and view parameters
-  VERIFY(patchIdx < atlas.patchParamsList.size());
-  const auto &patchParams = atlas.patchParamsList[patchIdx];
-  const auto viewIdx = inFrame.viewParamsList.indexOf(patchParams.atlasPatchProjectionId());
+  VERIFY(patchIdx < patches.size());
+  const auto viewIdx = patches.viewIdx[patchIdx];
 
   // Test if this pixel is within the patch
-  if (j >= patchParams.atlasPatch2dPosX() + patchParams.atlasPatch2dSizeX() ||
-      i >= patchParams.atlasPatch2dPosY() + patchParams.atlasPatch2dSizeY()) {
+  if (j >= patches.pos2dX[patchIdx] + patches.size2dX[patchIdx] ||
+      i >= patches.pos2dY[patchIdx] + patches.size2dY[patchIdx]) {
     return;
   }
 
@@ -116,7 +116,7 @@ auto blitPixel(const MivBitstream::AccessUnit &inFrame, Common::V3cFrameList &ou
   }
 
   // Map to view position
-  const auto viewPos = patchParams.atlasToView({j, i});
+  const auto viewPos = patches.atlasToView(patchIdx, {j, i});
   const auto x = viewPos.x();
   const auto y = viewPos.y();
 
@@ -127,7 +127,7 @@ auto blitPixel(const MivBitstream::AccessUnit &inFrame, Common::V3cFrameList &ou
   if (atlas.asps.asps_miv_extension_present_flag() &&
       atlas.asps.asps_miv_extension().asme_patch_constant_depth_flag()) {
     outFrame[viewIdx].geometry.getPlane(0)(y, x) =
-        Common::assertDownCast<Common::DefaultElement>(patchParams.atlasPatch3dOffsetD());
+        Common::assertDownCast<Common::DefaultElement>(patches.offset3dD[patchIdx]);
   } else if (!atlas.geoFrame.empty()) {
     outFrame[viewIdx].geometry.getPlane(0)(y, x) = atlas.geoFrame.getPlane(0)(i, j);
   }
@@ -187,9 +187,12 @@ auto recoverPrunedViews(const MivBitstream::AccessUnit &inFrame) -> Common::V3cF
         VERIFY((atlas.asps.asps_frame_height() + blockSize - 1) / blockSize ==
                atlas.blockToPatchMap.getHeight());
 
+        const auto patches =
+            MivBitstream::PatchRenderTable{atlas.patchParamsList, inFrame.viewParamsList};
+
         for (int32_t i = 0; i < atlas.asps.asps_frame_height(); ++i) {
           for (int32_t j = 0; j < atlas.asps.asps_frame_width(); ++j) {
-            blitPixel(inFrame, outFrame, atlas, i, j);
+            blitPixel(outFrame, atlas, patches, i, j);
           }
         }
       });
@@ -31,6 +31,7 @@
  * THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+//#define CATCH_CONFIG_ENABLE_BENCHMARKING // Uncomment me to run benchmarks
 #include <catch2/catch.hpp>
 
 #include <TMIV/Renderer/RecoverPrunedViews.h>
@@ -44,6 +45,7 @@ using TMIV::Common::Frame;
 using TMIV::Common::unusedPatchIdx;
 using TMIV::MivBitstream::AccessUnit;
 using TMIV::MivBitstream::FlexiblePatchOrientation;
+using TMIV::MivBitstream::ViewId;
 using TMIV::Renderer::recoverPrunedViews;
 
 TEST_CASE("TMIV::Renderer::recoverPrunedViews") {
@@ -376,3 +378,70 @@ TEST_CASE("TMIV::Renderer::recoverPrunedViews") {
     }
   }
 }
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+TEST_CASE("Benchmark: recoverPrunedViews") {
+  static constexpr auto viewCount = 30;
+  static constexpr auto viewSize = 128;
+  static constexpr auto patchSize = 32;
+  static constexpr auto patchesPerView = viewSize / patchSize;
+  static constexpr auto atlasFrameWidth = 10 * viewSize;
+  static constexpr auto atlasFrameHeight = 3 * viewSize;
+  static constexpr auto log2BlockSize = 3;
+
+  // The view ID's are not contiguous to exercise the view ID index
+  auto frame = AccessUnit{};
+
+  for (int32_t v = 0; v < viewCount; ++v) {
+    auto &vp = frame.viewParamsList.emplace_back();
+    vp.viewId = ViewId{3 * v + 1};
+    vp.ci.ci_projection_plane_width_minus1(viewSize - 1)
+        .ci_projection_plane_height_minus1(viewSize - 1);
+  }
+  frame.viewParamsList.constructViewIdIndex();
+
+  auto &atlas = frame.atlas.emplace_back();
+
+  atlas.asps.asps_frame_width(atlasFrameWidth)
+      .asps_frame_height(atlasFrameHeight)
+      .asps_log2_patch_packing_block_size(log2BlockSize);
+
+  atlas.blockToPatchMap = Frame<>::lumaOnly(
+      {atlasFrameWidth >> log2BlockSize, atlasFrameHeight >> log2BlockSize});
+
+  for (int32_t v = 0; v < viewCount; ++v) {
+    for (int32_t n = 0; n < patchesPerView; ++n) {
+      for (int32_t m = 0; m < patchesPerView; ++m) {
+        const auto posX = (v % 10) * viewSize + m * patchSize;
+        const auto posY = (v / 10) * viewSize + n * patchSize;
+        const auto patchIdx = static_cast<DefaultElement>(atlas.patchParamsList.size());
+
+        atlas.patchParamsList.emplace_back()
+            .atlasPatchProjectionId(frame.viewParamsList[v].viewId)
+            .atlasPatchOrientationIndex(FlexiblePatchOrientation::FPO_NULL)
+            .atlasPatch2dPosX(posX)
+            .atlasPatch2dPosY(posY)
+            .atlasPatch2dSizeX(patchSize)
+            .atlasPatch2dSizeY(patchSize)
+            .atlasPatch3dOffsetU(m * patchSize)
+            .atlasPatch3dOffsetV(n * patchSize);
+
+        for (int32_t i = posY >> log2BlockSize; i < (posY + patchSize) >> log2BlockSize; ++i) {
+          for (int32_t j = posX >> log2BlockSize; j < (posX + patchSize) >> log2BlockSize; ++j) {
+            atlas.blockToPatchMap.getPlane(0)(i, j) = patchIdx;
+          }
+        }
+      }
+    }
+  }
+
+  atlas.occFrame = Frame<bool>::lumaOnly({atlasFrameWidth, atlasFrameHeight});
+  atlas.occFrame.fillOne();
+  atlas.geoFrame = Frame<>::lumaOnly({atlasFrameWidth, atlasFrameHeight}, 10);
+  atlas.texFrame = Frame<>::yuv444({atlasFrameWidth, atlasFrameHeight}, 10);
+
+  BENCHMARK("30 views of 128x128 in 480 patches") {
+    return recoverPrunedViews(frame).size();
+  };
+}
+#endif
@@ -42,7 +42,7 @@ Renderer::Renderer(const Common::Json &rootNode, const Common::Json &componentNo
                                                                        rootNode, componentNode)} {}
 
 auto Renderer::renderFrame(const MivBitstream::AccessUnit &frame,
-                           const MivBitstream::CameraConfig &cameraConfig) const
+                           const MivBitstream::CameraConfig &cameraConfig)
     -> Common::RendererFrame {
   auto viewport = m_synthesizer->renderFrame(frame, cameraConfig);
 
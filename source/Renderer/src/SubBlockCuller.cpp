@@ -39,6 +39,9 @@
 #include "TMIV/Renderer/Engine.h"
 #include <TMIV/Renderer/reprojectPoints.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace TMIV::Renderer {
 SubBlockCuller::SubBlockCuller(const Common::Json & /*rootNode*/,
                                const Common::Json & /*componentNode*/) {}
@@ -53,7 +56,6 @@ auto choosePatch(const MivBitstream::PatchParams &patch,
   const auto R_t = AffineTransform(cameras[patch.atlasPatchProjectionId()].pose, target.pose);
 
   auto uv = std::array<Common::Vec2f, 4>{};
-  auto xy_v = std::array<Common::Vec2f, 8>{};
   const auto w = static_cast<float>(patch.atlasPatch3dSizeU());
   const auto h = static_cast<float>(patch.atlasPatch3dSizeV());
   uv[0].x() = static_cast<float>(patch.atlasPatch3dOffsetU());
@@ -85,30 +87,62 @@ auto choosePatch(const MivBitstream::PatchParams &patch,
                                                      modified_depth_z * modified_depth_z));
   }
 
+  auto corners = std::array<Common::Vec3f, 8>{};
+
   for (int32_t i = 0; i < 4; i++) {
-    const auto xyz = R_t(unprojectVertex(Common::at(uv, i), patch_dep_near, camera.ci));
-    const auto rayAngle = Common::angle(xyz, xyz - R_t.translation());
-    SceneVertexDescriptor v;
-    v.position = xyz;
-    v.rayAngle = rayAngle;
-    auto pix = target.ci.dispatch([&](auto camType) {
-      Engine<camType> engine{target.ci};
-      return engine.projectVertex(v);
-    });
-    Common::at(xy_v, i) = pix.position;
+    Common::at(corners, i) = R_t(unprojectVertex(Common::at(uv, i), patch_dep_near, camera.ci));
+    Common::at(corners, i + 4) =
+        R_t(unprojectVertex(Common::at(uv, i), patch_dep_far_mod, camera.ci));
   }
 
-  for (int32_t i = 0; i < 4; i++) {
-    const auto xyz = R_t(unprojectVertex(Common::at(uv, i), patch_dep_far_mod, camera.ci));
-    const auto rayAngle = Common::angle(xyz, xyz - R_t.translation());
+  const auto project = [&](const Common::Vec3f &xyz) {
     SceneVertexDescriptor v;
     v.position = xyz;
-    v.rayAngle = rayAngle;
+    v.rayAngle = Common::angle(xyz, xyz - R_t.translation());
     auto pix = target.ci.dispatch([&](auto camType) {
       Engine<camType> engine{target.ci};
       return engine.projectVertex(v);
     });
-    at(xy_v, i + 4) = pix.position;
+    return pix.position;
+  };
+  const auto isFinite = [](const Common::Vec2f &p) {
+    return std::isfinite(p.x()) && std::isfinite(p.y());
+  };
+
+  auto xy_v = std::vector<Common::Vec2f>(corners.size());
+  std::transform(corners.cbegin(), corners.cend(), xy_v.begin(), project);
+
+  // Corners behind the camera plane of a perspective target view cannot be projected. Clip the
+  // block against a plane just in front of the camera instead: the corners in front of it and the
+  // points where the lines between corners cross it bound the part of the block that may be
+  // visible.
+  if (!std::all_of(xy_v.cbegin(), xy_v.cend(), isFinite)) {
+    if (target.ci.ci_cam_type() != MivBitstream::CiCamType::perspective) {
+      return true;
+    }
+    static constexpr auto nearPlane = 1e-3F;
+    xy_v.clear();
+
+    for (size_t i = 0; i < corners.size(); ++i) {
+      const auto &a = corners[i];
+
+      if (nearPlane < a.x()) {
+        xy_v.push_back(project(a));
+      }
+      for (size_t j = i + 1; j < corners.size(); ++j) {
+        const auto &b = corners[j];
+
+        if ((nearPlane < a.x()) != (nearPlane < b.x())) {
+          xy_v.push_back(project(a + (nearPlane - a.x()) / (b.x() - a.x()) * (b - a)));
+        }
+      }
+    }
+    if (xy_v.empty()) {
+      return false; // The block is entirely behind the camera
+    }
+    if (!std::all_of(xy_v.cbegin(), xy_v.cend(), isFinite)) {
+      return true;
+    }
   }
 
   float xy_v_xmax = -1000;
@@ -163,6 +197,8 @@ auto divideInBlocks(const MivBitstream::PatchParams &patch) {
                    MivBitstream::FlexiblePatchOrientation::FPO_NULL);
       b.atlasPatch3dOffsetU(b.atlasPatch3dOffsetU() + x1);
       b.atlasPatch3dOffsetV(b.atlasPatch3dOffsetV() + y1);
+      b.atlasPatch3dSizeU(x2 - x1);
+      b.atlasPatch3dSizeV(y2 - y1);
     }
   }
   return subblock;
@@ -176,10 +212,9 @@ auto SubBlockCuller::filterBlockToPatchMap(const MivBitstream::AccessUnit &frame
 
   for (size_t patchIdx = 0; patchIdx < atlas.patchParamsList.size(); ++patchIdx) {
     const auto &patch = atlas.patchParamsList[patchIdx];
-    const auto &view = frame.viewParamsList[patch.atlasPatchProjectionId()];
 
-    if ((patch.atlasPatch3dSizeU() == view.ci.ci_projection_plane_width_minus1() + 1 ||
-         patch.atlasPatch3dSizeV() == view.ci.ci_projection_plane_height_minus1() + 1) &&
+    // Cull per block within any patch for which atlas and view coordinates align
+    if (patch.atlasPatchLoDScaleX() == 1 && patch.atlasPatchLoDScaleY() == 1 &&
         (patch.atlasPatchOrientationIndex() == MivBitstream::FlexiblePatchOrientation::FPO_NULL)) {
       for (const auto &block : divideInBlocks(patch)) {
         if (!choosePatch(block, frame.viewParamsList, viewportParams,
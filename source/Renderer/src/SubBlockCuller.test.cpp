@@ -0,0 +1,142 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Renderer/SubBlockCuller.h>
+
+using TMIV::Common::Json;
+using TMIV::MivBitstream::AccessUnit;
+using TMIV::MivBitstream::CiCamType;
+using TMIV::MivBitstream::ViewParams;
+using TMIV::Renderer::SubBlockCuller;
+
+using namespace std::string_view_literals;
+
+namespace {
+auto perspectiveView() -> ViewParams {
+  auto vp = ViewParams{};
+  vp.ci.ci_cam_type(CiCamType::perspective)
+      .ci_projection_plane_width_minus1(255)
+      .ci_projection_plane_height_minus1(255)
+      .ci_perspective_focal_hor(128.F)
+      .ci_perspective_focal_ver(128.F)
+      .ci_perspective_center_hor(128.F)
+      .ci_perspective_center_ver(128.F);
+  vp.dq.dq_norm_disp_low(0.1F).dq_norm_disp_high(1.F);
+  return vp;
+}
+
+// A single 256 x 256 atlas with one patch that covers the entire source view
+auto singlePatchFrame() -> AccessUnit {
+  auto frame = AccessUnit{};
+  frame.viewParamsList.push_back(perspectiveView());
+  frame.viewParamsList.constructViewIdIndex();
+
+  auto &atlas = frame.atlas.emplace_back();
+  atlas.asps.asps_frame_width(256).asps_frame_height(256).asps_log2_patch_packing_block_size(4);
+  atlas.geoFrame = TMIV::Common::Frame<>::lumaOnly({256, 256}, 10);
+
+  auto &patch = atlas.patchParamsList.emplace_back();
+  patch.atlasPatch2dSizeX(256).atlasPatch2dSizeY(256);
+  patch.atlasPatch3dSizeU(256).atlasPatch3dSizeV(256);
+  patch.atlasPatch3dRangeD(1023);
+  patch.atlasPatchOrientationIndex(TMIV::MivBitstream::FlexiblePatchOrientation::FPO_NULL);
+
+  atlas.blockToPatchMap = TMIV::Common::Frame<TMIV::Common::PatchIdx>::lumaOnly({16, 16});
+  atlas.blockToPatchMap.fillValue(0);
+  atlas.pixelToPatchMap = TMIV::Common::Frame<TMIV::Common::PatchIdx>::lumaOnly({256, 256});
+  atlas.pixelToPatchMap.fillValue(0);
+  return frame;
+}
+
+auto usedSamples(const TMIV::Common::Frame<TMIV::Common::PatchIdx> &map) {
+  return std::count_if(map.getPlane(0).cbegin(), map.getPlane(0).cend(),
+                       [](auto x) { return x != TMIV::Common::unusedPatchIdx; });
+}
+} // namespace
+
+TEST_CASE("TMIV::Renderer::SubBlockCuller") {
+  const auto unit = SubBlockCuller{Json::parse("{}"sv), Json::parse("{}"sv)};
+  auto frame = singlePatchFrame();
+  auto viewport = perspectiveView();
+
+  SECTION("Nothing is culled when the viewport is the source view") {
+    REQUIRE(unit.inplaceFilterBlockToPatchMaps(frame, viewport) == 0);
+    CHECK(usedSamples(frame.atlas.front().blockToPatchMap) == 16 * 16);
+    CHECK(usedSamples(frame.atlas.front().pixelToPatchMap) == 256 * 256);
+  }
+
+  SECTION("Everything is culled when the viewport looks the other way") {
+    viewport.pose.orientation =
+        TMIV::Common::euler2quat(TMIV::Common::Vec3d{TMIV::Common::pi<double>, 0., 0.});
+
+    REQUIRE(unit.inplaceFilterBlockToPatchMaps(frame, viewport) == 256 * 256);
+    CHECK(usedSamples(frame.atlas.front().blockToPatchMap) == 0);
+    CHECK(usedSamples(frame.atlas.front().pixelToPatchMap) == 0);
+  }
+
+  SECTION("Blocks that cross the camera plane of the viewport are clipped to it") {
+    // All blocks cross the camera plane and their corners in front of it project to the left of
+    // the viewport. Part of the left blocks is visible, but nothing of the right blocks.
+    viewport.pose.position = {6.F, 4.F, 0.F};
+    viewport.pose.orientation =
+        TMIV::Common::euler2quat(TMIV::Common::Vec3d{TMIV::Common::deg2rad(150.), 0., 0.});
+
+    REQUIRE(unit.inplaceFilterBlockToPatchMaps(frame, viewport) == 2 * 128 * 128);
+
+    const auto &blockToPatchMap = frame.atlas.front().blockToPatchMap.getPlane(0);
+    CHECK(blockToPatchMap(0, 0) == 0);
+    CHECK(blockToPatchMap(15, 7) == 0);
+    CHECK(blockToPatchMap(0, 8) == TMIV::Common::unusedPatchIdx);
+    CHECK(blockToPatchMap(15, 15) == TMIV::Common::unusedPatchIdx);
+  }
+
+  SECTION("Blocks of a partially visible patch are culled and the pixel map follows") {
+    viewport.pose.orientation = TMIV::Common::euler2quat(TMIV::Common::Vec3d{1.2, 0., 0.});
+
+    const auto culledSamples = unit.inplaceFilterBlockToPatchMaps(frame, viewport);
+    CHECK(0 < culledSamples);
+    CHECK(culledSamples < 256 * 256);
+
+    const auto &atlas = frame.atlas.front();
+    CHECK(usedSamples(atlas.pixelToPatchMap) == 256 * 256 - static_cast<int64_t>(culledSamples));
+    CHECK(usedSamples(atlas.pixelToPatchMap) == 16 * 16 * usedSamples(atlas.blockToPatchMap));
+
+    for (int32_t y = 0; y < 256; ++y) {
+      for (int32_t x = 0; x < 256; ++x) {
+        REQUIRE(atlas.pixelToPatchMap.getPlane(0)(y, x) == atlas.patchIdx(y, x));
+      }
+    }
+  }
+}
@@ -39,6 +39,7 @@
 #include <TMIV/Common/Thread.h>
 #include <TMIV/Common/verify.h>
 #include <TMIV/MivBitstream/DepthOccupancyTransform.h>
+#include <TMIV/MivBitstream/PatchRenderTable.h>
 #include <TMIV/Renderer/RecoverPrunedViews.h>
 #include <TMIV/Renderer/reprojectPoints.h>
 
@@ -494,7 +495,19 @@ private:
       x += step;
     }
 
+    // Project in chunks, such that views that are visible stop at the first chunk with a visible
+    // point
+    static constexpr auto chunkSize = size_t{8};
+    auto chunks = std::vector<PointCloud>{};
+
+    for (size_t first = 0; first < pointCloud.size(); first += chunkSize) {
+      const auto last = std::min(first + chunkSize, pointCloud.size());
+      chunks.emplace_back(pointCloud.cbegin() + static_cast<ptrdiff_t>(first),
+                          pointCloud.cbegin() + static_cast<ptrdiff_t>(last));
+    }
+
     m_cameraVisibility.clear();
+    auto projection = ImagePointBatch{};
 
     for (size_t viewIdx = 0; viewIdx < sourceHelperList.size(); viewIdx++) {
       if (isViewInpainted(viewIdx)) {
@@ -504,18 +517,18 @@ private:
       }
 
       const auto &helper = sourceHelperList[viewIdx];
-      auto K = 0U;
+      auto visible = false;
 
-      for (const Common::Vec3f &P : pointCloud) {
-        const auto p = helper.doProjection(P);
+      for (auto chunk = chunks.cbegin(); !visible && chunk != chunks.cend(); ++chunk) {
+        helper.doProjection(*chunk, projection);
 
-        if (isValidDepth(p.second) && helper.isInsideViewport(p.first)) {
-          K++;
-          break;
+        for (size_t i = 0; !visible && i < projection.size(); ++i) {
+          visible = isValidDepth(projection.depth[i]) &&
+                    helper.isInsideViewport({projection.u[i], projection.v[i]});
         }
       }
 
-      m_cameraVisibility.emplace_back(0 < K);
+      m_cameraVisibility.emplace_back(visible);
     }
   }
 
@@ -593,6 +606,9 @@ private:
         continue;
       }
 
+      const auto patches =
+          MivBitstream::PatchRenderTable{atlas.patchParamsList, frame.viewParamsList};
+
       Common::parallel_for(
           atlas.asps.asps_frame_width(), atlas.asps.asps_frame_height(), [&](size_t Y, size_t X) {
             const auto patchIdx =
@@ -601,15 +617,14 @@ private:
               return;
             }
 
-            const auto &patchParams = atlas.patchParamsList[patchIdx];
-            const auto viewIdx = frame.viewParamsList.indexOf(patchParams.atlasPatchProjectionId());
+            const auto viewIdx = patches.viewIdx[patchIdx];
 
             if (!m_cameraVisibility[viewIdx]) {
               return;
             }
 
             const auto sourceViewPos =
-                patchParams.atlasToView({static_cast<int32_t>(X), static_cast<int32_t>(Y)});
+                patches.atlasToView(patchIdx, {static_cast<int32_t>(X), static_cast<int32_t>(Y)});
             const auto x = sourceViewPos.x();
             const auto y = sourceViewPos.y();
 
@@ -1261,7 +1276,7 @@ ViewWeightingSynthesizer::ViewWeightingSynthesizer(const Common::Json & /*rootNo
 ViewWeightingSynthesizer::~ViewWeightingSynthesizer() = default;
 
 auto ViewWeightingSynthesizer::renderFrame(const MivBitstream::AccessUnit &frame,
-                                           const MivBitstream::CameraConfig &cameraConfig) const
+                                           const MivBitstream::CameraConfig &cameraConfig)
     -> Common::RendererFrame {
   return m_impl->renderFrame(frame, cameraConfig);
 }
@@ -34,9 +34,14 @@
 #include <TMIV/Renderer/ViewingSpaceController.h>
 
 #include <TMIV/Common/LoggingStrategyFmt.h>
+#include <TMIV/Common/Thread.h>
+#include <TMIV/Common/verify.h>
 #include <TMIV/ViewingSpace/ViewingSpaceEvaluator.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <optional>
 
 namespace TMIV::Renderer {
 namespace {
@@ -52,78 +57,99 @@ auto computeIndex(const MivBitstream::ViewParams &metadata, const MivBitstream::
   return index;
 }
 
-void inplaceFading_impl(Common::RendererFrame &yuvd, const MivBitstream::ViewParams & /* unused */,
-                        float index) {
-  // TO DO
+// RGB to/from YUV conversion coefficients
+constexpr auto YUVtoR = std::array{1.164F, 0.F, 1.596F};
+constexpr auto YUVtoG = std::array{1.164F, -0.392F, -0.813F};
+constexpr auto YUVtoB = std::array{1.164F, 2.017F, 0.F};
+constexpr auto RGBtoY = std::array{0.257F, 0.504F, 0.098F};
+constexpr auto RGBtoU = std::array{-0.148F, -0.291F, 0.439F};
+constexpr auto RGBtoV = std::array{0.439F, -0.368F, -0.071F};
+constexpr auto Cte = std::array{64.F, 512.F, 512.F};
+
+// YUV clamping :
+//   over  8 bits : Y is in range [16, 235], UV is in range [16, 240]
+//   over 10 bits : Y is in range [64, 940], UV is in range [64, 960]
+// https://stackoverflow.com/questions/25804565/accurate-yuv-10-bits-to-8-bits-conversion
+constexpr auto minYUV = 64.F;
+constexpr auto maxY = 940.F;
+constexpr auto maxUV = 960.F;
+
+// 1) get RGB from YUV, 2) then greyish it, 3) then back to YUV
+//
+// The loop body is branch-free and works on contiguous rows of the integer planes such that the
+// compiler is able to vectorize it. The outputs are clamped, thus the casts cannot overflow.
+void fadeRow(uint16_t *Y, uint16_t *U, uint16_t *V, size_t count, float weight,
+             float maxValueF) {
+  for (size_t i = 0; i < count; ++i) {
+    const auto Y_i = static_cast<float>(Y[i]) - Cte[0];
+    const auto U_i = static_cast<float>(U[i]) - Cte[1];
+    const auto V_i = static_cast<float>(V[i]) - Cte[2];
+
+    const auto R =
+        std::min(std::max(Y_i * YUVtoR[0] + U_i * YUVtoR[1] + V_i * YUVtoR[2], 0.F), maxValueF) *
+        weight;
+    const auto G =
+        std::min(std::max(Y_i * YUVtoG[0] + U_i * YUVtoG[1] + V_i * YUVtoG[2], 0.F), maxValueF) *
+        weight;
+    const auto B =
+        std::min(std::max(Y_i * YUVtoB[0] + U_i * YUVtoB[1] + V_i * YUVtoB[2], 0.F), maxValueF) *
+        weight;
+
+    Y[i] = static_cast<uint16_t>(
+        std::min(std::max(R * RGBtoY[0] + G * RGBtoY[1] + B * RGBtoY[2] + Cte[0], minYUV), maxY));
+    U[i] = static_cast<uint16_t>(
+        std::min(std::max(R * RGBtoU[0] + G * RGBtoU[1] + B * RGBtoU[2] + Cte[1], minYUV), maxUV));
+    V[i] = static_cast<uint16_t>(
+        std::min(std::max(R * RGBtoV[0] + G * RGBtoV[1] + B * RGBtoV[2] + Cte[2], minYUV), maxUV));
+  }
+}
+
+void inplaceFading_impl(Common::RendererFrame &yuvd, float index) {
   auto &Y = yuvd.texture.getPlane(0);
   auto &U = yuvd.texture.getPlane(1);
   auto &V = yuvd.texture.getPlane(2);
   const auto maxValueF = static_cast<float>(yuvd.texture.maxValue());
 
-  const auto width_Y = static_cast<int32_t>(Y.width());
-  const auto height_Y = static_cast<int32_t>(Y.height());
-
-  float weight = index; // for test:just a recopy of the index ==> mapping might be changed
-  float R = 0.F;
-  float G = 0.F;
-  float B = 0.F;
-
-  // RGB to/from YUV conversion coefficients
-  Common::Vec3f YUVtoR({1.164F, 0.F, 1.596F});
-  Common::Vec3f YUVtoG({1.164F, -0.392F, -0.813F});
-  Common::Vec3f YUVtoB({1.164F, 2.017F, 0.F});
-  Common::Vec3f RGBtoY({0.257F, 0.504F, 0.098F});
-  Common::Vec3f RGBtoU({-0.148F, -0.291F, 0.439F});
-  Common::Vec3f RGBtoV({0.439F, -0.368F, -0.071F});
-  Common::Vec3f Cte({64.F, 512.F, 512.F});
-
-  // YUV clamping :
-  //   over  8 bits : Y is in range [16, 235], UV is in range [16, 240]
-  //   over 10 bits : Y is in range [64, 940], UV is in range [64, 960]
-  // https://stackoverflow.com/questions/25804565/accurate-yuv-10-bits-to-8-bits-conversion
-
-  // 1) get RGB from YUV, 2) then greyish it, 3) then back to YUV
-  for (int32_t h = 0; h < height_Y; h++) {
-    for (int32_t w = 0; w < width_Y; w++) {
-      const auto Y_h_w = static_cast<float>(Y(h, w));
-      const auto U_h_w = static_cast<float>(U(h, w));
-      const auto V_h_w = static_cast<float>(V(h, w));
-
-      R = std::min(std::max((Y_h_w - Cte[0]) * YUVtoR[0] + (U_h_w - Cte[1]) * YUVtoR[1] +
-                                (V_h_w - Cte[2]) * YUVtoR[2],
-                            0.F),
-                   maxValueF) *
-          weight;
-      G = std::min(std::max((Y_h_w - Cte[0]) * YUVtoG[0] + (U_h_w - Cte[1]) * YUVtoG[1] +
-                                (V_h_w - Cte[2]) * YUVtoG[2],
-                            0.F),
-                   maxValueF) *
-          weight;
-      B = std::min(std::max((Y_h_w - Cte[0]) * YUVtoB[0] + (U_h_w - Cte[1]) * YUVtoB[1] +
-                                (V_h_w - Cte[2]) * YUVtoB[2],
-                            0.F),
-                   maxValueF) *
-          weight;
-
-      Y(h, w) = Common::assertDownCast<uint16_t>(
-          std::min(std::max(R * RGBtoY[0] + G * RGBtoY[1] + B * RGBtoY[2] + Cte[0], 64.F), 940.F));
-      U(h, w) = Common::assertDownCast<uint16_t>(
-          std::min(std::max(R * RGBtoU[0] + G * RGBtoU[1] + B * RGBtoU[2] + Cte[1], 64.F), 960.F));
-      V(h, w) = Common::assertDownCast<uint16_t>(
-          std::min(std::max(R * RGBtoV[0] + G * RGBtoV[1] + B * RGBtoV[2] + Cte[2], 64.F), 960.F));
+  PRECONDITION(U.sizes() == Y.sizes() && V.sizes() == Y.sizes());
+
+  const float weight = index; // for test:just a recopy of the index ==> mapping might be changed
+
+  Common::parallel_for(Y.height(), [&](size_t h) {
+    fadeRow(&Y(h, 0), &U(h, 0), &V(h, 0), Y.width(), weight, maxValueF);
+  });
+}
+} // namespace
+
+class ViewingSpaceController::Impl {
+public:
+  // The inclusion index only depends on the viewport pose and the viewing space, which in
+  // practice change less often than once per frame
+  auto inclusionIndex(const MivBitstream::ViewParams &viewportParams,
+                      const MivBitstream::ViewingSpace &viewingSpace) -> float {
+    if (!m_index || m_pose != viewportParams.pose || m_viewingSpace != viewingSpace) {
+      m_index = computeIndex(viewportParams, viewingSpace);
+      m_pose = viewportParams.pose;
+      m_viewingSpace = viewingSpace;
     }
+    return *m_index;
   }
-}
 
-} // namespace
+private:
+  std::optional<float> m_index;
+  MivBitstream::Pose m_pose;
+  MivBitstream::ViewingSpace m_viewingSpace;
+};
 
 ViewingSpaceController::ViewingSpaceController(const Common::Json & /*rootNode*/,
-                                               const Common::Json & /*componentNode*/) {}
+                                               const Common::Json & /*componentNode*/)
+    : m_impl{std::make_unique<Impl>()} {}
+
+ViewingSpaceController::~ViewingSpaceController() = default;
 
 void ViewingSpaceController::inplaceFading(Common::RendererFrame &viewport,
                                            const MivBitstream::ViewParams &viewportParams,
-                                           const MivBitstream::ViewingSpace &viewingSpace) const {
-  inplaceFading_impl(viewport, viewportParams, computeIndex(viewportParams, viewingSpace));
+                                           const MivBitstream::ViewingSpace &viewingSpace) {
+  inplaceFading_impl(viewport, m_impl->inclusionIndex(viewportParams, viewingSpace));
 }
 
 } // namespace TMIV::Renderer
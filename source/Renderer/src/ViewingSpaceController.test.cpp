@@ -0,0 +1,119 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <catch2/catch.hpp>
+
+#include <TMIV/Renderer/ViewingSpaceController.h>
+
+#include <random>
+
+namespace test {
+namespace {
+using TMIV::Common::Frame;
+using TMIV::Common::RendererFrame;
+using TMIV::MivBitstream::ElementaryShape;
+using TMIV::MivBitstream::ElementaryShapeOperation;
+using TMIV::MivBitstream::PrimitiveShape;
+using TMIV::MivBitstream::ViewingSpace;
+using TMIV::MivBitstream::ViewParams;
+
+auto cuboidViewingSpace(float size) {
+  const auto cuboid =
+      PrimitiveShape{TMIV::MivBitstream::Cuboid{{0.F, 0.F, 0.F}, {size, size, size}}, 1.F, {}, {}};
+  return ViewingSpace{{{ElementaryShapeOperation::add, ElementaryShape{{cuboid}}}}};
+}
+
+auto viewportAt(TMIV::Common::Vec3f position) {
+  auto viewParams = ViewParams{};
+  viewParams.pose.position = position;
+  return viewParams;
+}
+
+auto randomFrame(uint32_t seed) {
+  auto frame = RendererFrame{Frame<>::yuv444({16, 8}, 10), Frame<>::lumaOnly({16, 8}, 16)};
+  auto rnd = std::mt19937{seed};
+
+  for (auto &plane : frame.texture.getPlanes()) {
+    std::generate(plane.begin(), plane.end(), [&rnd]() { return 64 + rnd() % 897; });
+  }
+  return frame;
+}
+} // namespace
+} // namespace test
+
+TEST_CASE("ViewingSpaceController") {
+  SECTION("A viewport that is far out of the viewing space is faded out") {
+    auto frame = test::randomFrame(1);
+    auto controller = TMIV::Renderer::ViewingSpaceController{{}, {}};
+    controller.inplaceFading(frame, test::viewportAt({10.F, 0.F, 0.F}),
+                             test::cuboidViewingSpace(1.F));
+
+    const auto &Y = frame.texture.getPlane(0);
+    const auto &U = frame.texture.getPlane(1);
+    REQUIRE(std::all_of(Y.cbegin(), Y.cend(), [](auto x) { return x == 64; }));
+    REQUIRE(std::all_of(U.cbegin(), U.cend(), [](auto x) { return x == 512; }));
+  }
+
+  SECTION("The cached inclusion index gives the same output as a new controller") {
+    struct Step {
+      TMIV::Common::Vec3f position;
+      float size;
+    };
+
+    // Repeat poses and viewing spaces, such that the cached inclusion index is used, and change
+    // either of them, such that it has to be recomputed
+    const auto steps = std::vector<Step>{
+        {{0.F, 0.F, 0.F}, 2.F},   {{0.F, 0.F, 0.F}, 2.F}, {{1.2F, 0.F, 0.F}, 2.F},
+        {{1.2F, 0.F, 0.F}, 2.F},  {{1.2F, 0.F, 0.F}, 3.F}, {{0.F, 0.F, 0.F}, 3.F},
+        {{0.F, 1.1F, 0.F}, 2.F},
+    };
+
+    auto controller = TMIV::Renderer::ViewingSpaceController{{}, {}};
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+      const auto &step = steps[i];
+      CAPTURE(i);
+
+      const auto viewportParams = test::viewportAt(step.position);
+      const auto viewingSpace = test::cuboidViewingSpace(step.size);
+
+      auto actual = test::randomFrame(static_cast<uint32_t>(i));
+      auto reference = actual;
+      TMIV::Renderer::ViewingSpaceController{{}, {}}.inplaceFading(reference, viewportParams,
+                                                                    viewingSpace);
+      controller.inplaceFading(actual, viewportParams, viewingSpace);
+
+      REQUIRE(actual.texture.getPlanes() == reference.texture.getPlanes());
+    }
+  }
+}
@@ -112,6 +112,32 @@ auto ProjectionHelper::doUnprojection(const Common::Vec2f &p, float d) const ->
   return rotate(P, m_rotation) + m_viewParams.get().pose.position;
 }
 
+void ProjectionHelper::doProjection(const PointCloud &P, ImagePointBatch &p) const {
+  auto Q = ScenePointBatch{};
+  Q.resize(P.size());
+
+  for (size_t i = 0; i < P.size(); ++i) {
+    const auto Q_i = changeFrame(P[i]);
+    Q.x[i] = Q_i.x();
+    Q.y[i] = Q_i.y();
+    Q.z[i] = Q_i.z();
+  }
+
+  m_engine->projectBatch(Q, p);
+}
+
+void ProjectionHelper::doUnprojection(const ImagePointBatch &p, PointCloud &P) const {
+  auto Q = ScenePointBatch{};
+  m_engine->unprojectBatch(p, Q);
+
+  P.resize(p.size());
+
+  for (size_t i = 0; i < P.size(); ++i) {
+    P[i] = rotate(Common::Vec3f{Q.x[i], Q.y[i], Q.z[i]}, m_rotation) +
+           m_viewParams.get().pose.position;
+  }
+}
+
 auto ProjectionHelper::isStrictlyInsideViewport(const Common::Vec2f &p) const -> bool {
   return 0.5F <= p.x() && p.x() <= (m_viewParams.get().ci.projectionPlaneSizeF().x() - 0.5F) &&
          0.5F <= p.y() && p.y() <= (m_viewParams.get().ci.projectionPlaneSizeF().y() - 0.5F);
@@ -193,12 +219,14 @@ auto ProjectionHelper::getRadialRange() const -> Common::Vec2f {
 }
 
 auto ProjectionHelper::getPointCloud(uint32_t N) const -> PointCloud {
-  PointCloud pointCloud;
+  auto imagePoints = ImagePointBatch{};
+  imagePoints.resize(size_t{N} * N * N);
 
   float step = 1.F / static_cast<float>(N - 1U);
   auto depthRange = getDepthRange();
 
   float x = 0.F;
+  size_t index = 0;
 
   for (uint32_t i = 0U; i < N; i++) {
     float y = 0.F;
@@ -211,7 +239,10 @@ auto ProjectionHelper::getPointCloud(uint32_t N) const -> PointCloud {
       float py = y * m_viewParams.get().ci.projectionPlaneSizeF().y();
 
       for (uint32_t k = 0U; k < N; k++) {
-        pointCloud.emplace_back(doUnprojection({px, py}, d));
+        imagePoints.u[index] = px;
+        imagePoints.v[index] = py;
+        imagePoints.depth[index] = d;
+        ++index;
 
         d += step * (depthRange.y() - depthRange.x());
       }
@@ -222,6 +253,8 @@ auto ProjectionHelper::getPointCloud(uint32_t N) const -> PointCloud {
     x += step;
   }
 
+  PointCloud pointCloud;
+  doUnprojection(imagePoints, pointCloud);
   return pointCloud;
 }
 
@@ -243,10 +276,11 @@ auto getOverlapping(const ProjectionHelperList &sourceHelperList,
   const ProjectionHelper &secondHelper = sourceHelperList[secondId];
   const PointCloud &firstPointCloud = pointCloudList[firstId];
 
-  for (const auto &P : firstPointCloud) {
-    auto p = secondHelper.doProjection(P);
+  auto p = ImagePointBatch{};
+  secondHelper.doProjection(firstPointCloud, p);
 
-    if (isValidDepth(p.second) && secondHelper.isInsideViewport(p.first)) {
+  for (size_t i = 0; i < p.size(); ++i) {
+    if (isValidDepth(p.depth[i]) && secondHelper.isInsideViewport({p.u[i], p.v[i]})) {
       N++;
     }
   }
@@ -0,0 +1,79 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2022, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TMIV_VIDEODECODER_COPYPLANE_H
+#define TMIV_VIDEODECODER_COPYPLANE_H
+
+#include <TMIV/Common/Frame.h>
+#include <TMIV/Common/verify.h>
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace TMIV::VideoDecoder {
+// Copy a plane of a decoded picture into a frame plane of the same size. The stride of the input
+// plane is in samples.
+//
+// Decoded sample values are within the bit depth of the picture. The bit depth is checked once per
+// plane, such that every sample can then be converted without a range check. Rows of 16-bit
+// samples are copied with memcpy, because they have the same representation. Other sample types
+// are converted element-wise in a loop without dependencies, which the compiler vectorizes.
+template <typename Sample>
+void copyPlane(const Sample *row, std::ptrdiff_t stride, uint32_t bitDepth,
+               Common::Mat<> &outPlane) {
+  static_assert(std::is_integral_v<Sample>);
+  PRECONDITION(0 < bitDepth && bitDepth <= Common::sampleBitDepth);
+
+  const auto width = outPlane.width();
+  auto *outRow = outPlane.data();
+
+  for (size_t i = 0; i < outPlane.height(); ++i) {
+    if constexpr (sizeof(Sample) == sizeof(Common::DefaultElement)) {
+      std::memcpy(outRow, row, width * sizeof(Sample));
+    } else {
+      for (size_t j = 0; j < width; ++j) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        outRow[j] = static_cast<Common::DefaultElement>(row[j]);
+      }
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    outRow += width;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    row += stride;
+  }
+}
+} // namespace TMIV::VideoDecoder
+
+#endif
@@ -33,8 +33,11 @@
 
 #include <TMIV/VideoDecoder/VideoDecoder.h>
 
+#include "../CopyPlane.h"
+
 #include <TMIV/Common/Decoder.h>
 #include <TMIV/Common/Frame.h>
+#include <TMIV/Common/LoggingStrategyFmt.h>
 
 #include <TLibCommon/TComList.h>
 #include <TLibCommon/TComPicYuv.h>
@@ -43,6 +46,7 @@
 #include <TLibDecoder/TDecTop.h>
 
 #include <array>
+#include <chrono>
 
 namespace TMIV::VideoDecoder {
 namespace {
@@ -229,6 +233,7 @@ private:
     auto *comPicYuv = m_pcPic->getPicYuvRec();
     PRECONDITION(comPicYuv != nullptr);
 
+    const auto startTime = std::chrono::steady_clock::now();
     auto outFrame = Common::Frame<>{};
     outFrame.setBitDepth(Common::at(m_outputBitDepth, toChannelType(COMPONENT_Y)));
     outFrame.getPlanes().resize(comPicYuv->getNumberValidComponents());
@@ -238,27 +243,21 @@ private:
         const auto planeBitDepth = Common::at(m_outputBitDepth, toChannelType(d));
         LIMITATION(planeBitDepth == outFrame.getBitDepth());
 
-        const auto *row = comPicYuv->getAddr(d);
-        const auto stride = comPicYuv->getStride(d);
         const auto width = comPicYuv->getWidth(d);
         const auto height = comPicYuv->getHeight(d);
 
         auto &outPlane = outFrame.getPlane(d);
         outPlane.resize({static_cast<size_t>(height), static_cast<size_t>(width)});
-
-        for (int32_t i = 0; i < height; ++i) {
-          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-          std::transform(row, row + width, outPlane.row_begin(i), [](const auto sample) {
-            return Common::assertDownCast<Common::DefaultElement>(sample);
-          });
-
-          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-          row += stride;
-        }
+        copyPlane(comPicYuv->getAddr(d), comPicYuv->getStride(d), planeBitDepth, outPlane);
       }
     }
 
-    push({outFrame, m_pcPic->getSlice(0)->isIRAP()});
+    Common::logDebug(
+        "[HM] Output picture with POC {} copied in {:.3f} ms", m_pcPic->getPOC(),
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+            .count());
+
+    push({std::move(outFrame), m_pcPic->getSlice(0)->isIRAP()});
   }
 
   int32_t m_poc{};
@@ -33,6 +33,8 @@
 
 #include <TMIV/VideoDecoder/VideoDecoder.h>
 
+#include "../CopyPlane.h"
+
 #include <TMIV/Common/Bytestream.h>
 #include <TMIV/Common/Decoder.h>
 #include <TMIV/Common/Frame.h>
@@ -41,6 +43,7 @@
 
 #include <vvdec/vvdec.h>
 
+#include <chrono>
 #include <list>
 #include <mutex>
 
@@ -212,6 +215,7 @@ private:
   void outputFrame() {
     LIMITATION(m_frame->frameFormat == VVDEC_FF_PROGRESSIVE);
 
+    const auto startTime = std::chrono::steady_clock::now();
     auto outFrame = Common::Frame<>{};
     outFrame.setBitDepth(m_frame->bitDepth);
     outFrame.getPlanes().resize(m_frame->numPlanes);
@@ -225,22 +229,23 @@ private:
       Common::withElement(m_frame->bitDepth, [&](auto zero) {
         using Element = decltype(zero);
 
-        for (uint32_t i = 0; i < inPlane.height; ++i) {
-          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-          const auto *rowU8 = inPlane.ptr + ptrdiff_t{inPlane.stride} * ptrdiff_t{i};
-
-          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-          const auto *row = reinterpret_cast<const Element *>(rowU8);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto *row = reinterpret_cast<const Element *>(inPlane.ptr);
+        const auto stride = ptrdiff_t{inPlane.stride} / ptrdiff_t{sizeof(Element)};
 
-          std::copy_n(row, inPlane.width, outPlane.row_begin(i));
-        }
+        copyPlane(row, stride, m_frame->bitDepth, outPlane);
       });
     }
 
+    Common::logDebug(
+        "[VVdeC] Output picture {} copied in {:.3f} ms", m_frame->sequenceNumber,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime)
+            .count());
+
     VERIFY(m_frame->picAttributes != nullptr);
     const auto irap = VVC_NAL_UNIT_CODED_SLICE_IDR_W_RADL <= m_frame->picAttributes->nalType &&
                       m_frame->picAttributes->nalType <= VVC_NAL_UNIT_RESERVED_IRAP_VCL_12;
-    return push({outFrame, irap});
+    return push({std::move(outFrame), irap});
   }
 
   void releaseFrame() {
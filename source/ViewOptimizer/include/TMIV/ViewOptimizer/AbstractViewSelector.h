@@ -46,8 +46,7 @@ public:
   AbstractViewSelector(const Common::Json &rootNode, const Common::Json &componentNode);
 
   auto optimizeParams(const SourceParams &params) -> ViewOptimizerParams override;
-  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList views) const
-      -> Common::DeepFrameList override;
+  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList views) -> Common::DeepFrameList override;
 
 protected:
   [[nodiscard]] virtual auto isBasicView() const -> std::vector<bool> = 0;
@@ -60,7 +60,7 @@ public:
   virtual auto optimizeParams(const SourceParams &params) -> ViewOptimizerParams = 0;
 
   // Optimize a frame in the intra period
-  [[nodiscard]] virtual auto optimizeFrame(Common::DeepFrameList views) const
+  [[nodiscard]] virtual auto optimizeFrame(Common::DeepFrameList views)
       -> Common::DeepFrameList = 0;
 };
 } // namespace TMIV::ViewOptimizer
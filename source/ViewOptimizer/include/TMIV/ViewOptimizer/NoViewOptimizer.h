@@ -53,8 +53,7 @@ public:
     return {m_params.viewParamsList};
   }
 
-  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList views) const
-      -> Common::DeepFrameList override {
+  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList views) -> Common::DeepFrameList override {
     return views;
   }
 
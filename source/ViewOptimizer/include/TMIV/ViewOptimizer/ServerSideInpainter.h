@@ -49,8 +49,7 @@ public:
   ~ServerSideInpainter() override;
 
   auto optimizeParams(const SourceParams &params) -> ViewOptimizerParams override;
-  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList frame) const
-      -> Common::DeepFrameList override;
+  [[nodiscard]] auto optimizeFrame(Common::DeepFrameList frame) -> Common::DeepFrameList override;
 
 private:
   class Impl;
@@ -56,8 +56,7 @@ auto AbstractViewSelector::optimizeParams(const SourceParams &params) -> ViewOpt
   return m_params;
 }
 
-auto AbstractViewSelector::optimizeFrame(Common::DeepFrameList views) const
-    -> Common::DeepFrameList {
+auto AbstractViewSelector::optimizeFrame(Common::DeepFrameList views) -> Common::DeepFrameList {
   inplaceEraseAdditionalViews(views);
   return views;
 }
@@ -226,7 +226,7 @@ public:
     return m_transportParams;
   }
 
-  [[nodiscard]] auto optimizeFrame(DeepFrameList frame) const -> DeepFrameList {
+  [[nodiscard]] auto optimizeFrame(DeepFrameList frame) -> DeepFrameList {
     PRECONDITION(!m_transportParams.viewParamsList.empty());
 
     auto viewportParams = MivBitstream::CameraConfig{};
@@ -436,7 +436,7 @@ auto ServerSideInpainter::optimizeParams(const SourceParams &params) -> ViewOpti
   return m_impl->optimizeParams(params);
 }
 
-auto ServerSideInpainter::optimizeFrame(DeepFrameList frame) const -> DeepFrameList {
+auto ServerSideInpainter::optimizeFrame(DeepFrameList frame) -> DeepFrameList {
   return m_impl->optimizeFrame(std::move(frame));
 }
 
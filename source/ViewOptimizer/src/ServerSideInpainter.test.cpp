@@ -63,7 +63,7 @@ public:
     return m_params;
   }
 
-  [[nodiscard]] auto optimizeFrame(TMIV::Common::DeepFrameList views) const
+  [[nodiscard]] auto optimizeFrame(TMIV::Common::DeepFrameList views)
       -> TMIV::Common::DeepFrameList override {
     return views;
   }
@@ -87,7 +87,7 @@ public:
       inspect_renderFrame_input; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
   [[nodiscard]] auto renderFrame(const TMIV::MivBitstream::AccessUnit &frame,
-                                 const TMIV::MivBitstream::CameraConfig &viewportParams) const
+                                 const TMIV::MivBitstream::CameraConfig &viewportParams)
       -> TMIV::Common::RendererFrame override {
     if (inspect_renderFrame_input) {
       inspect_renderFrame_input(frame, viewportParams);
@@ -120,7 +120,7 @@ public:
   static inline bool called = false;
 
   void inplaceInpaint(TMIV::Common::RendererFrame & /* viewport */,
-                      const TMIV::MivBitstream::ViewParams & /* metadata */) const override {
+                      const TMIV::MivBitstream::ViewParams & /* metadata */) override {
     called = true;
   }
 };